@@ -0,0 +1,50 @@
+/**
+ * @file boot_monitor.h
+ * @brief Boot phase timing header file for STM32F407 HID to Serial/CAN project
+ * @author Manus AI
+ * @date 2025-03-28
+ */
+
+#ifndef __BOOT_MONITOR_H
+#define __BOOT_MONITOR_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  
+/* Includes ------------------------------------------------------------------*/
+#include "stm32f4xx_hal.h"
+  
+/* Exported types ------------------------------------------------------------*/
+typedef enum {
+  BOOT_PHASE_MAIN = 0,        /* main() entered */
+  BOOT_PHASE_CLOCK,           /* System clock running from the PLL */
+  BOOT_PHASE_CONFIG,          /* Config store scanned */
+  BOOT_PHASE_CAN_READY,       /* CAN output accepting frames */
+  BOOT_PHASE_LOOP,            /* Main loop entered */
+  BOOT_PHASE_USB_DEVICE,      /* First HID device active */
+  BOOT_PHASE_DISPLAY_READY,   /* Display controller out of sleep */
+  BOOT_PHASE_FIRST_FRAME,     /* First display items drawn */
+  BOOT_PHASE_NETWORK_READY,   /* HTTP server listening */
+  BOOT_PHASE_COUNT
+} Boot_Phase_t;
+  
+/* Exported constants --------------------------------------------------------*/
+#define BOOT_MONITOR_CAN_ID       0x6F1       /* Report frame: phase, time in us (LE) */
+#define BOOT_MONITOR_TIME_NONE    0xFFFFFFFF
+  
+/* Exported macro ------------------------------------------------------------*/
+/* Exported functions prototypes ---------------------------------------------*/
+void Boot_Monitor_Init(void);
+void Boot_Monitor_Process(void);
+void Boot_Monitor_Mark(Boot_Phase_t phase);
+uint32_t Boot_Monitor_GetTime(Boot_Phase_t phase);
+uint32_t Boot_Monitor_GetLoopTime(void);
+uint32_t Boot_Monitor_TakeLoopPeak(void);
+uint32_t Boot_Monitor_GetMicros(void);
+  
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __BOOT_MONITOR_H */
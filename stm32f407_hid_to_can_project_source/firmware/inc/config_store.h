@@ -0,0 +1,72 @@
+/**
+ * @file config_store.h
+ * @brief Flash configuration store header file for STM32F407 HID to Serial/CAN project
+ * @author Manus AI
+ * @date 2025-03-28
+ */
+
+#ifndef __CONFIG_STORE_H
+#define __CONFIG_STORE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32f4xx_hal.h"
+
+/* Exported constants --------------------------------------------------------*/
+/* Two 128 KB sectors at the top of flash, excluded from FLASH in the linker script */
+#define CONFIG_STORE_SECTOR_A_ADDR    0x080C0000
+#define CONFIG_STORE_SECTOR_B_ADDR    0x080E0000
+#define CONFIG_STORE_SECTOR_A         FLASH_SECTOR_10
+#define CONFIG_STORE_SECTOR_B         FLASH_SECTOR_11
+#define CONFIG_STORE_SECTOR_SIZE      0x20000
+#define CONFIG_STORE_MAX_KEYS         384
+#define CONFIG_STORE_MAX_RECORD       512   /* Largest payload in bytes */
+#define CONFIG_STORE_RECORD_HEADER    12    /* Key, length, sequence and CRC */
+#define CONFIG_STORE_ERASE_MAX_MS     10000 /* Longest the spare sector erase is put off */
+
+/* Record keys, the high byte selects the owning module */
+#define CONFIG_KEY_OUTPUT_SERIAL      0x0100
+#define CONFIG_KEY_OUTPUT_CAN         0x0101
+#define CONFIG_KEY_WEB_SERVER         0x0200
+#define CONFIG_KEY_TS                 0x0300
+#define CONFIG_KEY_TS_PAGE(page)      (0x0310 + (page))
+#define CONFIG_KEY_TS_CHUNK(page, chunk) \
+  (0x0320 + ((page) << 5) + (chunk))
+#define CONFIG_KEY_DISPLAY_ITEM(item) (0x0400 + (item))
+#define CONFIG_KEY_MAPPING_PROFILE(profile) \
+  (0x1000 + ((profile) << 8) + 0xFF)
+#define CONFIG_KEY_MAPPING_ENTRY(profile, entry) \
+  (0x1000 + ((profile) << 8) + (entry))
+
+/* Exported types ------------------------------------------------------------*/
+typedef struct {
+  uint32_t generation;    /* Incremented by every compaction */
+  uint32_t usedBytes;     /* Bytes of log written in the active sector */
+  uint32_t freeBytes;     /* Bytes left for records before a write compacts */
+  uint32_t liveBytes;     /* Bytes of those still holding current values */
+  uint16_t keyCount;      /* Keys with a current value */
+  uint8_t erasePending;   /* Spare sector still has to be erased */
+} Config_Store_Stats_t;
+
+/* Exported macro ------------------------------------------------------------*/
+/* Log space a record takes, the payload is padded to a whole word */
+#define CONFIG_STORE_RECORD_SIZE(length) \
+  (CONFIG_STORE_RECORD_HEADER + (((length) + 3U) & ~3U))
+
+/* Exported functions prototypes ---------------------------------------------*/
+void Config_Store_Init(void);
+void Config_Store_Process(uint8_t mayErase);
+uint8_t Config_Store_Read(uint16_t key, void* data, uint16_t length);
+uint8_t Config_Store_Write(uint16_t key, const void* data, uint16_t length);
+uint8_t Config_Store_Delete(uint16_t key);
+uint8_t Config_Store_Compact(void);
+void Config_Store_GetStats(Config_Store_Stats_t* stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __CONFIG_STORE_H */
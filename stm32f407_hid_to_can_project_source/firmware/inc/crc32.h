@@ -0,0 +1,31 @@
+/**
+ * @file crc32.h
+ * @brief CRC-32 header file for STM32F407 HID to Serial/CAN project
+ * @author Manus AI
+ * @date 2025-03-28
+ */
+
+#ifndef __CRC32_H
+#define __CRC32_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/* Exported constants --------------------------------------------------------*/
+#define CRC32_INITIAL             0x00000000UL
+
+/* Exported types ------------------------------------------------------------*/
+/* Exported macro ------------------------------------------------------------*/
+/* Exported functions prototypes ---------------------------------------------*/
+uint32_t CRC32_Update(uint32_t crc, const void* data, uint32_t length);
+uint32_t CRC32_Calculate(const void* data, uint32_t length);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __CRC32_H */
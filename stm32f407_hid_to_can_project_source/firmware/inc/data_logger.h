@@ -0,0 +1,67 @@
+/**
+ * @file data_logger.h
+ * @brief Event data logger header file for STM32F407 HID to Serial/CAN project
+ * @author Manus AI
+ * @date 2025-03-28
+ */
+
+#ifndef __DATA_LOGGER_H
+#define __DATA_LOGGER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32f4xx_hal.h"
+
+/* Exported types ------------------------------------------------------------*/
+typedef enum {
+  DATA_LOGGER_SOURCE_INPUT = 0,   /* HID input event as it is queued */
+  DATA_LOGGER_SOURCE_OUTPUT,      /* Value sent by a mapping */
+  DATA_LOGGER_SOURCE_CAN_RX,      /* CAN frame as it is received */
+  DATA_LOGGER_SOURCE_COUNT
+} Data_Logger_Source_t;
+
+typedef struct {
+  uint8_t sourceMask;       /* Bit per Data_Logger_Source_t */
+  uint32_t canIdFirst;      /* CAN IDs logged, inclusive range */
+  uint32_t canIdLast;
+} Data_Logger_Config_t;
+
+typedef struct {
+  uint32_t records;         /* Records captured since the start */
+  uint32_t overruns;        /* Records lost to a full ring since the start */
+  uint16_t pending;         /* Records waiting to be read */
+  uint8_t running;
+} Data_Logger_Stats_t;
+
+/* Exported constants --------------------------------------------------------*/
+#ifndef DATA_LOGGER_RING_SIZE
+#define DATA_LOGGER_RING_SIZE     1024  /* Records, power of two; a second at 1 kHz */
+#endif
+#define DATA_LOGGER_BLOCK_HEADER  12    /* Record count, first timestamp, overruns, pending */
+#define DATA_LOGGER_RECORD_MAX    19    /* Longest encoded record, a CAN frame with 8 bytes */
+
+/* Exported macro ------------------------------------------------------------*/
+#define DATA_LOGGER_SOURCE_BIT(source)  (1U << (source))
+
+/* Record identifiers keep the type in the low 3 bits, so common IDs encode in one or two bytes */
+#define DATA_LOGGER_INPUT_ID(eventType, deviceIndex, inputId) \
+  (((((uint32_t)(deviceIndex) << 8) | (inputId)) << 3) | (eventType))
+#define DATA_LOGGER_OUTPUT_ID(outputType, target) \
+  (((uint32_t)(target) << 3) | (outputType))
+
+/* Exported functions prototypes ---------------------------------------------*/
+void Data_Logger_Init(void);
+void Data_Logger_Start(const Data_Logger_Config_t* config);
+void Data_Logger_Stop(void);
+void Data_Logger_Record(Data_Logger_Source_t source, uint32_t id, const uint8_t* data, uint8_t length);
+uint16_t Data_Logger_ReadBlock(uint8_t* buffer, uint16_t size);
+void Data_Logger_GetStats(Data_Logger_Stats_t* stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __DATA_LOGGER_H */
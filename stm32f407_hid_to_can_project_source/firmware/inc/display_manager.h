@@ -21,7 +21,10 @@ typedef enum {
   DISPLAY_ITEM_TEXT,
   DISPLAY_ITEM_VALUE,
   DISPLAY_ITEM_BAR,
-  DISPLAY_ITEM_ICON
+  DISPLAY_ITEM_ICON,
+  DISPLAY_ITEM_ARC,       /* Arc gauge, filled over a track */
+  DISPLAY_ITEM_NEEDLE,    /* Needle over a thin dial arc */
+  DISPLAY_ITEM_RING       /* Full circle ring bar */
 } Display_Item_Type_t;
 
 typedef enum {
@@ -46,7 +49,8 @@ typedef struct {
     struct {
       uint32_t canId;
       uint8_t dataIndex;
-      uint8_t dataLength;
+      uint8_t dataLength;   /* 1 to 4 bytes */
+      uint8_t flags;        /* DISPLAY_CAN_LSB_FIRST, DISPLAY_CAN_SIGNED */
     } can;
     struct {
       uint8_t paramId;
@@ -54,22 +58,49 @@ typedef struct {
   } source;
   uint16_t color;
   uint16_t backgroundColor;
+  struct {
+    int16_t startAngle;   /* Degrees clockwise from 12 o'clock */
+    int16_t sweepAngle;   /* Degrees from 0 to maxValue, ring bars always use 360 */
+    uint16_t maxValue;    /* Value at the end of the sweep, 0 for 100 */
+    uint8_t thickness;    /* Ring or needle width in pixels, 0 for a default */
+  } gauge;
   char label[16];
-  uint8_t refreshRate;
+  uint16_t refreshRate;   /* Time between value checks in ms */
+  uint16_t hysteresis;    /* Redraw only when the value moves further than this */
 } Display_Item_t;
 
+typedef enum {
+  DISPLAY_BENCHMARK_FULL_SCREEN = 0,  /* Every frame redraws the whole panel */
+  DISPLAY_BENCHMARK_GAUGE             /* Every frame redraws a centered gauge area */
+} Display_Benchmark_Mode_t;
+
+typedef struct {
+  uint16_t frames;
+  uint32_t elapsedUs;
+  uint32_t bytesSent;     /* Commands and pixels written to the SPI */
+  uint16_t fpsX10;        /* Frames per second, times 10 */
+  uint16_t busPermille;   /* Share of the elapsed time the SPI was shifting bits */
+} Display_Benchmark_Result_t;
+
 /* Exported constants --------------------------------------------------------*/
 #define MAX_DISPLAY_ITEMS         16
 #define DISPLAY_WIDTH             240
 #define DISPLAY_HEIGHT            240
+#define DISPLAY_BENCHMARK_GAUGE_SIZE  96
+#define DISPLAY_CAN_LSB_FIRST     0x01    /* CAN values are MSB first unless set */
+#define DISPLAY_CAN_SIGNED        0x02    /* Sign-extend CAN values */
+#define DISPLAY_BENCHMARK_CAN_ID  0x6F2   /* Result frame: mode, fps x10, bus permille, frames (LE) */
 
 /* Exported macro ------------------------------------------------------------*/
 /* Exported functions prototypes ---------------------------------------------*/
 void Display_Manager_Init(void);
 void Display_Manager_Process(void);
+uint8_t Display_Manager_IsReady(void);
+uint8_t Display_Manager_RunBenchmark(Display_Benchmark_Mode_t mode, uint16_t frames, Display_Benchmark_Result_t* result);
 uint8_t Display_Manager_AddItem(Display_Item_t* item);
 uint8_t Display_Manager_RemoveItem(uint8_t itemIndex);
 Display_Item_t* Display_Manager_GetItem(uint8_t itemIndex);
+uint8_t Display_Manager_InvalidateItem(uint8_t itemIndex);
 uint8_t Display_Manager_GetItemCount(void);
 uint8_t Display_Manager_SaveConfig(void);
 uint8_t Display_Manager_LoadConfig(void);
@@ -79,6 +110,8 @@ void Display_Manager_DrawText(uint8_t x, uint8_t y, const char* text, uint16_t c
 void Display_Manager_DrawValue(uint8_t x, uint8_t y, int32_t value, uint16_t color);
 void Display_Manager_DrawBar(uint8_t x, uint8_t y, uint8_t width, uint8_t height, uint8_t value, uint16_t color);
 void Display_Manager_DrawIcon(uint8_t x, uint8_t y, uint8_t iconId, uint16_t color);
+void Display_Manager_DrawArc(uint8_t x, uint8_t y, uint8_t radius, uint8_t thickness, int16_t startAngle, int16_t sweepAngle, uint16_t color);
+void Display_Manager_DrawNeedle(uint8_t x, uint8_t y, uint8_t length, uint8_t width, int16_t angle, uint16_t color);
 
 #ifdef __cplusplus
 }
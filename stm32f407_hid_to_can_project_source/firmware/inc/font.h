@@ -0,0 +1,51 @@
+/**
+ * @file font.h
+ * @brief Font atlas header file for STM32F407 HID to Serial/CAN project
+ * @author Manus AI
+ * @date 2025-03-28
+ */
+
+#ifndef __FONT_H
+#define __FONT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/* Exported types ------------------------------------------------------------*/
+/* Glyph cropped to its ink box. The pixels are run-length encoded in the
+   font data from offset on, row by row, one byte per run. */
+typedef struct {
+  uint16_t offset;        /* First run byte in the font data */
+  uint8_t width;          /* Ink box width, 0 for blank glyphs */
+  uint8_t height;         /* Ink box height */
+  int8_t xOffset;         /* Ink box left edge relative to the pen position */
+  uint8_t yOffset;        /* Ink box top edge relative to the top of the line */
+  uint8_t advance;        /* Pen movement to the next glyph */
+} Font_Glyph_t;
+
+typedef struct {
+  uint8_t height;         /* Line height in pixels */
+  uint8_t firstChar;      /* Character of glyphs[0] */
+  uint8_t glyphCount;
+  const Font_Glyph_t* glyphs;
+  const uint8_t* data;
+} Font_t;
+
+/* Exported constants --------------------------------------------------------*/
+/* Run byte: coverage level in bits 7-6, run length minus one in bits 5-0 */
+#define FONT_RUN_LEVEL(run)       ((run) >> 6)
+#define FONT_RUN_LENGTH(run)      (((run) & 0x3F) + 1)
+#define FONT_LEVEL_MAX            3
+
+/* Exported variables --------------------------------------------------------*/
+extern const Font_t fontDefault;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __FONT_H */
@@ -35,7 +35,9 @@ typedef struct {
 } Input_Event_t;
 
 /* Exported constants --------------------------------------------------------*/
-#define MAX_INPUT_QUEUE_SIZE       32
+#ifndef MAX_INPUT_QUEUE_SIZE
+#define MAX_INPUT_QUEUE_SIZE       32   /* Up to 255, see INPUT_QUEUE_SIZE in Makefile */
+#endif
 #define MAX_INPUT_MAPPINGS         64
 
 /* Exported macro ------------------------------------------------------------*/
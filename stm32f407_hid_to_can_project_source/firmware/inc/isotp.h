@@ -0,0 +1,69 @@
+/**
+ * @file isotp.h
+ * @brief ISO 15765-2 CAN transport header file for STM32F407 HID to Serial/CAN project
+ * @author Manus AI
+ * @date 2025-03-28
+ */
+
+#ifndef __ISOTP_H
+#define __ISOTP_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32f4xx_hal.h"
+
+/* Exported constants --------------------------------------------------------*/
+#define ISOTP_MAX_MESSAGE         4095  /* 12-bit first frame length */
+#define ISOTP_TIMEOUT_MS          1000  /* N_As, N_Bs and N_Cr */
+#define ISOTP_PADDING             0xCC  /* Frames are always sent with 8 bytes */
+#define ISOTP_TX_BURST            3     /* Consecutive frames queued per pass, one per mailbox */
+
+/* Exported types ------------------------------------------------------------*/
+typedef enum {
+  ISOTP_STATE_IDLE = 0,
+  ISOTP_STATE_RECEIVING,    /* Between first and last consecutive frame */
+  ISOTP_STATE_RECEIVED,     /* Message complete, waiting for IsoTp_Take */
+  ISOTP_STATE_SENDING,      /* Consecutive frames to go */
+  ISOTP_STATE_WAIT_FC       /* Waiting for the receiver's flow control */
+} IsoTp_State_t;
+
+/* One point-to-point link, owned by the caller. Receive and transmit share
+   the state since the link is half duplex, request then response. */
+typedef struct {
+  uint32_t rxId;            /* Frames accepted from the peer */
+  uint32_t txId;            /* Frames sent to the peer */
+  uint8_t blockSize;        /* Consecutive frames between our flow controls, 0 for none */
+  uint8_t stMin;            /* Separation time we ask for, STmin encoding */
+  uint8_t* buffer;          /* Receive buffer, then the message being sent */
+  uint16_t bufferSize;
+  IsoTp_State_t state;
+  uint16_t length;          /* Message length */
+  uint16_t offset;          /* Bytes received or sent so far */
+  uint8_t sequence;         /* Next consecutive frame sequence number */
+  uint8_t blockCount;       /* Consecutive frames left in the block, 0 for unlimited */
+  uint32_t separation;      /* Peer's separation time in us */
+  uint32_t lastMicros;      /* Last consecutive frame sent */
+  uint32_t tick;            /* Start of the current timeout */
+  uint32_t rxMessages;
+  uint32_t txMessages;
+  uint32_t errors;          /* Timeouts, sequence errors and overflows */
+} IsoTp_Link_t;
+
+/* Exported macro ------------------------------------------------------------*/
+/* Exported functions prototypes ---------------------------------------------*/
+void IsoTp_Init(IsoTp_Link_t* link, uint32_t rxId, uint32_t txId, uint8_t* buffer, uint16_t bufferSize);
+void IsoTp_SetFlowControl(IsoTp_Link_t* link, uint8_t blockSize, uint8_t stMin);
+void IsoTp_Receive(IsoTp_Link_t* link, const uint8_t* data, uint8_t length);
+void IsoTp_Process(IsoTp_Link_t* link);
+uint16_t IsoTp_Take(IsoTp_Link_t* link);
+uint8_t IsoTp_Send(IsoTp_Link_t* link, uint16_t length);
+uint8_t IsoTp_IsIdle(const IsoTp_Link_t* link);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __ISOTP_H */
@@ -0,0 +1,83 @@
+/**
+ * @file mapping_combo.h
+ * @brief Chord, tap/hold, double-tap and macro handling for the Mapping Engine of STM32F407 HID to Serial/CAN project
+ * @author Manus AI
+ * @date 2025-03-28
+ */
+
+#ifndef __MAPPING_COMBO_H
+#define __MAPPING_COMBO_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32f4xx_hal.h"
+#include "input_manager.h"
+#include "mapping_engine.h"
+#include "timer_wheel.h"
+
+/* Exported constants --------------------------------------------------------*/
+#define MAPPING_COMBO_MAX_COMBOS    16
+#define MAPPING_COMBO_MAX_KEYS      4
+#define MAPPING_MACRO_MAX_MACROS    8
+#define MAPPING_MACRO_MAX_STEPS     16
+#define MAPPING_MACRO_MAX_PLAYERS   4   /* Macros that can run at the same time */
+
+/* Exported types ------------------------------------------------------------*/
+typedef enum {
+  COMBO_TYPE_NONE = 0,
+  COMBO_TYPE_CHORD,       /* All keys held -> actions[0] */
+  COMBO_TYPE_TAP_HOLD,    /* keys[0] released before timeoutMs -> actions[0], held -> actions[1] */
+  COMBO_TYPE_DOUBLE_TAP   /* keys[0] once -> actions[0], twice within timeoutMs -> actions[1] */
+} Mapping_Combo_Type_t;
+
+typedef struct {
+  uint8_t deviceIndex;
+  Input_Event_Type_t eventType;  /* INPUT_EVENT_KEY_PRESS or INPUT_EVENT_BUTTON_PRESS */
+  uint8_t inputId;
+} Mapping_Combo_Key_t;
+
+/* A fixed value sent to an output. OUTPUT_TYPE_NONE means no action. */
+typedef struct {
+  Output_Type_t outputType;
+  Mapping_Output_Config_t output;
+  int16_t value;
+} Mapping_Combo_Action_t;
+
+typedef struct {
+  uint8_t enabled;
+  Mapping_Combo_Type_t type;
+  uint8_t keyCount;
+  Mapping_Combo_Key_t keys[MAPPING_COMBO_MAX_KEYS];
+  uint16_t timeoutMs;    /* Chord window (0 = none), hold time or double-tap window */
+  Mapping_Combo_Action_t actions[2];
+} Mapping_Combo_t;
+
+typedef struct {
+  Mapping_Combo_Action_t action;
+  uint16_t delayMs;      /* Delay before the next step */
+} Mapping_Macro_Step_t;
+
+typedef struct {
+  uint8_t stepCount;
+  Mapping_Macro_Step_t steps[MAPPING_MACRO_MAX_STEPS];
+} Mapping_Macro_t;
+
+/* Exported macro ------------------------------------------------------------*/
+/* Exported functions prototypes ---------------------------------------------*/
+void Mapping_Combo_Init(void);
+void Mapping_Combo_ProcessEvent(Input_Event_t* inputEvent);
+uint8_t Mapping_Combo_Add(const Mapping_Combo_t* combo);
+uint8_t Mapping_Combo_Remove(uint8_t comboIndex);
+Mapping_Combo_t* Mapping_Combo_Get(uint8_t comboIndex);
+uint8_t Mapping_Combo_SetMacro(uint8_t macroIndex, const Mapping_Macro_t* macro);
+uint8_t Mapping_Combo_StartMacro(uint8_t macroIndex);
+void Mapping_Combo_StopMacros(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __MAPPING_COMBO_H */
@@ -16,13 +16,42 @@ extern "C" {
 #include "stm32f4xx_hal.h"
 #include "input_manager.h"
 
+/* Exported constants --------------------------------------------------------*/
+#define MAX_MAPPINGS              64
+#define MAPPING_CONFIG_VERSION    1
+#define MAX_MAPPING_PROFILES      4
+#define MAPPING_PROFILE_NAME_SIZE 16
+#define MAPPING_PROFILE_CAN_ID    0x6F0  /* data[0] = profile index to activate */
+#define MAPPING_PROFILE_NONE      0xFF
+#define MAPPING_STATS_BUCKETS     16     /* Bucket n counts events of 2^(n-1) to 2^n - 1 cycles */
+
 /* Exported types ------------------------------------------------------------*/
 typedef enum {
   OUTPUT_TYPE_NONE = 0,
   OUTPUT_TYPE_SERIAL,
-  OUTPUT_TYPE_CAN
+  OUTPUT_TYPE_CAN,
+  OUTPUT_TYPE_PROFILE,
+  OUTPUT_TYPE_MACRO
 } Output_Type_t;
 
+typedef union {
+  struct {
+    uint8_t dataFormat;
+    uint8_t dataLength;
+  } serial;
+  struct {
+    uint32_t canId;
+    uint8_t dlc;
+    uint8_t dataIndex;
+  } can;
+  struct {
+    uint8_t profileIndex;
+  } profile;
+  struct {
+    uint8_t macroIndex;
+  } macro;
+} Mapping_Output_Config_t;
+
 typedef struct {
   uint8_t enabled;
   uint8_t deviceIndex;
@@ -31,34 +60,62 @@ typedef struct {
   int16_t minValue;
   int16_t maxValue;
   Output_Type_t outputType;
-  union {
-    struct {
-      uint8_t dataFormat;
-      uint8_t dataLength;
-    } serial;
-    struct {
-      uint32_t canId;
-      uint8_t dlc;
-      uint8_t dataIndex;
-    } can;
-  } output;
+  Mapping_Output_Config_t output;
 } Input_Mapping_t;
 
-/* Exported constants --------------------------------------------------------*/
-#define MAX_MAPPINGS              64
-#define MAPPING_CONFIG_VERSION    1
+/* A prebuilt mapping table in structure-of-arrays form. keys[] is the only
+   array touched while searching and holds the packed MAPPING_KEY of each
+   entry in ascending order; the payload arrays are indexed the same way. */
+typedef struct {
+  char name[MAPPING_PROFILE_NAME_SIZE];
+  uint8_t count;
+  uint32_t keys[MAX_MAPPINGS];
+  int16_t minValues[MAX_MAPPINGS];
+  int16_t maxValues[MAX_MAPPINGS];
+  uint8_t outputTypes[MAX_MAPPINGS];
+  Mapping_Output_Config_t outputs[MAX_MAPPINGS];
+} Mapping_Profile_t;
+
+typedef struct {
+  uint32_t events;          /* Events dispatched */
+  uint32_t totalCycles;     /* CPU cycles spent on key lookups, output sends excluded */
+  uint32_t maxCycles;       /* Worst single lookup */
+  uint16_t bytesPerMapping; /* Profile storage per mapping entry */
+  uint32_t histogram[MAPPING_STATS_BUCKETS];  /* Events by lookup cycles, log2 buckets */
+} Mapping_Engine_Stats_t;
+
+#ifdef MAPPING_STATIC_TABLE
+/* Prebuilt profiles linked into flash, generated by tools/gen_mapping_table.py */
+extern const Mapping_Profile_t mappingTableProfiles[MAX_MAPPING_PROFILES];
+#endif
 
 /* Exported macro ------------------------------------------------------------*/
+#define MAPPING_KEY(deviceIndex, eventType, inputId) \
+  (((uint32_t)(deviceIndex) << 16) | ((uint32_t)(eventType) << 8) | (uint32_t)(inputId))
+#define MAPPING_KEY_DEVICE(key)   ((uint8_t)((key) >> 16))
+#define MAPPING_KEY_EVENT(key)    ((Input_Event_Type_t)(((key) >> 8) & 0xFF))
+#define MAPPING_KEY_INPUT(key)    ((uint8_t)((key) & 0xFF))
+
 /* Exported functions prototypes ---------------------------------------------*/
 void Mapping_Engine_Init(void);
 void Mapping_Engine_Process(void);
 uint8_t Mapping_Engine_AddMapping(Input_Mapping_t* mapping);
 uint8_t Mapping_Engine_RemoveMapping(uint8_t mappingIndex);
-Input_Mapping_t* Mapping_Engine_GetMapping(uint8_t mappingIndex);
+uint8_t Mapping_Engine_GetMapping(uint8_t mappingIndex, Input_Mapping_t* mapping);
 uint8_t Mapping_Engine_GetMappingCount(void);
 uint8_t Mapping_Engine_SaveConfig(void);
 uint8_t Mapping_Engine_LoadConfig(void);
 void Mapping_Engine_ResetConfig(void);
+uint8_t Mapping_Engine_EditProfile(uint8_t profileIndex, uint8_t copyExisting);
+uint8_t Mapping_Engine_SetProfileName(const char* name);
+uint8_t Mapping_Engine_CommitProfile(void);
+void Mapping_Engine_SelectProfile(uint8_t profileIndex);
+uint8_t Mapping_Engine_GetActiveProfile(void);
+const char* Mapping_Engine_GetProfileName(uint8_t profileIndex);
+void Mapping_Engine_GetStats(Mapping_Engine_Stats_t* stats);
+void Mapping_Engine_ResetStats(void);
+uint32_t Mapping_Engine_GetLatencyPercentile(uint8_t percent);
+uint8_t Mapping_Engine_SendOutput(Output_Type_t outputType, const Mapping_Output_Config_t* output, int16_t value);
 
 #ifdef __cplusplus
 }
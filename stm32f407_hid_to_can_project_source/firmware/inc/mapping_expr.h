@@ -0,0 +1,79 @@
+/**
+ * @file mapping_expr.h
+ * @brief Derived signal expressions for the Mapping Engine of STM32F407 HID to Serial/CAN project
+ * @author Manus AI
+ * @date 2025-03-28
+ */
+
+#ifndef __MAPPING_EXPR_H
+#define __MAPPING_EXPR_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32f4xx_hal.h"
+#include "input_manager.h"
+#include "mapping_engine.h"
+
+/* Exported constants --------------------------------------------------------*/
+#define MAPPING_EXPR_MAX_SIGNALS  32  /* One bit per signal in inputMask */
+#define MAPPING_EXPR_MAX_EXPRS    16
+#define MAPPING_EXPR_MAX_CODE     24
+#define MAPPING_EXPR_STACK_DEPTH  8
+
+/* Exported types ------------------------------------------------------------*/
+/* Expression opcodes. Operands follow the opcode byte in the code stream. */
+typedef enum {
+  EXPR_OP_END = 0,      /* Stop, result is top of stack */
+  EXPR_OP_PUSH_SIGNAL,  /* [slot] push current value of an input signal */
+  EXPR_OP_PUSH_CONST8,  /* [int8] push a signed 8-bit constant */
+  EXPR_OP_PUSH_CONST16, /* [lo, hi] push a signed 16-bit constant */
+  EXPR_OP_ADD,
+  EXPR_OP_SUB,
+  EXPR_OP_MUL,
+  EXPR_OP_DIV,          /* Division by zero yields 0 */
+  EXPR_OP_SHR,          /* [n] arithmetic shift right by n */
+  EXPR_OP_NEG,
+  EXPR_OP_ABS,
+  EXPR_OP_MIN,
+  EXPR_OP_MAX,
+  EXPR_OP_AND,          /* Logical and, result 0 or 1 */
+  EXPR_OP_OR,           /* Logical or, result 0 or 1 */
+  EXPR_OP_NOT,          /* Logical not, result 0 or 1 */
+  EXPR_OP_GT,
+  EXPR_OP_LT,
+  EXPR_OP_EQ,
+  EXPR_OP_SELECT,       /* cond, a, b -> cond ? a : b */
+  EXPR_OP_COUNT
+} Mapping_Expr_Op_t;
+
+typedef struct {
+  uint8_t enabled;
+  uint8_t codeLength;
+  uint8_t code[MAPPING_EXPR_MAX_CODE];
+  Output_Type_t outputType;
+  Mapping_Output_Config_t output;
+  uint32_t inputMask;   /* Filled in by Mapping_Expr_Add */
+  int16_t lastValue;    /* Last value sent to the output */
+  uint8_t hasValue;     /* Set once lastValue is valid */
+} Mapping_Expr_t;
+
+/* Exported macro ------------------------------------------------------------*/
+/* Exported functions prototypes ---------------------------------------------*/
+void Mapping_Expr_Init(void);
+void Mapping_Expr_Process(void);
+uint8_t Mapping_Expr_RegisterSignal(uint8_t deviceIndex, Input_Event_Type_t eventType, uint8_t inputId);
+int16_t Mapping_Expr_GetSignal(uint8_t signalIndex);
+void Mapping_Expr_UpdateSignal(Input_Event_t* inputEvent);
+uint8_t Mapping_Expr_Add(Mapping_Expr_t* expr);
+uint8_t Mapping_Expr_Remove(uint8_t exprIndex);
+Mapping_Expr_t* Mapping_Expr_Get(uint8_t exprIndex);
+int16_t Mapping_Expr_Evaluate(const Mapping_Expr_t* expr);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __MAPPING_EXPR_H */
@@ -42,9 +42,23 @@ typedef struct {
   uint8_t bs2;
 } CAN_Config_t;
 
+typedef struct {
+  uint32_t serialTxBytes;   /* Bytes written to the UART */
+  uint32_t canTxFrames;     /* Frames handed to a mailbox */
+  uint32_t canRxFrames;     /* Frames taken from FIFO 0 */
+  uint32_t canRxDropped;    /* Frames lost to a full receive queue */
+  uint16_t serialTxQueued;
+  uint8_t canTxQueued;
+  uint8_t canRxQueued;
+} Output_Manager_Stats_t;
+
+typedef void (*CAN_Rx_Callback_t)(uint32_t canId, uint8_t* data, uint8_t length);
+
 /* Exported constants --------------------------------------------------------*/
 #define MAX_SERIAL_BUFFER_SIZE    256
 #define MAX_CAN_BUFFER_SIZE       64
+#define MAX_CAN_RX_CALLBACKS      4
+#define MAX_CAN_RX_QUEUE_SIZE     32    /* Power of two */
 
 /* Exported macro ------------------------------------------------------------*/
 /* Exported functions prototypes ---------------------------------------------*/
@@ -52,10 +66,12 @@ void Output_Manager_Init(void);
 void Output_Manager_Process(void);
 uint8_t Output_Manager_SendSerial(uint8_t* data, uint8_t length);
 uint8_t Output_Manager_SendCAN(uint32_t canId, uint8_t* data, uint8_t length);
+uint8_t Output_Manager_RegisterCANRxCallback(CAN_Rx_Callback_t callback);
 uint8_t Output_Manager_ConfigureSerial(Serial_Config_t* config);
 uint8_t Output_Manager_ConfigureCAN(CAN_Config_t* config);
 Serial_Config_t* Output_Manager_GetSerialConfig(void);
 CAN_Config_t* Output_Manager_GetCANConfig(void);
+void Output_Manager_GetStats(Output_Manager_Stats_t* stats);
 uint8_t Output_Manager_SaveConfig(void);
 uint8_t Output_Manager_LoadConfig(void);
 void Output_Manager_ResetConfig(void);
@@ -0,0 +1,46 @@
+/**
+ * @file rx_cache.h
+ * @brief Received value cache header file for STM32F407 HID to Serial/CAN project
+ * @author Manus AI
+ * @date 2025-03-28
+ */
+
+#ifndef __RX_CACHE_H
+#define __RX_CACHE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32f4xx_hal.h"
+
+/* Exported constants --------------------------------------------------------*/
+#define RX_CACHE_CAN_SLOT_BITS    6
+#define RX_CACHE_CAN_SLOTS        (1 << RX_CACHE_CAN_SLOT_BITS)
+#define RX_CACHE_CAN_MAX_IDS      (RX_CACHE_CAN_SLOTS / 2)  /* Keeps probe chains short */
+#define RX_CACHE_SERIAL_FIELDS    16
+#define RX_CACHE_SERIAL_SEPARATOR ','
+
+/* Exported types ------------------------------------------------------------*/
+typedef struct {
+  uint8_t data[8];
+  uint8_t length;
+  uint32_t timestamp;     /* HAL tick of the last frame */
+  uint32_t count;         /* Frames received for the ID, 0 if none yet */
+} Rx_Cache_Frame_t;
+
+/* Exported macro ------------------------------------------------------------*/
+/* Exported functions prototypes ---------------------------------------------*/
+void Rx_Cache_Init(void);
+uint8_t Rx_Cache_Subscribe(uint32_t canId);
+void Rx_Cache_UpdateCAN(uint32_t canId, const uint8_t* data, uint8_t length);
+uint8_t Rx_Cache_ReadCAN(uint32_t canId, Rx_Cache_Frame_t* frame);
+void Rx_Cache_ReceiveSerial(uint8_t byte);
+uint8_t Rx_Cache_ReadSerial(uint8_t fieldIndex, int32_t* value);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __RX_CACHE_H */
@@ -0,0 +1,50 @@
+/**
+ * @file timer_wheel.h
+ * @brief Hierarchical timer wheel header file for STM32F407 HID to Serial/CAN project
+ * @author Manus AI
+ * @date 2025-03-28
+ */
+
+#ifndef __TIMER_WHEEL_H
+#define __TIMER_WHEEL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32f4xx_hal.h"
+
+/* Exported constants --------------------------------------------------------*/
+#define TIMER_WHEEL_LEVELS        4
+#define TIMER_WHEEL_SLOT_BITS     6
+#define TIMER_WHEEL_SLOTS         (1 << TIMER_WHEEL_SLOT_BITS)
+#define TIMER_WHEEL_MAX_DELAY     ((1UL << (TIMER_WHEEL_SLOT_BITS * TIMER_WHEEL_LEVELS)) - 1)
+
+/* Exported types ------------------------------------------------------------*/
+typedef void (*Timer_Wheel_Callback_t)(void* context);
+
+/* Timers are owned by the caller and linked into the wheel while armed */
+typedef struct Timer_Wheel_Timer_s {
+  struct Timer_Wheel_Timer_s* next;
+  struct Timer_Wheel_Timer_s* prev;
+  uint32_t expires;
+  Timer_Wheel_Callback_t callback;
+  void* context;
+  uint8_t active;
+} Timer_Wheel_Timer_t;
+
+/* Exported macro ------------------------------------------------------------*/
+/* Exported functions prototypes ---------------------------------------------*/
+void Timer_Wheel_Init(void);
+void Timer_Wheel_Process(void);
+void Timer_Wheel_Start(Timer_Wheel_Timer_t* timer, uint32_t delayMs, Timer_Wheel_Callback_t callback, void* context);
+void Timer_Wheel_Stop(Timer_Wheel_Timer_t* timer);
+uint8_t Timer_Wheel_IsActive(const Timer_Wheel_Timer_t* timer);
+uint32_t Timer_Wheel_GetActiveCount(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __TIMER_WHEEL_H */
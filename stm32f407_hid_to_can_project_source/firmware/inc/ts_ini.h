@@ -0,0 +1,40 @@
+/**
+ * @file ts_ini.h
+ * @brief TunerStudio INI generator header file for STM32F407 HID to Serial/CAN project
+ * @author Manus AI
+ * @date 2025-03-28
+ */
+
+#ifndef __TS_INI_H
+#define __TS_INI_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "ts_protocol.h"
+
+/* Exported constants --------------------------------------------------------*/
+#define TS_INI_LINE_SIZE          160   /* Longest generated line plus terminator */
+
+/* Exported types ------------------------------------------------------------*/
+/* Position in the INI, the text is rendered one line at a time */
+typedef struct {
+  uint8_t section;
+  uint16_t item;            /* Line within the section */
+  uint16_t linePosition;
+  uint16_t lineLength;
+  char line[TS_INI_LINE_SIZE];
+} TS_Ini_Stream_t;
+
+/* Exported macro ------------------------------------------------------------*/
+/* Exported functions prototypes ---------------------------------------------*/
+void TS_Ini_Start(TS_Ini_Stream_t* stream);
+uint16_t TS_Ini_Read(TS_Ini_Stream_t* stream, char* buffer, uint16_t size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __TS_INI_H */
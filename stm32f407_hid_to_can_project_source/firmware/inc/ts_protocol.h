@@ -0,0 +1,159 @@
+/**
+ * @file ts_protocol.h
+ * @brief TunerStudio protocol description for STM32F407 HID to Serial/CAN project
+ * @author Manus AI
+ * @date 2025-03-28
+ *
+ * The single description of what the firmware serves to TunerStudio: the
+ * commands, the configuration pages with their fields and the output
+ * channels. The lists below are X-macros. The firmware expands them into its
+ * page and channel tables, and tools/gen_ts_ini.c expands the same lists into
+ * the INI file, so the two cannot drift apart. Nothing here depends on the
+ * HAL, so the host tool includes it as is.
+ *
+ * Field types are the INI types (U08, S08, U16, S16, U32, S32), all little
+ * endian. Offsets follow list order without padding. Scale, translate, min
+ * and max are written to the INI exactly as they appear here; the firmware
+ * also refuses to burn a page with a field outside min and max.
+ */
+
+#ifndef __TS_PROTOCOL_H
+#define __TS_PROTOCOL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stddef.h>
+#include <stdint.h>
+
+/* Exported constants --------------------------------------------------------*/
+#define TS_SIGNATURE              "STM32HID"
+#define TS_VERSION_STRING         "STM32F407 HID to Serial/CAN 1.0.0"
+#define TS_INI_VERSION            "1.0.0"
+
+/* Framing: payload size (16-bit BE), payload, CRC-32 of the payload (BE) */
+#define TS_FRAME_OVERHEAD         6
+#define TS_MAX_PAYLOAD            256
+#define TS_BLOCKING_FACTOR        (TS_MAX_PAYLOAD - 7)  /* Chunk data after a 'C' header */
+#define TS_PROTOCOL_VERSION       "001"
+
+/* The same frames over CAN, segmented with ISO 15765-2 */
+#define TS_CAN_REQUEST_ID         0x7E0
+#define TS_CAN_RESPONSE_ID        0x7E8
+
+/* Command codes, the first payload byte. Page, offset and count are 16-bit LE. */
+#define TS_CMD_QUERY              'Q'   /* Signature, also unframed */
+#define TS_CMD_HELLO              'S'   /* Version string, also unframed */
+#define TS_CMD_PROTOCOL           'F'   /* Protocol version, also unframed */
+#define TS_CMD_OUTPUT_CHANNELS    'O'   /* offset, count */
+#define TS_CMD_READ_PAGE          'R'   /* page, offset, count */
+#define TS_CMD_WRITE_CHUNK        'C'   /* page, offset, count, data */
+#define TS_CMD_BURN_PAGE          'B'   /* page */
+#define TS_CMD_PAGE_CRC           'k'   /* page, offset, count; CRC-32 (BE) */
+#define TS_CMD_LOGGER_CONTROL     'l'   /* mode (0 stop, 1 start), sources, first and last CAN ID (32-bit LE) */
+#define TS_CMD_LOGGER_READ        'L'   /* Next block of logged records, see data_logger.c */
+
+/* Response codes, the first payload byte of a response */
+#define TS_RESPONSE_OK            0x00
+#define TS_RESPONSE_BURN_OK       0x04
+#define TS_RESPONSE_UNDERRUN      0x80
+#define TS_RESPONSE_OVERRUN       0x81
+#define TS_RESPONSE_CRC_FAILURE   0x82
+#define TS_RESPONSE_UNRECOGNIZED  0x83
+#define TS_RESPONSE_OUT_OF_RANGE  0x84
+#define TS_RESPONSE_BURN_FAILED   0x85
+
+/* Configuration pages: X(id, title, fields) */
+#define TS_PAGES(X) \
+  X(settings, "Main Settings", TS_SETTINGS_FIELDS)
+
+/* Page fields: X(page, name, type, label, units, scale, translate, min, max, digits, default),
+   the page id is passed through so an expansion can name the page layout */
+#define TS_SETTINGS_FIELDS(X, page) \
+  X(page, serialEnabled,  U08, "Serial output",    "",    1, 0, 0,      1,       0, 1)      \
+  X(page, serialBaudRate, U32, "Serial baud rate", "bps", 1, 0, 1200,   1000000, 0, 115200) \
+  X(page, serialFormat,   U08, "Serial format",    "",    1, 0, 0,      4,       0, 0)      \
+  X(page, serialStopBits, U08, "Serial stop bits", "",    1, 0, 1,      2,       0, 1)      \
+  X(page, serialParity,   U08, "Serial parity",    "",    1, 0, 0,      2,       0, 0)      \
+  X(page, canEnabled,     U08, "CAN output",       "",    1, 0, 0,      1,       0, 1)      \
+  X(page, canBitRate,     U32, "CAN bit rate",     "bps", 1, 0, 125000, 1000000, 0, 500000) \
+  X(page, canLoopback,    U08, "CAN loopback",     "",    1, 0, 0,      1,       0, 0)      \
+  X(page, mappingProfile, U08, "Mapping profile",  "",    1, 0, 0,      3,       0, 0)
+
+/* Output channels: X(name, type, units, scale, translate) */
+#define TS_OUTPUT_CHANNELS(X) \
+  X(hidDevices,     U08, "",       1, 0) \
+  X(mappings,       U08, "",       1, 0) \
+  X(activeProfile,  U08, "",       1, 0) \
+  X(inputQueue,     U08, "events", 1, 0) \
+  X(canTxQueue,     U08, "frames", 1, 0) \
+  X(canRxQueue,     U08, "frames", 1, 0) \
+  X(serialTxQueue,  U16, "bytes",  1, 0) \
+  X(timers,         U16, "",       1, 0) \
+  X(canTxRate,      U16, "fps",    1, 0) \
+  X(canRxRate,      U16, "fps",    1, 0) \
+  X(serialTxRate,   U16, "B/s",    1, 0) \
+  X(mappingRate,    U16, "ev/s",   1, 0) \
+  X(tsSerialRate,   U16, "B/s",    1, 0) \
+  X(tsCanRate,      U16, "B/s",    1, 0) \
+  X(loggerPending,  U16, "",       1, 0) \
+  X(lookupP50,      U16, "cycles", 1, 0) \
+  X(lookupP99,      U16, "cycles", 1, 0) \
+  X(lookupMax,      U16, "cycles", 1, 0) \
+  X(loopTime,       U16, "us",     1, 0) \
+  X(loopPeak,       U16, "us",     1, 0) \
+  X(mappingEvents,  U32, "",       1, 0) \
+  X(canRxDropped,   U32, "frames", 1, 0) \
+  X(loggerOverruns, U32, "",       1, 0) \
+  X(uptime,         U32, "ms",     1, 0)
+
+/* Exported macro ------------------------------------------------------------*/
+#define TS_TYPE_SIZE_U08          1
+#define TS_TYPE_SIZE_S08          1
+#define TS_TYPE_SIZE_U16          2
+#define TS_TYPE_SIZE_S16          2
+#define TS_TYPE_SIZE_U32          4
+#define TS_TYPE_SIZE_S32          4
+
+#define TS_TYPE_C_U08             uint8_t
+#define TS_TYPE_C_S08             int8_t
+#define TS_TYPE_C_U16             uint16_t
+#define TS_TYPE_C_S16             int16_t
+#define TS_TYPE_C_U32             uint32_t
+#define TS_TYPE_C_S32             int32_t
+
+#define TS_TYPE_SIZE(type)        TS_TYPE_SIZE_##type
+#define TS_TYPE_C(type)           TS_TYPE_C_##type
+
+/* Layouts are byte arrays, so the compiler adds no padding and offsetof()
+   gives the wire offsets */
+#define TS_LAYOUT_FIELD(page, name, type, ...)  uint8_t name[TS_TYPE_SIZE(type)];
+#define TS_LAYOUT_CHANNEL(name, type, ...)      uint8_t name[TS_TYPE_SIZE(type)];
+#define TS_LAYOUT_PAGE(id, title, fields)       typedef struct { fields(TS_LAYOUT_FIELD, id) } TS_Page_##id##_t;
+#define TS_PAGE_ENUM(id, title, fields)         TS_PAGE_##id,
+#define TS_PAGE_MEMBER(id, title, fields)       TS_Page_##id##_t id;
+
+/* Exported types ------------------------------------------------------------*/
+TS_PAGES(TS_LAYOUT_PAGE)
+
+/* Every page in one slot, so page storage is an array */
+typedef union {
+  TS_PAGES(TS_PAGE_MEMBER)
+} TS_Page_t;
+
+typedef struct {
+  TS_OUTPUT_CHANNELS(TS_LAYOUT_CHANNEL)
+} TS_Channel_Block_t;
+
+typedef enum {
+  TS_PAGES(TS_PAGE_ENUM)
+  TS_PAGE_COUNT
+} TS_Page_Id_t;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __TS_PROTOCOL_H */
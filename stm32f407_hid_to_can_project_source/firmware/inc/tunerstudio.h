@@ -14,6 +14,7 @@ extern "C" {
 
 /* Includes ------------------------------------------------------------------*/
 #include "stm32f4xx_hal.h"
+#include "ts_protocol.h"
 
 /* Exported types ------------------------------------------------------------*/
 typedef enum {
@@ -27,34 +28,24 @@ typedef struct {
   uint8_t enabled;
   uint32_t baudRate;
   uint8_t protocol;
-  char signature[16];
-  uint8_t pageSize;
-  uint8_t pageCount;
 } TS_Config_t;
 
 /* Exported constants --------------------------------------------------------*/
-#define TS_BUFFER_SIZE            256
-#define TS_MAX_PAGES              8
-#define TS_MAX_CHANNELS           32
+#define TS_BUFFER_SIZE            TS_MAX_PAYLOAD
+#define TS_RX_RING_SIZE           512   /* Power of two */
 
 /* Protocol types */
 #define TS_PROTOCOL_MS            0
 #define TS_PROTOCOL_CUSTOM        1
 
-/* Command codes */
-#define TS_CMD_ECHO               0
-#define TS_CMD_GET_SIGNATURE      1
-#define TS_CMD_GET_VERSION        7
-#define TS_CMD_GET_PAGE           0x62
-#define TS_CMD_SET_PAGE           0x77
-#define TS_CMD_BURN_PAGE          0x42
-#define TS_CMD_GET_CHANNELS       0x72
+/* Commands, pages and channels are described in ts_protocol.h */
 
 /* Exported macro ------------------------------------------------------------*/
 /* Exported functions prototypes ---------------------------------------------*/
 void TS_Init(void);
 void TS_Process(void);
 TS_State_t TS_GetState(void);
+uint8_t TS_IsIdle(uint32_t quietMs);
 uint8_t TS_Configure(TS_Config_t* config);
 TS_Config_t* TS_GetConfig(void);
 uint8_t TS_Start(void);
@@ -62,7 +53,9 @@ uint8_t TS_Stop(void);
 uint8_t TS_SaveConfig(void);
 uint8_t TS_LoadConfig(void);
 void TS_ResetConfig(void);
-uint8_t TS_GenerateINI(char* buffer, uint16_t bufferSize);
+uint8_t TS_ReadChannels(uint16_t offset, uint8_t* data, uint16_t count);
+uint8_t TS_ReadPage(uint8_t page, uint16_t offset, uint8_t* data, uint16_t count);
+uint8_t TS_WritePage(uint8_t page, uint16_t offset, const uint8_t* data, uint16_t count);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,61 @@
+/**
+ * @file uds_server.h
+ * @brief UDS diagnostic server header file for STM32F407 HID to Serial/CAN project
+ * @author Manus AI
+ * @date 2025-03-28
+ */
+
+#ifndef __UDS_SERVER_H
+#define __UDS_SERVER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32f4xx_hal.h"
+
+/* Exported constants --------------------------------------------------------*/
+/* Addressing, the ECU pair after the TunerStudio link on 0x7E0/0x7E8 */
+#define UDS_CAN_REQUEST_ID        0x7E1
+#define UDS_CAN_RESPONSE_ID       0x7E9
+#define UDS_CAN_FUNCTIONAL_ID     0x7DF  /* Single frame requests to every ECU */
+
+#define UDS_BUFFER_SIZE           256   /* Longest response */
+#define UDS_MAX_REQUEST           64    /* Longest request */
+#define UDS_P2_MS                 50    /* Response time reported to the tester */
+#define UDS_P2_EXTENDED_MS        5000
+#define UDS_S3_MS                 5000  /* Extended session ends without requests */
+
+/* Data identifiers. Values are big endian on the wire. Configuration fields
+   and output channels are numbered in ts_protocol.h list order. */
+#define UDS_DID_FIELD_BASE        0x0100  /* Configuration fields, read and write */
+#define UDS_DID_CHANNEL_BASE      0x0200  /* Output channels, read only */
+#define UDS_DID_ACTIVE_SESSION    0xF186
+#define UDS_DID_SOFTWARE_VERSION  0xF195
+#define UDS_DID_SYSTEM_NAME       0xF197
+
+/* Sessions */
+#define UDS_SESSION_DEFAULT       0x01
+#define UDS_SESSION_EXTENDED      0x03  /* Needed for writes */
+
+/* Exported types ------------------------------------------------------------*/
+typedef struct {
+  uint32_t requests;
+  uint32_t negativeResponses;
+  uint32_t linkErrors;      /* ISO-TP timeouts, sequence errors and overflows */
+} Uds_Server_Stats_t;
+
+/* Exported macro ------------------------------------------------------------*/
+/* Exported functions prototypes ---------------------------------------------*/
+void Uds_Server_Init(void);
+void Uds_Server_Process(void);
+uint8_t Uds_Server_GetSession(void);
+uint8_t Uds_Server_IsIdle(uint32_t quietMs);
+void Uds_Server_GetStats(Uds_Server_Stats_t* stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __UDS_SERVER_H */
@@ -22,7 +22,8 @@ typedef enum {
   WEB_SERVER_STATE_CONNECTED,
   WEB_SERVER_STATE_PROCESSING,
   WEB_SERVER_STATE_SENDING,
-  WEB_SERVER_STATE_ERROR
+  WEB_SERVER_STATE_ERROR,
+  WEB_SERVER_STATE_STARTING   /* Network bring-up pending, runs from Web_Server_Process */
 } Web_Server_State_t;
 
 typedef struct {
@@ -0,0 +1,292 @@
+/**
+ * @file display_sim.c
+ * @brief Host display simulator for STM32F407 HID to Serial/CAN project
+ * @author Manus AI
+ * @date 2025-03-28
+ *
+ * Runs the unmodified display manager against the panel model and writes
+ * what the GC9A01 would show as PPM images, with the SPI traffic of every
+ * frame as CSV on stdout:
+ *
+ *   frame,tick_ms,bytes,pixels,windows
+ *
+ * Usage: display_sim [-o dir] [-n frames] [-t ms] [-e every]
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "display_manager.h"
+#include "timer_wheel.h"
+#include "config_store.h"
+#include "boot_monitor.h"
+#include "output_manager.h"
+#include "rx_cache.h"
+#include "sim_hal.h"
+#include "sim_panel.h"
+#include <string.h>
+#include <unistd.h>
+
+/* Private define ------------------------------------------------------------*/
+#define SIM_INIT_TIMEOUT_MS       1000
+#define SIM_PATH_SIZE             512
+#define SIM_RPM_CAN_ID            0x360   /* RPM in bytes 0-1, MSB first */
+#define SIM_RPM_MAX               8000
+
+/* Private function prototypes -----------------------------------------------*/
+static void Display_Sim_SetupItems(void);
+static uint8_t Display_Sim_WriteFrame(const char* dir, uint32_t frame);
+static void Display_Sim_SendRPM(uint32_t tick);
+
+/**
+  * @brief  Simulator entry point
+  * @param  argc: Argument count
+  * @param  argv: Arguments
+  * @retval int: 0 if successful, 1 if failed
+  */
+int main(int argc, char** argv)
+{
+  const char* dir = ".";
+  uint32_t frames = 300;
+  uint32_t stepMs = 33;
+  uint32_t every = 30;
+  Sim_Panel_Stats_t stats;
+  int option;
+  
+  while ((option = getopt(argc, argv, "o:n:t:e:")) != -1) {
+    switch (option) {
+      case 'o':
+        dir = optarg;
+        break;
+      
+      case 'n':
+        frames = strtoul(optarg, NULL, 0);
+        break;
+      
+      case 't':
+        stepMs = strtoul(optarg, NULL, 0);
+        break;
+      
+      case 'e':
+        every = strtoul(optarg, NULL, 0);
+        break;
+      
+      default:
+        fprintf(stderr, "usage: %s [-o dir] [-n frames] [-t ms] [-e every]\n", argv[0]);
+        return 1;
+    }
+  }
+  
+  Sim_Panel_Reset();
+  Rx_Cache_Init();
+  Timer_Wheel_Init();
+  Display_Manager_Init();
+  
+  /* The power-up sequence runs on the timer wheel */
+  for (uint32_t ms = 0; !Display_Manager_IsReady(); ms++) {
+    if (ms >= SIM_INIT_TIMEOUT_MS) {
+      fprintf(stderr, "display_sim: display did not finish initializing\n");
+      return 1;
+    }
+    
+    Sim_Hal_Advance(1);
+    Timer_Wheel_Process();
+  }
+  
+  Sim_Panel_TakeStats(&stats);
+  fprintf(stderr, "display_sim: init %u bytes at %u ms\n", stats.bytes, HAL_GetTick());
+  
+  Display_Sim_SetupItems();
+  
+  printf("frame,tick_ms,bytes,pixels,windows\n");
+  
+  for (uint32_t frame = 0; frame < frames; frame++) {
+    Sim_Hal_Advance(stepMs);
+    Display_Sim_SendRPM(HAL_GetTick());
+    Timer_Wheel_Process();
+    Display_Manager_Process();
+    
+    Sim_Panel_TakeStats(&stats);
+    printf("%u,%u,%u,%u,%u\n", frame, HAL_GetTick(), stats.bytes, stats.pixels, stats.windows);
+    
+    if ((every > 0 && frame % every == 0) || frame == frames - 1) {
+      if (!Display_Sim_WriteFrame(dir, frame)) {
+        fprintf(stderr, "display_sim: cannot write frame %u to %s\n", frame, dir);
+        return 1;
+      }
+    }
+  }
+  
+  return 0;
+}
+
+/**
+  * @brief  Replace the default items with a dashboard using every item type
+  * @note   The ring is driven by the uptime in seconds, so it moves once a
+  *         second of simulated time. The needle shows RPM from CAN frames.
+  * @param  None
+  * @retval None
+  */
+static void Display_Sim_SetupItems(void)
+{
+  Display_Item_t item;
+  
+  for (uint8_t i = 0; i < MAX_DISPLAY_ITEMS; i++) {
+    Display_Manager_RemoveItem(i);
+  }
+  
+  memset(&item, 0, sizeof(item));
+  item.dataSource = DISPLAY_DATA_SOURCE_SYSTEM;
+  item.source.system.paramId = 3;  /* Uptime in seconds */
+  item.backgroundColor = 0x0000;
+  item.refreshRate = 16;
+  
+  /* Outer ring, then a needle dial inside it */
+  item.type = DISPLAY_ITEM_ARC;
+  item.x = 0;
+  item.y = 0;
+  item.width = 240;
+  item.height = 240;
+  item.color = 0x07E0;
+  item.gauge.startAngle = -135;
+  item.gauge.sweepAngle = 270;
+  item.gauge.maxValue = 20;
+  item.gauge.thickness = 10;
+  Display_Manager_AddItem(&item);
+  
+  item.type = DISPLAY_ITEM_NEEDLE;
+  item.x = 50;
+  item.y = 50;
+  item.width = 140;
+  item.height = 140;
+  item.color = 0xF800;
+  item.dataSource = DISPLAY_DATA_SOURCE_CAN;
+  item.source.can.canId = SIM_RPM_CAN_ID;
+  item.source.can.dataIndex = 0;
+  item.source.can.dataLength = 2;
+  item.source.can.flags = 0;
+  item.gauge.maxValue = SIM_RPM_MAX;
+  item.gauge.thickness = 0;
+  item.hysteresis = 20;
+  Display_Manager_AddItem(&item);
+  
+  item.type = DISPLAY_ITEM_VALUE;
+  item.x = 80;
+  item.y = 160;
+  item.width = 80;
+  item.height = 20;
+  item.color = 0xFFFF;
+  strcpy(item.label, "RPM");
+  Display_Manager_AddItem(&item);
+  
+  item.dataSource = DISPLAY_DATA_SOURCE_SYSTEM;
+  item.source.system.paramId = 3;  /* Uptime in seconds */
+  item.hysteresis = 0;
+  item.type = DISPLAY_ITEM_VALUE;
+  item.x = 80;
+  item.y = 190;
+  item.width = 80;
+  item.height = 20;
+  item.color = 0xFFFF;
+  strcpy(item.label, "Up");
+  Display_Manager_AddItem(&item);
+  
+  item.type = DISPLAY_ITEM_TEXT;
+  item.x = 80;
+  item.y = 30;
+  item.source.system.paramId = 0;  /* Status */
+  strcpy(item.label, "Status");
+  Display_Manager_AddItem(&item);
+}
+
+/**
+  * @brief  Write the panel image of a frame
+  * @param  dir: Output directory
+  * @param  frame: Frame number
+  * @retval uint8_t: 1 if successful, 0 if failed
+  */
+static uint8_t Display_Sim_WriteFrame(const char* dir, uint32_t frame)
+{
+  char path[SIM_PATH_SIZE];
+  
+  snprintf(path, sizeof(path), "%s/frame_%04u.ppm", dir, frame);
+  
+  return Sim_Panel_WritePPM(path);
+}
+
+/**
+  * @brief  Deliver an RPM frame the way the CAN receive interrupt would
+  * @note   RPM sweeps up and down over four seconds.
+  * @param  tick: Simulated time in ms
+  * @retval None
+  */
+static void Display_Sim_SendRPM(uint32_t tick)
+{
+  uint32_t phase = tick % 4000;
+  uint16_t rpm = (phase < 2000 ? phase : 4000 - phase) * SIM_RPM_MAX / 2000;
+  uint8_t data[8] = {(uint8_t)(rpm >> 8), (uint8_t)rpm, 0, 0, 0, 0, 0, 0};
+  
+  Rx_Cache_UpdateCAN(SIM_RPM_CAN_ID, data, sizeof(data));
+}
+
+/* Firmware modules the display manager calls, not part of the simulation */
+
+/**
+  * @brief  Configuration store stub, nothing is stored
+  * @param  key: Record key
+  * @param  data: Buffer for the value
+  * @param  length: Value length
+  * @retval uint8_t: 0, so the defaults are used
+  */
+uint8_t Config_Store_Read(uint16_t key, void* data, uint16_t length)
+{
+  (void)key;
+  (void)data;
+  (void)length;
+  
+  return 0;
+}
+
+/**
+  * @brief  Configuration store stub, writes are dropped
+  * @param  key: Record key
+  * @param  data: Value
+  * @param  length: Value length
+  * @retval uint8_t: 1
+  */
+uint8_t Config_Store_Write(uint16_t key, const void* data, uint16_t length)
+{
+  (void)key;
+  (void)data;
+  (void)length;
+  
+  return 1;
+}
+
+/**
+  * @brief  Boot monitor stub
+  * @param  phase: Boot phase reached
+  * @retval None
+  */
+void Boot_Monitor_Mark(Boot_Phase_t phase)
+{
+  (void)phase;
+}
+
+/**
+  * @brief  CAN output stub, frames are printed to stderr
+  * @param  canId: CAN identifier
+  * @param  data: Frame data
+  * @param  length: Data length
+  * @retval uint8_t: 1
+  */
+uint8_t Output_Manager_SendCAN(uint32_t canId, uint8_t* data, uint8_t length)
+{
+  fprintf(stderr, "display_sim: CAN 0x%03X", canId);
+  
+  for (uint8_t i = 0; i < length; i++) {
+    fprintf(stderr, " %02X", data[i]);
+  }
+  
+  fprintf(stderr, "\n");
+  
+  return 1;
+}
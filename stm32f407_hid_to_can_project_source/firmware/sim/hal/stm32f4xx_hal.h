@@ -0,0 +1,258 @@
+/**
+ * @file stm32f4xx_hal.h
+ * @brief Host HAL shim for the simulators of STM32F407 HID to Serial/CAN project
+ * @author Manus AI
+ * @date 2025-03-28
+ *
+ * Only what the simulated firmware modules use. Register blocks are plain
+ * structs, SPI and GPIO writes go to the panel model in sim_panel.c and
+ * USART2 is a pseudo-terminal in sim_uart.c.
+ */
+
+#ifndef __STM32F4xx_HAL_H
+#define __STM32F4xx_HAL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <stddef.h>
+
+/* Exported types ------------------------------------------------------------*/
+typedef enum {
+  HAL_OK = 0,
+  HAL_ERROR,
+  HAL_BUSY,
+  HAL_TIMEOUT
+} HAL_StatusTypeDef;
+
+typedef enum {
+  GPIO_PIN_RESET = 0,
+  GPIO_PIN_SET
+} GPIO_PinState;
+
+typedef struct {
+  volatile uint32_t ODR;
+} GPIO_TypeDef;
+
+typedef struct {
+  volatile uint32_t CR1;
+  volatile uint32_t SR;
+  volatile uint32_t DR;
+} SPI_TypeDef;
+
+typedef struct {
+  volatile uint32_t CR;
+} DMA_Stream_TypeDef;
+
+typedef struct {
+  uint32_t Channel;
+  uint32_t Direction;
+  uint32_t PeriphInc;
+  uint32_t MemInc;
+  uint32_t PeriphDataAlignment;
+  uint32_t MemDataAlignment;
+  uint32_t Mode;
+  uint32_t Priority;
+  uint32_t FIFOMode;
+} DMA_InitTypeDef;
+
+typedef struct {
+  DMA_Stream_TypeDef* Instance;
+  DMA_InitTypeDef Init;
+  void* Parent;
+} DMA_HandleTypeDef;
+
+typedef struct {
+  uint32_t Mode;
+  uint32_t Direction;
+  uint32_t DataSize;
+  uint32_t CLKPolarity;
+  uint32_t CLKPhase;
+  uint32_t NSS;
+  uint32_t BaudRatePrescaler;
+  uint32_t FirstBit;
+  uint32_t TIMode;
+  uint32_t CRCCalculation;
+  uint32_t CRCPolynomial;
+} SPI_InitTypeDef;
+
+typedef struct {
+  SPI_TypeDef* Instance;
+  SPI_InitTypeDef Init;
+  DMA_HandleTypeDef* hdmatx;
+} SPI_HandleTypeDef;
+
+typedef struct {
+  volatile uint32_t SR;
+  volatile uint32_t DR;
+} USART_TypeDef;
+
+typedef struct {
+  uint32_t BaudRate;
+  uint32_t WordLength;
+  uint32_t StopBits;
+  uint32_t Parity;
+  uint32_t Mode;
+  uint32_t HwFlowCtl;
+  uint32_t OverSampling;
+} UART_InitTypeDef;
+
+typedef struct {
+  USART_TypeDef* Instance;
+  UART_InitTypeDef Init;
+  DMA_HandleTypeDef* hdmatx;
+  DMA_HandleTypeDef* hdmarx;
+} UART_HandleTypeDef;
+
+typedef struct {
+  volatile uint32_t CTRL;
+  volatile uint32_t CYCCNT;
+} DWT_Type;
+
+typedef struct {
+  volatile uint32_t DEMCR;
+} CoreDebug_Type;
+
+/* Exported constants --------------------------------------------------------*/
+#define GPIO_PIN_1                ((uint16_t)0x0002)
+#define GPIO_PIN_2                ((uint16_t)0x0004)
+#define GPIO_PIN_3                ((uint16_t)0x0008)
+#define GPIO_PIN_4                ((uint16_t)0x0010)
+#define GPIO_PIN_13               ((uint16_t)0x2000)
+
+#define SPI_MODE_MASTER           0x0104
+#define SPI_DIRECTION_2LINES      0x0000
+#define SPI_DATASIZE_8BIT         0x0000
+#define SPI_DATASIZE_16BIT        SPI_CR1_DFF
+#define SPI_POLARITY_LOW          0x0000
+#define SPI_PHASE_1EDGE           0x0000
+#define SPI_NSS_SOFT              0x0200
+#define SPI_BAUDRATEPRESCALER_2   0x0000
+#define SPI_FIRSTBIT_MSB          0x0000
+#define SPI_TIMODE_DISABLE        0x0000
+#define SPI_CRCCALCULATION_DISABLE 0x0000
+#define SPI_CR1_SPE               0x0040
+#define SPI_CR1_DFF               0x0800
+#define SPI_FLAG_TXE              0x0002
+#define SPI_FLAG_BSY              0x0080
+
+#define DMA_CHANNEL_3             0x06000000
+#define DMA_CHANNEL_4             0x08000000
+#define DMA_PERIPH_TO_MEMORY      0x0000
+#define DMA_MEMORY_TO_PERIPH      0x0040
+#define DMA_PINC_DISABLE          0x0000
+#define DMA_MINC_ENABLE           0x0400
+#define DMA_PDATAALIGN_BYTE       0x0000
+#define DMA_PDATAALIGN_HALFWORD   0x0800
+#define DMA_MDATAALIGN_BYTE       0x0000
+#define DMA_MDATAALIGN_HALFWORD   0x2000
+#define DMA_NORMAL                0x0000
+#define DMA_CIRCULAR              0x0100
+#define DMA_PRIORITY_LOW          0x0000
+#define DMA_PRIORITY_HIGH         0x20000
+#define DMA_FIFOMODE_DISABLE      0x0000
+#define DMA_SxCR_MINC             0x0400
+
+#define UART_WORDLENGTH_8B        0x0000
+#define UART_STOPBITS_1           0x0000
+#define UART_PARITY_NONE          0x0000
+#define UART_MODE_TX_RX           0x000C
+#define UART_HWCONTROL_NONE       0x0000
+#define UART_OVERSAMPLING_16      0x0000
+
+#define DMA1_Stream5_IRQn         16
+#define DMA1_Stream6_IRQn         17
+#define USART2_IRQn               38
+#define DMA2_Stream3_IRQn         59
+
+#define CoreDebug_DEMCR_TRCENA_Msk 0x01000000
+#define DWT_CTRL_CYCCNTENA_Msk    0x00000001
+
+/* Exported variables --------------------------------------------------------*/
+extern GPIO_TypeDef simGpioA;
+extern GPIO_TypeDef simGpioC;
+extern SPI_TypeDef simSpi1;
+extern DMA_Stream_TypeDef simDma1Stream5;
+extern DMA_Stream_TypeDef simDma1Stream6;
+extern DMA_Stream_TypeDef simDma2Stream3;
+extern USART_TypeDef simUsart2;
+extern DWT_Type simDwt;
+extern CoreDebug_Type simCoreDebug;
+extern uint32_t SystemCoreClock;
+
+#define GPIOA                     (&simGpioA)
+#define GPIOC                     (&simGpioC)
+#define SPI1                      (&simSpi1)
+#define DMA1_Stream5              (&simDma1Stream5)
+#define DMA1_Stream6              (&simDma1Stream6)
+#define DMA2_Stream3              (&simDma2Stream3)
+#define USART2                    (&simUsart2)
+#define DWT                       (&simDwt)
+#define CoreDebug                 (&simCoreDebug)
+
+/* Exported macro ------------------------------------------------------------*/
+/* The simulated bus is never busy and always ready for the next byte */
+#define __HAL_SPI_GET_FLAG(h, flag)   ((flag) == SPI_FLAG_TXE)
+#define __HAL_SPI_ENABLE(h)           ((h)->Instance->CR1 |= SPI_CR1_SPE)
+#define __HAL_SPI_DISABLE(h)          ((h)->Instance->CR1 &= ~SPI_CR1_SPE)
+#define __HAL_LINKDMA(h, field, dma)  do { (h)->field = &(dma); (dma).Parent = (h); } while (0)
+#define __HAL_RCC_DMA1_CLK_ENABLE()   ((void)0)
+#define __HAL_RCC_DMA2_CLK_ENABLE()   ((void)0)
+
+/* Byte writes of the display driver go straight to the panel decoder */
+#define DISPLAY_SPI_WRITE_BYTE(byte)  Sim_Panel_WriteByte(byte)
+
+/* Exported functions prototypes ---------------------------------------------*/
+uint32_t HAL_GetTick(void);
+void HAL_GPIO_WritePin(GPIO_TypeDef* port, uint16_t pin, GPIO_PinState state);
+HAL_StatusTypeDef HAL_SPI_Init(SPI_HandleTypeDef* hspi);
+HAL_StatusTypeDef HAL_SPI_Transmit_DMA(SPI_HandleTypeDef* hspi, uint8_t* data, uint16_t size);
+void HAL_SPI_TxCpltCallback(SPI_HandleTypeDef* hspi);
+HAL_StatusTypeDef HAL_DMA_Init(DMA_HandleTypeDef* hdma);
+void HAL_DMA_IRQHandler(DMA_HandleTypeDef* hdma);
+void HAL_NVIC_SetPriority(int irq, uint32_t preemptPriority, uint32_t subPriority);
+void HAL_NVIC_EnableIRQ(int irq);
+uint32_t HAL_RCC_GetPCLK2Freq(void);
+HAL_StatusTypeDef HAL_UART_Init(UART_HandleTypeDef* huart);
+HAL_StatusTypeDef HAL_UART_Transmit_DMA(UART_HandleTypeDef* huart, uint8_t* data, uint16_t size);
+HAL_StatusTypeDef HAL_UARTEx_ReceiveToIdle_DMA(UART_HandleTypeDef* huart, uint8_t* data, uint16_t size);
+HAL_StatusTypeDef HAL_UART_Abort(UART_HandleTypeDef* huart);
+HAL_StatusTypeDef HAL_UART_AbortTransmit(UART_HandleTypeDef* huart);
+HAL_StatusTypeDef HAL_UART_AbortReceive(UART_HandleTypeDef* huart);
+void HAL_UART_IRQHandler(UART_HandleTypeDef* huart);
+void HAL_UARTEx_RxEventCallback(UART_HandleTypeDef* huart, uint16_t size);
+void HAL_UART_TxCpltCallback(UART_HandleTypeDef* huart);
+void HAL_UART_ErrorCallback(UART_HandleTypeDef* huart);
+void Sim_Panel_WriteByte(uint8_t byte);
+
+static inline void __disable_irq(void)
+{
+}
+
+static inline void __enable_irq(void)
+{
+}
+
+static inline uint32_t __get_PRIMASK(void)
+{
+  return 0;
+}
+
+static inline void __set_PRIMASK(uint32_t primask)
+{
+  (void)primask;
+}
+
+static inline void __DMB(void)
+{
+  __sync_synchronize();
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __STM32F4xx_HAL_H */
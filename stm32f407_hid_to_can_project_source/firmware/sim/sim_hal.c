@@ -0,0 +1,182 @@
+/**
+ * @file sim_hal.c
+ * @brief Host HAL shim for the simulators of STM32F407 HID to Serial/CAN project
+ * @author Manus AI
+ * @date 2025-03-28
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "sim_hal.h"
+#include "sim_panel.h"
+
+/* Exported variables --------------------------------------------------------*/
+GPIO_TypeDef simGpioA;
+GPIO_TypeDef simGpioC;
+SPI_TypeDef simSpi1;
+DMA_Stream_TypeDef simDma1Stream5;
+DMA_Stream_TypeDef simDma1Stream6;
+DMA_Stream_TypeDef simDma2Stream3;
+USART_TypeDef simUsart2;
+DWT_Type simDwt;
+CoreDebug_Type simCoreDebug;
+uint32_t SystemCoreClock = 168000000;
+
+/* Private variables ---------------------------------------------------------*/
+static uint32_t simTick = 0;
+
+/**
+  * @brief  Advance the simulated millisecond tick
+  * @param  ms: Milliseconds to add
+  * @retval None
+  */
+void Sim_Hal_Advance(uint32_t ms)
+{
+  simTick += ms;
+}
+
+/**
+  * @brief  Get the simulated millisecond tick
+  * @param  None
+  * @retval uint32_t: Tick
+  */
+uint32_t HAL_GetTick(void)
+{
+  return simTick;
+}
+
+/**
+  * @brief  Drive a pin, display control lines go to the panel model
+  * @param  port: GPIO port
+  * @param  pin: GPIO pin
+  * @param  state: New pin state
+  * @retval None
+  */
+void HAL_GPIO_WritePin(GPIO_TypeDef* port, uint16_t pin, GPIO_PinState state)
+{
+  if (state == GPIO_PIN_SET) {
+    port->ODR |= pin;
+  } else {
+    port->ODR &= ~pin;
+  }
+  
+  Sim_Panel_SetPin(port, pin, state);
+}
+
+/**
+  * @brief  Initialize the SPI, only the frame size is modelled
+  * @param  hspi: SPI handle
+  * @retval HAL_StatusTypeDef: HAL_OK
+  */
+HAL_StatusTypeDef HAL_SPI_Init(SPI_HandleTypeDef* hspi)
+{
+  hspi->Instance->CR1 = hspi->Init.DataSize;
+  
+  return HAL_OK;
+}
+
+/**
+  * @brief  Send a block the way the DMA stream would and complete at once
+  * @note   The completion callback runs before this returns, so a transfer
+  *         queued behind it starts from inside the call like it would from
+  *         the interrupt.
+  * @param  hspi: SPI handle
+  * @param  data: Source memory
+  * @param  size: Number of frames
+  * @retval HAL_StatusTypeDef: HAL_OK
+  */
+HAL_StatusTypeDef HAL_SPI_Transmit_DMA(SPI_HandleTypeDef* hspi, uint8_t* data, uint16_t size)
+{
+  uint8_t increment = hspi->hdmatx == NULL || (hspi->hdmatx->Instance->CR & DMA_SxCR_MINC);
+  uint8_t wide = (hspi->Instance->CR1 & SPI_CR1_DFF) != 0;
+  
+  for (uint16_t i = 0; i < size; i++) {
+    uint16_t index = increment ? i : 0;
+    
+    if (wide) {
+      Sim_Panel_WriteWord(((const uint16_t*)data)[index]);
+    } else {
+      Sim_Panel_WriteByte(data[index]);
+    }
+  }
+  
+  HAL_SPI_TxCpltCallback(hspi);
+  
+  return HAL_OK;
+}
+
+/**
+  * @brief  Transfer complete callback, weak like the HAL default
+  * @param  hspi: SPI handle
+  * @retval None
+  */
+__attribute__((weak)) void HAL_SPI_TxCpltCallback(SPI_HandleTypeDef* hspi)
+{
+  (void)hspi;
+}
+
+/**
+  * @brief  Initialize a DMA stream, the memory increment setting is kept
+  * @param  hdma: DMA handle
+  * @retval HAL_StatusTypeDef: HAL_OK
+  */
+HAL_StatusTypeDef HAL_DMA_Init(DMA_HandleTypeDef* hdma)
+{
+  hdma->Instance->CR = hdma->Init.MemInc;
+  
+  return HAL_OK;
+}
+
+/**
+  * @brief  DMA interrupt handler, transfers complete synchronously
+  * @param  hdma: DMA handle
+  * @retval None
+  */
+void HAL_DMA_IRQHandler(DMA_HandleTypeDef* hdma)
+{
+  (void)hdma;
+}
+
+/**
+  * @brief  Set interrupt priority, no interrupts on the host
+  * @param  irq: Interrupt number
+  * @param  preemptPriority: Preemption priority
+  * @param  subPriority: Sub priority
+  * @retval None
+  */
+void HAL_NVIC_SetPriority(int irq, uint32_t preemptPriority, uint32_t subPriority)
+{
+  (void)irq;
+  (void)preemptPriority;
+  (void)subPriority;
+}
+
+/**
+  * @brief  Enable an interrupt, no interrupts on the host
+  * @param  irq: Interrupt number
+  * @retval None
+  */
+void HAL_NVIC_EnableIRQ(int irq)
+{
+  (void)irq;
+}
+
+/**
+  * @brief  Get the APB2 clock of the target configuration
+  * @param  None
+  * @retval uint32_t: 84 MHz
+  */
+uint32_t HAL_RCC_GetPCLK2Freq(void)
+{
+  return 84000000;
+}
+
+/**
+  * @brief  Error handler of the firmware, fatal on the host
+  * @param  None
+  * @retval None
+  */
+void Error_Handler(void)
+{
+  fprintf(stderr, "sim: Error_Handler called\n");
+  exit(1);
+}
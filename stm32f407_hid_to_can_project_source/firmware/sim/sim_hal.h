@@ -0,0 +1,27 @@
+/**
+ * @file sim_hal.h
+ * @brief Host HAL shim control header file for STM32F407 HID to Serial/CAN project
+ * @author Manus AI
+ * @date 2025-03-28
+ */
+
+#ifndef __SIM_HAL_H
+#define __SIM_HAL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32f4xx_hal.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+/* Exported functions prototypes ---------------------------------------------*/
+void Sim_Hal_Advance(uint32_t ms);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __SIM_HAL_H */
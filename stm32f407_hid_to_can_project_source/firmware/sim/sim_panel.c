@@ -0,0 +1,241 @@
+/**
+ * @file sim_panel.c
+ * @brief GC9A01 panel model for STM32F407 HID to Serial/CAN project
+ * @author Manus AI
+ * @date 2025-03-28
+ *
+ * Decodes the SPI stream of the display driver the way the controller does:
+ * a byte with DC low is a command, bytes with DC high are its parameters or
+ * pixel data. CASET/RASET set the window, RAMWR writes RGB565 pixels into
+ * it row by row. Everything else is counted but has no effect on the image.
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "sim_panel.h"
+#include "main.h"
+#include <stdio.h>
+#include <string.h>
+
+/* Private define ------------------------------------------------------------*/
+#define GC9A01_CASET              0x2A
+#define GC9A01_RASET              0x2B
+#define GC9A01_RAMWR              0x2C
+
+/* Private variables ---------------------------------------------------------*/
+static uint16_t panelMemory[SIM_PANEL_WIDTH * SIM_PANEL_HEIGHT];
+static uint8_t panelSelected = 0;
+static uint8_t panelData = 0;
+static uint8_t panelCommand = 0;
+static uint8_t panelParams[4];
+static uint8_t panelParamCount = 0;
+static uint16_t windowX0 = 0;
+static uint16_t windowX1 = SIM_PANEL_WIDTH - 1;
+static uint16_t windowY0 = 0;
+static uint16_t windowY1 = SIM_PANEL_HEIGHT - 1;
+static uint16_t cursorX = 0;
+static uint16_t cursorY = 0;
+static uint8_t pixelHigh = 0;
+static uint8_t pixelHalf = 0;
+static Sim_Panel_Stats_t panelStats;
+
+/* Private function prototypes -----------------------------------------------*/
+static void Sim_Panel_WritePixel(uint16_t color);
+
+/**
+  * @brief  Clear panel memory and the decoder state
+  * @param  None
+  * @retval None
+  */
+void Sim_Panel_Reset(void)
+{
+  memset(panelMemory, 0, sizeof(panelMemory));
+  memset(&panelStats, 0, sizeof(panelStats));
+  panelCommand = 0;
+  panelParamCount = 0;
+  pixelHalf = 0;
+}
+
+/**
+  * @brief  Track the CS and DC lines
+  * @param  port: GPIO port
+  * @param  pin: GPIO pin
+  * @param  state: New pin state
+  * @retval None
+  */
+void Sim_Panel_SetPin(GPIO_TypeDef* port, uint16_t pin, GPIO_PinState state)
+{
+  if (port == DISPLAY_CS_PORT && pin == DISPLAY_CS_PIN) {
+    panelSelected = state == GPIO_PIN_RESET;
+    
+    /* Deselecting ends the command */
+    if (!panelSelected) {
+      panelCommand = 0;
+      pixelHalf = 0;
+    }
+  } else if (port == DISPLAY_DC_PORT && pin == DISPLAY_DC_PIN) {
+    panelData = state == GPIO_PIN_SET;
+  }
+}
+
+/**
+  * @brief  Decode one 8-bit SPI frame
+  * @param  byte: Byte on MOSI
+  * @retval None
+  */
+void Sim_Panel_WriteByte(uint8_t byte)
+{
+  if (!panelSelected) {
+    return;
+  }
+  
+  panelStats.bytes++;
+  
+  if (!panelData) {
+    panelCommand = byte;
+    panelParamCount = 0;
+    pixelHalf = 0;
+    
+    if (byte == GC9A01_RAMWR) {
+      cursorX = windowX0;
+      cursorY = windowY0;
+      panelStats.windows++;
+    }
+    
+    return;
+  }
+  
+  switch (panelCommand) {
+    case GC9A01_CASET:
+    case GC9A01_RASET:
+      if (panelParamCount < sizeof(panelParams)) {
+        panelParams[panelParamCount++] = byte;
+      }
+    
+      if (panelParamCount == sizeof(panelParams)) {
+        uint16_t start = (panelParams[0] << 8) | panelParams[1];
+        uint16_t end = (panelParams[2] << 8) | panelParams[3];
+      
+        if (panelCommand == GC9A01_CASET) {
+          windowX0 = start;
+          windowX1 = end;
+        } else {
+          windowY0 = start;
+          windowY1 = end;
+        }
+      }
+      break;
+    
+    case GC9A01_RAMWR:
+      /* 8-bit frames carry a pixel in two bytes, high byte first */
+      if (!pixelHalf) {
+        pixelHigh = byte;
+        pixelHalf = 1;
+      } else {
+        Sim_Panel_WritePixel((pixelHigh << 8) | byte);
+        pixelHalf = 0;
+      }
+      break;
+    
+    default:
+      break;
+  }
+}
+
+/**
+  * @brief  Decode one 16-bit SPI frame
+  * @note   The SPI shifts the high byte first, so a frame is one pixel.
+  * @param  word: Frame on MOSI
+  * @retval None
+  */
+void Sim_Panel_WriteWord(uint16_t word)
+{
+  if (!panelSelected) {
+    return;
+  }
+  
+  if (panelData && panelCommand == GC9A01_RAMWR && !pixelHalf) {
+    panelStats.bytes += 2;
+    Sim_Panel_WritePixel(word);
+    return;
+  }
+  
+  Sim_Panel_WriteByte(word >> 8);
+  Sim_Panel_WriteByte(word & 0xFF);
+}
+
+/**
+  * @brief  Get the counters since the last call and reset them
+  * @param  stats: Pointer to the counters
+  * @retval None
+  */
+void Sim_Panel_TakeStats(Sim_Panel_Stats_t* stats)
+{
+  *stats = panelStats;
+  memset(&panelStats, 0, sizeof(panelStats));
+}
+
+/**
+  * @brief  Read a pixel of panel memory
+  * @param  x: X coordinate
+  * @param  y: Y coordinate
+  * @retval uint16_t: Color in RGB565, 0 outside the panel
+  */
+uint16_t Sim_Panel_GetPixel(uint16_t x, uint16_t y)
+{
+  if (x >= SIM_PANEL_WIDTH || y >= SIM_PANEL_HEIGHT) {
+    return 0;
+  }
+  
+  return panelMemory[y * SIM_PANEL_WIDTH + x];
+}
+
+/**
+  * @brief  Write panel memory as a binary PPM image
+  * @param  path: File to write
+  * @retval uint8_t: 1 if successful, 0 if failed
+  */
+uint8_t Sim_Panel_WritePPM(const char* path)
+{
+  FILE* file = fopen(path, "wb");
+  
+  if (file == NULL) {
+    return 0;
+  }
+  
+  fprintf(file, "P6\n%d %d\n255\n", SIM_PANEL_WIDTH, SIM_PANEL_HEIGHT);
+  
+  for (uint32_t i = 0; i < SIM_PANEL_WIDTH * SIM_PANEL_HEIGHT; i++) {
+    uint16_t color = panelMemory[i];
+    uint8_t rgb[3] = {
+      (uint8_t)(((color >> 11) & 0x1F) * 255 / 31),
+      (uint8_t)(((color >> 5) & 0x3F) * 255 / 63),
+      (uint8_t)((color & 0x1F) * 255 / 31)
+    };
+    
+    fwrite(rgb, 1, sizeof(rgb), file);
+  }
+  
+  return fclose(file) == 0;
+}
+
+/**
+  * @brief  Store a pixel at the cursor and advance it through the window
+  * @param  color: Color in RGB565
+  * @retval None
+  */
+static void Sim_Panel_WritePixel(uint16_t color)
+{
+  if (cursorX < SIM_PANEL_WIDTH && cursorY < SIM_PANEL_HEIGHT) {
+    panelMemory[cursorY * SIM_PANEL_WIDTH + cursorX] = color;
+  }
+  
+  panelStats.pixels++;
+  
+  if (++cursorX > windowX1) {
+    cursorX = windowX0;
+    
+    if (++cursorY > windowY1) {
+      cursorY = windowY0;
+    }
+  }
+}
@@ -0,0 +1,42 @@
+/**
+ * @file sim_panel.h
+ * @brief GC9A01 panel model header file for STM32F407 HID to Serial/CAN project
+ * @author Manus AI
+ * @date 2025-03-28
+ */
+
+#ifndef __SIM_PANEL_H
+#define __SIM_PANEL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32f4xx_hal.h"
+
+/* Exported constants --------------------------------------------------------*/
+#define SIM_PANEL_WIDTH           240
+#define SIM_PANEL_HEIGHT          240
+
+/* Exported types ------------------------------------------------------------*/
+typedef struct {
+  uint32_t bytes;         /* Bytes clocked out with CS low */
+  uint32_t pixels;        /* Pixels written to panel memory */
+  uint32_t windows;       /* RAMWR commands */
+} Sim_Panel_Stats_t;
+
+/* Exported functions prototypes ---------------------------------------------*/
+void Sim_Panel_Reset(void);
+void Sim_Panel_SetPin(GPIO_TypeDef* port, uint16_t pin, GPIO_PinState state);
+void Sim_Panel_WriteByte(uint8_t byte);
+void Sim_Panel_WriteWord(uint16_t word);
+void Sim_Panel_TakeStats(Sim_Panel_Stats_t* stats);
+uint16_t Sim_Panel_GetPixel(uint16_t x, uint16_t y);
+uint8_t Sim_Panel_WritePPM(const char* path);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __SIM_PANEL_H */
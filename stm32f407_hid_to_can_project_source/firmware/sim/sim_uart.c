@@ -0,0 +1,296 @@
+/**
+ * @file sim_uart.c
+ * @brief Pseudo-terminal UART model for STM32F407 HID to Serial/CAN project
+ * @author Manus AI
+ * @date 2025-03-28
+ *
+ * USART2 backed by a pseudo-terminal, so a host tool opens the slave side as
+ * it would open the serial port of the board. Reception models the circular
+ * DMA of the firmware: bytes land in the ring at the write position and a
+ * reception event reports the position after each burst, the way the idle
+ * line event does. A burst that reaches the end of the ring reports the full
+ * size first, like the transfer complete event. A DMA transmission is
+ * written out and completes, callback included, before it returns.
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#define _GNU_SOURCE        /* posix_openpt() and cfmakeraw() */
+
+#include "sim_uart.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <unistd.h>
+
+/* Private define ------------------------------------------------------------*/
+#define SIM_UART_LINK_SIZE        256
+#define SIM_UART_TX_TIMEOUT_MS    100   /* Time for the host to make room */
+
+/* Private variables ---------------------------------------------------------*/
+static int uartMaster = -1;
+static int uartSlave = -1;     /* Held open so the master survives clients closing */
+static char uartLink[SIM_UART_LINK_SIZE];
+
+static UART_HandleTypeDef* uartRx = NULL;  /* Reception running while set */
+static uint8_t* uartRing = NULL;
+static uint16_t uartRingSize = 0;
+static uint16_t uartRingPos = 0;
+
+static Sim_Uart_Stats_t uartStats;
+
+/**
+  * @brief  Open the pseudo-terminal
+  * @param  link: Path of a symbolic link to the slave side, NULL for none
+  * @retval uint8_t: 1 if successful, 0 if failed
+  */
+uint8_t Sim_Uart_Open(const char* link)
+{
+  struct termios tio;
+  const char* name;
+  
+  uartMaster = posix_openpt(O_RDWR | O_NOCTTY);
+  
+  if (uartMaster < 0 || grantpt(uartMaster) != 0 || unlockpt(uartMaster) != 0) {
+    return 0;
+  }
+  
+  name = ptsname(uartMaster);
+  uartSlave = name != NULL ? open(name, O_RDWR | O_NOCTTY) : -1;
+  
+  if (uartSlave < 0) {
+    return 0;
+  }
+  
+  /* Raw bytes both ways, no echo and no line editing */
+  tcgetattr(uartSlave, &tio);
+  cfmakeraw(&tio);
+  tcsetattr(uartSlave, TCSANOW, &tio);
+  
+  fcntl(uartMaster, F_SETFL, fcntl(uartMaster, F_GETFL) | O_NONBLOCK);
+  
+  uartLink[0] = '\0';
+  
+  if (link != NULL) {
+    unlink(link);
+    
+    if (symlink(name, link) != 0) {
+      return 0;
+    }
+    
+    snprintf(uartLink, sizeof(uartLink), "%s", link);
+  }
+  
+  memset(&uartStats, 0, sizeof(uartStats));
+  fprintf(stderr, "sim: USART2 on %s\n", link != NULL ? link : name);
+  
+  return 1;
+}
+
+/**
+  * @brief  Close the pseudo-terminal and remove the link
+  * @param  None
+  * @retval None
+  */
+void Sim_Uart_Close(void)
+{
+  if (uartLink[0] != '\0') {
+    unlink(uartLink);
+    uartLink[0] = '\0';
+  }
+  
+  if (uartSlave >= 0) {
+    close(uartSlave);
+    uartSlave = -1;
+  }
+  
+  if (uartMaster >= 0) {
+    close(uartMaster);
+    uartMaster = -1;
+  }
+}
+
+/**
+  * @brief  Get the descriptor to wait on for received bytes
+  * @param  None
+  * @retval int: Master side descriptor, -1 if not open
+  */
+int Sim_Uart_GetFd(void)
+{
+  return uartMaster;
+}
+
+/**
+  * @brief  Move bytes written by the host into the receive ring
+  * @note   Bytes that arrive while reception is stopped are lost, as they
+  *         would be on the board.
+  * @param  None
+  * @retval uint8_t: 1 if bytes were received, 0 otherwise
+  */
+uint8_t Sim_Uart_Poll(void)
+{
+  uint8_t received = 0;
+  uint8_t scratch[64];
+  ssize_t count;
+  
+  if (uartMaster < 0) {
+    return 0;
+  }
+  
+  for (;;) {
+    if (uartRx == NULL) {
+      count = read(uartMaster, scratch, sizeof(scratch));
+    } else {
+      count = read(uartMaster, &uartRing[uartRingPos], uartRingSize - uartRingPos);
+    }
+    
+    if (count <= 0) {
+      break;
+    }
+    
+    received = 1;
+    
+    if (uartRx == NULL) {
+      continue;
+    }
+    
+    uartStats.rxBytes += count;
+    uartStats.rxEvents++;
+    uartRingPos += count;
+    
+    HAL_UARTEx_RxEventCallback(uartRx, uartRingPos);
+    
+    if (uartRingPos == uartRingSize) {
+      uartRingPos = 0;
+    }
+  }
+  
+  return received;
+}
+
+/**
+  * @brief  Get transfer counters
+  * @param  stats: Pointer to structure receiving the statistics
+  * @retval None
+  */
+void Sim_Uart_GetStats(Sim_Uart_Stats_t* stats)
+{
+  *stats = uartStats;
+}
+
+/**
+  * @brief  Initialize the UART, line settings do not apply to a terminal
+  * @param  huart: UART handle
+  * @retval HAL_StatusTypeDef: HAL_OK
+  */
+HAL_StatusTypeDef HAL_UART_Init(UART_HandleTypeDef* huart)
+{
+  (void)huart;
+  
+  return HAL_OK;
+}
+
+/**
+  * @brief  Send a block to the host the way the DMA stream would
+  * @note   The completion callback runs before this returns, so a transfer
+  *         queued behind it starts from inside the call like it would from
+  *         the interrupt.
+  * @param  huart: UART handle
+  * @param  data: Data to send
+  * @param  size: Number of bytes
+  * @retval HAL_StatusTypeDef: HAL_OK, HAL_TIMEOUT if the host stopped reading
+  */
+HAL_StatusTypeDef HAL_UART_Transmit_DMA(UART_HandleTypeDef* huart, uint8_t* data, uint16_t size)
+{
+  struct pollfd pfd = {uartMaster, POLLOUT, 0};
+  uint16_t sent = 0;
+  
+  if (uartMaster < 0) {
+    return HAL_ERROR;
+  }
+  
+  while (sent < size) {
+    ssize_t count = write(uartMaster, &data[sent], size - sent);
+    
+    if (count > 0) {
+      sent += count;
+      uartStats.txBytes += count;
+    } else if (count < 0 && errno != EAGAIN) {
+      return HAL_ERROR;
+    } else if (poll(&pfd, 1, SIM_UART_TX_TIMEOUT_MS) <= 0) {
+      return HAL_TIMEOUT;
+    }
+  }
+  
+  HAL_UART_TxCpltCallback(huart);
+  
+  return HAL_OK;
+}
+
+/**
+  * @brief  Start reception into a circular ring
+  * @param  huart: UART handle
+  * @param  data: Ring
+  * @param  size: Ring size
+  * @retval HAL_StatusTypeDef: HAL_OK
+  */
+HAL_StatusTypeDef HAL_UARTEx_ReceiveToIdle_DMA(UART_HandleTypeDef* huart, uint8_t* data, uint16_t size)
+{
+  uartRx = huart;
+  uartRing = data;
+  uartRingSize = size;
+  uartRingPos = 0;
+  
+  return HAL_OK;
+}
+
+/**
+  * @brief  Stop transmission and reception
+  * @param  huart: UART handle
+  * @retval HAL_StatusTypeDef: HAL_OK
+  */
+HAL_StatusTypeDef HAL_UART_Abort(UART_HandleTypeDef* huart)
+{
+  HAL_UART_AbortTransmit(huart);
+  
+  return HAL_UART_AbortReceive(huart);
+}
+
+/**
+  * @brief  Stop transmission, transmissions never outlast their call
+  * @param  huart: UART handle
+  * @retval HAL_StatusTypeDef: HAL_OK
+  */
+HAL_StatusTypeDef HAL_UART_AbortTransmit(UART_HandleTypeDef* huart)
+{
+  (void)huart;
+  
+  return HAL_OK;
+}
+
+/**
+  * @brief  Stop reception
+  * @param  huart: UART handle
+  * @retval HAL_StatusTypeDef: HAL_OK
+  */
+HAL_StatusTypeDef HAL_UART_AbortReceive(UART_HandleTypeDef* huart)
+{
+  if (uartRx == huart) {
+    uartRx = NULL;
+  }
+  
+  return HAL_OK;
+}
+
+/**
+  * @brief  UART interrupt handler, events are raised by Sim_Uart_Poll
+  * @param  huart: UART handle
+  * @retval None
+  */
+void HAL_UART_IRQHandler(UART_HandleTypeDef* huart)
+{
+  (void)huart;
+}
@@ -0,0 +1,36 @@
+/**
+ * @file sim_uart.h
+ * @brief Pseudo-terminal UART model header file for STM32F407 HID to Serial/CAN project
+ * @author Manus AI
+ * @date 2025-03-28
+ */
+
+#ifndef __SIM_UART_H
+#define __SIM_UART_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32f4xx_hal.h"
+
+/* Exported types ------------------------------------------------------------*/
+typedef struct {
+  uint32_t rxBytes;       /* Bytes written into the receive ring */
+  uint32_t txBytes;       /* Bytes sent to the terminal */
+  uint32_t rxEvents;      /* Reception events raised */
+} Sim_Uart_Stats_t;
+
+/* Exported functions prototypes ---------------------------------------------*/
+uint8_t Sim_Uart_Open(const char* link);
+void Sim_Uart_Close(void);
+int Sim_Uart_GetFd(void);
+uint8_t Sim_Uart_Poll(void);
+void Sim_Uart_GetStats(Sim_Uart_Stats_t* stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __SIM_UART_H */
@@ -0,0 +1,602 @@
+#!/usr/bin/env python3
+"""
+TunerStudio protocol conformance and throughput check for STM32F407 HID to Serial/CAN project.
+
+Talks to the TunerStudio link the way TunerStudio does, building every
+request from the command formats in the INI, and checks each answer against
+the INI: signature, page sizes, field limits, page CRCs and the output
+channel block. It then measures request round-trip latency and the
+sustained output channel poll rate.
+
+With --sim the client starts ts_sim on a pseudo-terminal, and restarts it
+once to check that a burned page survives. With --port it talks to a board
+through a serial port instead. The exit status is 0 only if every check
+passed, so the check runs unattended:
+
+    make -C sim ts-test
+    sim/ts_client.py --port /dev/ttyUSB0 --ini tunerstudio/stm32f407_hid_can.ini
+"""
+
+import argparse
+import os
+import re
+import select
+import signal
+import struct
+import subprocess
+import sys
+import tempfile
+import termios
+import time
+import tty
+import zlib
+
+TYPES = {
+    "U08": ("<B", 0, 0xFF),
+    "S08": ("<b", -0x80, 0x7F),
+    "U16": ("<H", 0, 0xFFFF),
+    "S16": ("<h", -0x8000, 0x7FFF),
+    "U32": ("<I", 0, 0xFFFFFFFF),
+    "S32": ("<i", -0x80000000, 0x7FFFFFFF),
+}
+
+BAUDS = {rate: getattr(termios, "B%d" % rate) for rate in (9600, 19200, 38400, 57600, 115200, 230400, 460800, 921600)
+         if hasattr(termios, "B%d" % rate)}
+
+
+class Error(Exception):
+    pass
+
+
+def parse_define(text, name):
+    """Return the value of a numeric, character or string #define."""
+    match = re.search(r"#define\s+%s\s+(0x[0-9A-Fa-f]+|\d+|'.'|\"[^\"]*\")" % name, text)
+    if not match:
+        raise SystemExit("ts_client: %s not found" % name)
+    value = match.group(1)
+    if value[0] == "'":
+        return ord(value[1])
+    if value[0] == '"':
+        return value[1:-1]
+    return int(value, 0)
+
+
+def split_values(text):
+    """Split an INI value list on commas outside quotes."""
+    return [value.strip() for value in re.findall(r'\s*("[^"]*"|[^,]*)\s*(?:,|$)', text)][:-1]
+
+
+def unquote(value):
+    value = value.strip()
+    if value.startswith('"') and value.endswith('"'):
+        value = value[1:-1]
+    return value.encode("latin-1").decode("unicode_escape").encode("latin-1")
+
+
+class Scalar:
+    """A page field or output channel: scalar, type, offset, units, scale, translate[, min, max, digits]."""
+
+    def __init__(self, name, values):
+        if values[0] != "scalar" or values[1] not in TYPES:
+            raise SystemExit("ts_client: %s: unsupported definition" % name)
+        self.name = name
+        self.type = values[1]
+        self.offset = int(values[2], 0)
+        self.scale = float(values[4])
+        self.translate = float(values[5])
+        self.min = float(values[6]) if len(values) > 6 else None
+        self.max = float(values[7]) if len(values) > 7 else None
+        self.format, self.type_min, self.type_max = TYPES[self.type]
+        self.size = struct.calcsize(self.format)
+
+    def raw(self, data):
+        return struct.unpack_from(self.format, data, self.offset)[0]
+
+    def value(self, data):
+        return self.raw(data) * self.scale + self.translate
+
+    def encode_value(self, value):
+        raw = int(round((value - self.translate) / self.scale))
+        return struct.pack(self.format, max(self.type_min, min(self.type_max, raw)))
+
+
+class Ini:
+    """The parts of the INI a TunerStudio connection depends on."""
+
+    def __init__(self, path):
+        self.settings = {}
+        self.page_sizes = []
+        self.fields = []        # (page index, Scalar)
+        self.channels = []
+        section = None
+        page = None
+
+        with open(path) as f:
+            for line in f:
+                line = line.split(";", 1)[0].strip()
+                if not line:
+                    continue
+                match = re.match(r"\[(\w+)\]$", line)
+                if match:
+                    section = match.group(1)
+                    continue
+                if "=" not in line:
+                    continue
+                key, value = (part.strip() for part in line.split("=", 1))
+                values = split_values(value)
+                if section == "Constants" and key == "pageSize":
+                    self.page_sizes = [int(size, 0) for size in values]
+                elif section == "Constants" and key == "page":
+                    page = int(value, 0) - 1
+                elif section == "Constants" and values[0] == "scalar":
+                    self.fields.append((page, Scalar(key, values)))
+                elif section == "OutputChannels" and values[0] == "scalar":
+                    self.channels.append(Scalar(key, values))
+                elif section in ("MegaTune", "Constants", "OutputChannels"):
+                    self.settings[key] = value
+
+        for key in ("signature", "queryCommand", "pageReadCommand", "pageChunkWrite", "burnCommand",
+                    "crc32CheckCommand", "ochGetCommand", "ochBlockSize", "blockingFactor"):
+            if key not in self.settings:
+                raise SystemExit("ts_client: %s: %s missing" % (path, key))
+
+        self.signature = unquote(self.settings["signature"])
+        self.och_block_size = int(self.settings["ochBlockSize"], 0)
+        self.blocking_factor = int(self.settings["blockingFactor"], 0)
+        self.page_identifiers = [unquote(value) for value in split_values(self.settings.get("pageIdentifier", ""))]
+
+    def page_fields(self, page):
+        return [field for index, field in self.fields if index == page]
+
+    def command(self, key, page=0, offset=0, count=0, data=b""):
+        """Build a request from an INI command format, as TunerStudio does."""
+        fmt = unquote(self.settings[key])
+        out = b""
+        i = 0
+        while i < len(fmt):
+            if fmt[i:i + 1] != b"%":
+                out += fmt[i:i + 1]
+                i += 1
+                continue
+            match = re.match(rb"%(\d*)([iocv])", fmt[i:])
+            if not match:
+                raise SystemExit("ts_client: %s: cannot expand %r" % (key, fmt))
+            size, kind = int(match.group(1) or 0), match.group(2)
+            if kind == b"i":
+                out += self.page_identifiers[page] if page < len(self.page_identifiers) else struct.pack("<H", page)
+            elif kind == b"o":
+                out += offset.to_bytes(size, "little")
+            elif kind == b"c":
+                out += count.to_bytes(size, "little")
+            else:
+                out += data
+            i += len(match.group(0))
+        return out
+
+
+class Link:
+    """A raw serial line, a pseudo-terminal or a serial port."""
+
+    def __init__(self, path, baud, timeout):
+        self.fd = os.open(path, os.O_RDWR | os.O_NOCTTY)
+        self.timeout = timeout
+        tty.setraw(self.fd)
+        if baud in BAUDS:
+            attrs = termios.tcgetattr(self.fd)
+            attrs[4] = attrs[5] = BAUDS[baud]
+            termios.tcsetattr(self.fd, termios.TCSANOW, attrs)
+        termios.tcflush(self.fd, termios.TCIOFLUSH)
+
+    def close(self):
+        os.close(self.fd)
+
+    def write(self, data):
+        while data:
+            data = data[os.write(self.fd, data):]
+
+    def read(self, count):
+        data = b""
+        deadline = time.monotonic() + self.timeout
+        while len(data) < count:
+            remaining = deadline - time.monotonic()
+            if remaining <= 0 or not select.select([self.fd], [], [], remaining)[0]:
+                raise Error("timed out after %d of %d bytes" % (len(data), count))
+            data += os.read(self.fd, count - len(data))
+        return data
+
+    def read_quiet(self, quiet=0.05):
+        """Read until the line has been quiet for a while, for unframed answers."""
+        data = b""
+        deadline = time.monotonic() + self.timeout
+        while time.monotonic() < deadline:
+            if not select.select([self.fd], [], [], quiet)[0]:
+                if data:
+                    break
+                continue
+            data += os.read(self.fd, 256)
+        return data
+
+    def plain(self, command):
+        self.write(command)
+        return self.read_quiet()
+
+    def request(self, payload):
+        """Send a framed request, return the status code and the response data."""
+        self.write(struct.pack(">H", len(payload)) + payload + struct.pack(">I", zlib.crc32(payload)))
+        size = struct.unpack(">H", self.read(2))[0]
+        if size == 0:
+            raise Error("empty response frame")
+        body = self.read(size + 4)
+        if zlib.crc32(body[:size]) != struct.unpack(">I", body[size:])[0]:
+            raise Error("response CRC mismatch")
+        return body[0], body[1:size]
+
+    def raw_frame(self, frame):
+        """Send bytes as they are and read one response frame."""
+        self.write(frame)
+        size = struct.unpack(">H", self.read(2))[0]
+        body = self.read(size + 4)
+        return body[0], body[1:size]
+
+
+class Checks:
+    def __init__(self, verbose):
+        self.verbose = verbose
+        self.passed = 0
+        self.failed = 0
+
+    def check(self, name, ok, detail=""):
+        if ok:
+            self.passed += 1
+            if self.verbose:
+                print("PASS %s" % name)
+        else:
+            self.failed += 1
+            print("FAIL %s%s" % (name, ": " + detail if detail else ""))
+        return ok
+
+    def run(self, name, function, *args):
+        try:
+            return function(*args)
+        except (Error, IndexError, struct.error) as error:
+            self.check(name, False, str(error) or type(error).__name__)
+            return None
+
+
+class Protocol:
+    """Response codes and the commands the INI does not describe, from ts_protocol.h."""
+
+    def __init__(self, include):
+        with open(os.path.join(include, "ts_protocol.h")) as f:
+            text = f.read()
+        for name in ("OK", "BURN_OK", "UNDERRUN", "CRC_FAILURE", "UNRECOGNIZED", "OUT_OF_RANGE", "BURN_FAILED"):
+            setattr(self, name.lower(), parse_define(text, "TS_RESPONSE_" + name))
+        self.hello = parse_define(text, "TS_CMD_HELLO")
+        self.protocol = parse_define(text, "TS_CMD_PROTOCOL")
+        self.version = parse_define(text, "TS_VERSION_STRING").encode()
+        self.protocol_version = parse_define(text, "TS_PROTOCOL_VERSION").encode()
+        self.logger_control = parse_define(text, "TS_CMD_LOGGER_CONTROL")
+        self.logger_read = parse_define(text, "TS_CMD_LOGGER_READ")
+        self.max_payload = parse_define(text, "TS_MAX_PAYLOAD")
+
+
+def read_page(link, ini, page):
+    """Read a whole page in blocking factor pieces, as TunerStudio does."""
+    data = b""
+    size = ini.page_sizes[page]
+    while len(data) < size:
+        count = min(ini.blocking_factor, size - len(data))
+        status, chunk = link.request(ini.command("pageReadCommand", page, len(data), count))
+        if status != 0 or len(chunk) != count:
+            raise Error("page %d read at %d: status 0x%02X, %d bytes" % (page, len(data), status, len(chunk)))
+        data += chunk
+    return data
+
+
+def check_fields(checks, ini, page, data, when):
+    for field in ini.page_fields(page):
+        value = field.value(data)
+        checks.check("page %d %s %s within limits" % (page, field.name, when),
+                     field.min <= value <= field.max, "%g not in %g..%g" % (value, field.min, field.max))
+
+
+def pick_change(field, data):
+    """A valid value for the field that differs from the current one."""
+    return field.min if field.value(data) != field.min else field.max
+
+
+def pick_out_of_range(field):
+    """A value the field type can hold but its limits do not allow, None if there is none."""
+    if field.max < field.type_max * field.scale + field.translate:
+        return field.max + field.scale
+    if field.min > field.type_min * field.scale + field.translate:
+        return field.min - field.scale
+    return None
+
+
+def write_field(link, ini, page, field, value):
+    encoded = field.encode_value(value)
+    return link.request(ini.command("pageChunkWrite", page, field.offset, len(encoded), encoded))
+
+
+def check_probes(checks, link, ini, proto):
+    checks.check("plain query returns the INI signature", link.plain(unquote(ini.settings["queryCommand"])) == ini.signature)
+    checks.check("plain version", link.plain(bytes([proto.hello])) == proto.version)
+    checks.check("plain protocol version", link.plain(bytes([proto.protocol])) == proto.protocol_version)
+
+    status, data = link.request(unquote(ini.settings["queryCommand"]))
+    checks.check("framed query returns the INI signature", status == proto.ok and data == ini.signature,
+                 "0x%02X %r" % (status, data))
+    status, data = link.request(bytes([proto.hello]))
+    checks.check("framed version", status == proto.ok and data == proto.version, "0x%02X %r" % (status, data))
+    status, data = link.request(bytes([proto.protocol]))
+    checks.check("framed protocol version", status == proto.ok and data == proto.protocol_version,
+                 "0x%02X %r" % (status, data))
+
+
+def check_errors(checks, link, ini, proto):
+    payload = unquote(ini.settings["queryCommand"])
+    frame = struct.pack(">H", len(payload)) + payload + struct.pack(">I", zlib.crc32(payload) ^ 1)
+    status, _ = link.raw_frame(frame)
+    checks.check("corrupted frame answered with CRC failure", status == proto.crc_failure, "0x%02X" % status)
+
+    status, _ = link.request(b"\x7f")
+    checks.check("unknown command answered as unrecognized", status == proto.unrecognized, "0x%02X" % status)
+
+    status, _ = link.request(ini.command("pageReadCommand", 0, ini.page_sizes[0], 1))
+    checks.check("read past the page refused", status == proto.out_of_range, "0x%02X" % status)
+
+    status, _ = link.request(ini.command("pageReadCommand", len(ini.page_sizes), 0, 1))
+    checks.check("read of a missing page refused", status == proto.out_of_range, "0x%02X" % status)
+
+    status, _ = link.request(ini.command("ochGetCommand", 0, 0, ini.och_block_size + 1))
+    checks.check("channel read past the block refused", status == proto.out_of_range, "0x%02X" % status)
+
+    status, _ = link.request(ini.command("pageReadCommand", 0, 0, 0)[:3])
+    checks.check("short page read answered as underrun", status == proto.underrun, "0x%02X" % status)
+
+
+def check_pages(checks, link, ini, proto, restore):
+    """Read, write and burn every page. Returns the burned pages."""
+    burned = []
+    for page, size in enumerate(ini.page_sizes):
+        data = read_page(link, ini, page)
+        checks.check("page %d size matches the INI" % page, len(data) == size, "%d bytes" % len(data))
+        check_fields(checks, ini, page, data, "as read")
+
+        status, crc = link.request(ini.command("crc32CheckCommand", page, 0, size))
+        checks.check("page %d CRC matches the data read" % page,
+                     status == proto.ok and crc == struct.pack(">I", zlib.crc32(data)), "0x%02X %s" % (status, crc.hex()))
+
+        fields = [field for field in ini.page_fields(page) if field.min < field.max]
+        for field in fields:
+            status, _ = write_field(link, ini, page, field, pick_change(field, data))
+            checks.check("page %d %s written" % (page, field.name), status == proto.ok, "0x%02X" % status)
+
+        expected = bytearray(data)
+        for field in fields:
+            encoded = field.encode_value(pick_change(field, data))
+            expected[field.offset:field.offset + len(encoded)] = encoded
+        written = read_page(link, ini, page)
+        checks.check("page %d reads back as written" % page, written == bytes(expected))
+
+        status, crc = link.request(ini.command("crc32CheckCommand", page, 0, size))
+        checks.check("page %d CRC follows the write" % page, crc == struct.pack(">I", zlib.crc32(written)))
+
+        status, _ = link.request(ini.command("burnCommand", page))
+        checks.check("page %d burned" % page, status == proto.burn_ok, "0x%02X" % status)
+
+        for field in fields:
+            value = pick_out_of_range(field)
+            if value is None:
+                continue
+            write_field(link, ini, page, field, value)
+            status, _ = link.request(ini.command("burnCommand", page))
+            checks.check("page %d burn with %s out of range refused" % (page, field.name),
+                         status == proto.burn_failed, "0x%02X" % status)
+            write_field(link, ini, page, field, field.value(written))
+            break
+
+        status, _ = link.request(ini.command("burnCommand", page))
+        checks.check("page %d burned after the refusal" % page, status == proto.burn_ok, "0x%02X" % status)
+        check_fields(checks, ini, page, read_page(link, ini, page), "after burning")
+
+        # A board keeps its own settings, the burned page is only checked on the simulator
+        if restore:
+            for offset in range(0, size, ini.blocking_factor):
+                chunk = data[offset:offset + ini.blocking_factor]
+                link.request(ini.command("pageChunkWrite", page, offset, len(chunk), chunk))
+            status, _ = link.request(ini.command("burnCommand", page))
+            checks.check("page %d restored" % page, status == proto.burn_ok, "0x%02X" % status)
+            written = data
+        burned.append(written)
+    return burned
+
+
+def read_channels(link, ini):
+    status, data = link.request(ini.command("ochGetCommand", 0, 0, ini.och_block_size))
+    if status != 0 or len(data) != ini.och_block_size:
+        raise Error("channel read: status 0x%02X, %d bytes" % (status, len(data)))
+    return data
+
+
+def check_channels(checks, link, ini, proto):
+    first = read_channels(link, ini)
+    checks.check("channel block size matches the INI", len(first) == ini.och_block_size)
+    end = max(channel.offset + channel.size for channel in ini.channels)
+    checks.check("INI channels fit the block", end <= ini.och_block_size, "last ends at %d" % end)
+
+    uptime = next((channel for channel in ini.channels if channel.name == "uptime"), None)
+    if uptime is not None:
+        time.sleep(0.1)
+        second = read_channels(link, ini)
+        delta = uptime.value(second) - uptime.value(first)
+        checks.check("uptime advances with time", 50 <= delta <= 1000, "%g ms in 100 ms" % delta)
+
+    channel = ini.channels[-1]
+    status, data = link.request(ini.command("ochGetCommand", 0, channel.offset, channel.size))
+    checks.check("single channel read", status == proto.ok and len(data) == channel.size, "0x%02X" % status)
+
+
+def read_varint(data, offset):
+    value = shift = 0
+    while True:
+        byte = data[offset]
+        offset += 1
+        value |= (byte & 0x7F) << shift
+        shift += 7
+        if not byte & 0x80:
+            return value, offset
+
+
+def check_logger(checks, link, proto, expect_records):
+    status, _ = link.request(bytes([proto.logger_control, 1, 0xFF]) + struct.pack("<II", 0, 0x7FF))
+    if not checks.check("data logger started", status == proto.ok, "0x%02X" % status):
+        return
+    time.sleep(0.2)
+
+    records = []
+    for _ in range(64):
+        status, block = link.request(bytes([proto.logger_read]))
+        if status != proto.ok or len(block) < 12:
+            checks.check("data logger block read", False, "0x%02X, %d bytes" % (status, len(block)))
+            break
+        count, stamp, _, pending = struct.unpack_from("<HIIH", block)
+        offset = 12
+        for _ in range(count):
+            delta, offset = read_varint(block, offset)
+            stamp += delta
+            kind = block[offset]
+            ident, offset = read_varint(block, offset + 1)
+            records.append((stamp, kind >> 4, ident, block[offset:offset + (kind & 0x0F)]))
+            offset += kind & 0x0F
+        if offset != len(block):
+            checks.check("data logger block decodes to its length", False, "%d of %d bytes" % (offset, len(block)))
+            break
+        if count == 0 or pending == 0:
+            break
+
+    link.request(bytes([proto.logger_control, 0]))
+    if expect_records:
+        checks.check("data logger captured records", len(records) > 0)
+    stamps = [record[0] for record in records]
+    checks.check("data logger timestamps in order", all(a <= b for a, b in zip(stamps, stamps[1:])))
+
+
+def measure(link, ini, duration, baud):
+    """Round-trip latency of channel reads, then the sustained poll rate."""
+    request = ini.command("ochGetCommand", 0, 0, ini.och_block_size)
+    times = []
+    for _ in range(200):
+        start = time.perf_counter()
+        link.request(request)
+        times.append(time.perf_counter() - start)
+    times.sort()
+
+    polls = 0
+    start = time.perf_counter()
+    while time.perf_counter() - start < duration:
+        link.request(request)
+        polls += 1
+    rate = polls / (time.perf_counter() - start)
+
+    wire = (len(request) + 6) + (ini.och_block_size + 1 + 6)
+    print("latency ms: min %.3f, median %.3f, p99 %.3f, max %.3f" %
+          (times[0] * 1e3, times[len(times) // 2] * 1e3, times[len(times) * 99 // 100] * 1e3, times[-1] * 1e3))
+    print("channel polls: %.0f/s, %.0f bytes/s; a %d baud line allows %.0f/s" %
+          (rate, rate * wire, baud, baud / 10.0 / wire))
+    return rate
+
+
+class Sim:
+    """ts_sim on a pseudo-terminal, with its store in a file."""
+
+    def __init__(self, path, store):
+        self.path = path
+        self.store = store
+        self.dir = tempfile.mkdtemp(prefix="ts_client")
+        self.port = os.path.join(self.dir, "tty")
+        self.process = None
+
+    def start(self):
+        self.process = subprocess.Popen([self.path, "-l", self.port, "-s", self.store])
+        deadline = time.monotonic() + 5
+        while not os.path.exists(self.port):
+            if time.monotonic() > deadline or self.process.poll() is not None:
+                raise SystemExit("ts_client: %s did not open its terminal" % self.path)
+            time.sleep(0.01)
+        return self.port
+
+    def stop(self):
+        if self.process is not None:
+            self.process.send_signal(signal.SIGTERM)
+            self.process.wait(timeout=5)
+            self.process = None
+
+    def close(self):
+        self.stop()
+        os.rmdir(self.dir)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[1])
+    target = parser.add_mutually_exclusive_group(required=True)
+    target.add_argument("--sim", help="ts_sim executable to start")
+    target.add_argument("--port", help="serial port of the board")
+    parser.add_argument("--ini", required=True, help="generated TunerStudio INI")
+    parser.add_argument("--include", default=os.path.join(os.path.dirname(__file__), "..", "inc"),
+                        help="firmware include directory")
+    parser.add_argument("--store", help="ts_sim store file, removed first (default: temporary)")
+    parser.add_argument("--baud", type=int, default=115200, help="serial baud rate (default: 115200)")
+    parser.add_argument("--duration", type=float, default=2.0, help="seconds of sustained polling (default: 2)")
+    parser.add_argument("--min-rate", type=float, default=50.0, help="lowest acceptable poll rate (default: 50/s)")
+    parser.add_argument("--timeout", type=float, default=1.0, help="response timeout in seconds (default: 1)")
+    parser.add_argument("-v", "--verbose", action="store_true", help="list passed checks too")
+    args = parser.parse_args()
+
+    ini = Ini(args.ini)
+    proto = Protocol(args.include)
+    checks = Checks(args.verbose)
+    sim = None
+
+    if args.sim:
+        store = args.store or os.path.join(tempfile.gettempdir(), "ts_client_%d.bin" % os.getpid())
+        if os.path.exists(store):
+            os.remove(store)
+        sim = Sim(args.sim, store)
+        port = sim.start()
+    else:
+        port = args.port
+
+    try:
+        link = Link(port, args.baud, args.timeout)
+        checks.run("probes", check_probes, checks, link, ini, proto)
+        checks.run("errors", check_errors, checks, link, ini, proto)
+        burned = checks.run("pages", check_pages, checks, link, ini, proto, sim is None)
+        checks.run("channels", check_channels, checks, link, ini, proto)
+        checks.run("logger", check_logger, checks, link, proto, sim is not None)
+        rate = checks.run("throughput", measure, link, ini, args.duration, args.baud)
+        if rate is not None:
+            checks.check("sustained poll rate at least %g/s" % args.min_rate, rate >= args.min_rate, "%.0f/s" % rate)
+        link.close()
+
+        if sim is not None and burned is not None:
+            time.sleep(0.2)     # Burned chunks are written in the background
+            sim.stop()
+            link = Link(sim.start(), args.baud, args.timeout)
+            for page, data in enumerate(burned):
+                restored = checks.run("restart", read_page, link, ini, page)
+                checks.check("page %d survives a restart" % page, restored == data)
+            link.close()
+    finally:
+        if sim is not None:
+            sim.close()
+            if not args.store and os.path.exists(sim.store):
+                os.remove(sim.store)
+
+    print("ts_client: %d checks passed, %d failed" % (checks.passed, checks.failed))
+    return 1 if checks.failed else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,520 @@
+/**
+ * @file ts_sim.c
+ * @brief Host TunerStudio link simulator for STM32F407 HID to Serial/CAN project
+ * @author Manus AI
+ * @date 2025-03-28
+ *
+ * Runs the unmodified TunerStudio module with USART2 on a pseudo-terminal,
+ * so TunerStudio or ts_client.py can connect to it like to the board. The
+ * tick follows the host clock. Burned pages go to a store kept in memory,
+ * and to a file with -s so they survive a restart. A synthetic axis sweep
+ * and an RPM frame feed the data logger while a capture runs.
+ *
+ * Usage: ts_sim [-l link] [-s store] [-n seconds]
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "tunerstudio.h"
+#include "config_store.h"
+#include "output_manager.h"
+#include "mapping_engine.h"
+#include "input_manager.h"
+#include "timer_wheel.h"
+#include "boot_monitor.h"
+#include "data_logger.h"
+#include "sim_hal.h"
+#include "sim_uart.h"
+#include <poll.h>
+#include <signal.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+/* Private define ------------------------------------------------------------*/
+#define SIM_STORE_RECORD_MAX      64
+#define SIM_STORE_RECORDS         64
+#define SIM_RPM_PERIOD_MS         10
+#define SIM_RPM_CAN_ID            0x360
+#define SIM_RPM_MAX               8000
+
+/* Private typedef -----------------------------------------------------------*/
+typedef struct {
+  uint16_t key;
+  uint16_t length;
+  uint8_t data[SIM_STORE_RECORD_MAX];
+} Ts_Sim_Record_t;
+
+/* Private variables ---------------------------------------------------------*/
+static volatile sig_atomic_t simStop = 0;
+static const char* simStorePath = NULL;
+static Ts_Sim_Record_t simStore[SIM_STORE_RECORDS];
+static uint16_t simStoreCount = 0;
+
+static Serial_Config_t simSerialConfig = {1, 115200, 8, 1, 0, SERIAL_FORMAT_RAW};
+static CAN_Config_t simCanConfig = {1, 500000, 0, 1, 6, 7};
+static uint8_t simProfile = 0;
+static uint32_t simEvents = 0;
+static uint32_t simLoopTime = 0;
+static uint32_t simLoopPeak = 0;
+
+/* Private function prototypes -----------------------------------------------*/
+static void Ts_Sim_Signal(int signal);
+static uint64_t Ts_Sim_Micros(void);
+static void Ts_Sim_Feed(uint32_t tick);
+static void Ts_Sim_LoadStore(void);
+static void Ts_Sim_SaveStore(void);
+
+/**
+  * @brief  Simulator entry point
+  * @param  argc: Argument count
+  * @param  argv: Arguments
+  * @retval int: 0 if successful, 1 if failed
+  */
+int main(int argc, char** argv)
+{
+  const char* link = NULL;
+  uint32_t seconds = 0;
+  uint64_t start;
+  uint32_t fed = 0;
+  int option;
+  
+  while ((option = getopt(argc, argv, "l:s:n:")) != -1) {
+    switch (option) {
+      case 'l':
+        link = optarg;
+        break;
+      
+      case 's':
+        simStorePath = optarg;
+        break;
+      
+      case 'n':
+        seconds = strtoul(optarg, NULL, 0);
+        break;
+      
+      default:
+        fprintf(stderr, "usage: %s [-l link] [-s store] [-n seconds]\n", argv[0]);
+        return 1;
+    }
+  }
+  
+  signal(SIGINT, Ts_Sim_Signal);
+  signal(SIGTERM, Ts_Sim_Signal);
+  
+  if (!Sim_Uart_Open(link)) {
+    fprintf(stderr, "ts_sim: cannot open a pseudo-terminal\n");
+    return 1;
+  }
+  
+  Ts_Sim_LoadStore();
+  Data_Logger_Init();
+  TS_Init();
+  
+  start = Ts_Sim_Micros();
+  
+  while (!simStop) {
+    struct pollfd pfd = {Sim_Uart_GetFd(), POLLIN, 0};
+    
+    /* Sleep until a request arrives, but keep the tick and the feed moving */
+    poll(&pfd, 1, 1);
+    
+    uint64_t now = Ts_Sim_Micros();
+    uint32_t tick = (uint32_t)((now - start) / 1000);
+    
+    if (seconds > 0 && tick >= seconds * 1000) {
+      break;
+    }
+    
+    Sim_Hal_Advance(tick - HAL_GetTick());
+    
+    for (; fed < tick; fed++) {
+      Ts_Sim_Feed(fed + 1);
+    }
+    
+    Sim_Uart_Poll();
+    TS_Process();
+    
+    simLoopTime = (uint32_t)(Ts_Sim_Micros() - now);
+    
+    if (simLoopTime > simLoopPeak) {
+      simLoopPeak = simLoopTime;
+    }
+  }
+  
+  Sim_Uart_Close();
+  
+  return 0;
+}
+
+/**
+  * @brief  Stop the main loop
+  * @param  signal: Signal number
+  * @retval None
+  */
+static void Ts_Sim_Signal(int signal)
+{
+  (void)signal;
+  
+  simStop = 1;
+}
+
+/**
+  * @brief  Host monotonic clock
+  * @param  None
+  * @retval uint64_t: Time in us
+  */
+static uint64_t Ts_Sim_Micros(void)
+{
+  struct timespec ts;
+  
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  
+  return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+/**
+  * @brief  Deliver the events of one millisecond to the data logger
+  * @note   The axis moves every millisecond, sweeping up and down over two
+  *         seconds. The RPM frame is recorded the way the CAN receive
+  *         interrupt records it.
+  * @param  tick: Simulated time in ms
+  * @retval None
+  */
+static void Ts_Sim_Feed(uint32_t tick)
+{
+  uint32_t phase = tick % 2000;
+  int16_t axis = (int16_t)((phase < 1000 ? phase : 2000 - phase) * 255 / 1000 - 127);
+  
+  Data_Logger_Record(DATA_LOGGER_SOURCE_INPUT, DATA_LOGGER_INPUT_ID(INPUT_EVENT_AXIS_CHANGE, 0, 0),
+                     (const uint8_t*)&axis, sizeof(axis));
+  simEvents++;
+  
+  if (tick % SIM_RPM_PERIOD_MS == 0) {
+    uint16_t rpm = (uint16_t)((axis + 127) * SIM_RPM_MAX / 254);
+    uint8_t data[8] = {(uint8_t)(rpm >> 8), (uint8_t)rpm, 0, 0, 0, 0, 0, 0};
+    
+    Data_Logger_Record(DATA_LOGGER_SOURCE_CAN_RX, SIM_RPM_CAN_ID, data, sizeof(data));
+  }
+}
+
+/**
+  * @brief  Load the store file, a missing file is an erased store
+  * @param  None
+  * @retval None
+  */
+static void Ts_Sim_LoadStore(void)
+{
+  FILE* file = simStorePath != NULL ? fopen(simStorePath, "rb") : NULL;
+  Ts_Sim_Record_t* record = &simStore[0];
+  
+  simStoreCount = 0;
+  
+  if (file == NULL) {
+    return;
+  }
+  
+  while (simStoreCount < SIM_STORE_RECORDS &&
+         fread(&record->key, sizeof(record->key), 1, file) == 1 &&
+         fread(&record->length, sizeof(record->length), 1, file) == 1 &&
+         record->length <= SIM_STORE_RECORD_MAX &&
+         fread(record->data, record->length, 1, file) == 1) {
+    record = &simStore[++simStoreCount];
+  }
+  
+  fclose(file);
+}
+
+/**
+  * @brief  Rewrite the store file with every current value
+  * @param  None
+  * @retval None
+  */
+static void Ts_Sim_SaveStore(void)
+{
+  FILE* file = simStorePath != NULL ? fopen(simStorePath, "wb") : NULL;
+  
+  if (file == NULL) {
+    return;
+  }
+  
+  for (uint16_t i = 0; i < simStoreCount; i++) {
+    fwrite(&simStore[i].key, sizeof(simStore[i].key), 1, file);
+    fwrite(&simStore[i].length, sizeof(simStore[i].length), 1, file);
+    fwrite(simStore[i].data, simStore[i].length, 1, file);
+  }
+  
+  fclose(file);
+}
+
+/* Firmware modules the TunerStudio module calls, not part of the simulation */
+
+/**
+  * @brief  Configuration store stub, values are kept in memory
+  * @param  key: Record key
+  * @param  data: Buffer for the value
+  * @param  length: Expected length, the read fails if the stored length differs
+  * @retval uint8_t: 1 if successful, 0 if not found or length mismatch
+  */
+uint8_t Config_Store_Read(uint16_t key, void* data, uint16_t length)
+{
+  for (uint16_t i = 0; i < simStoreCount; i++) {
+    if (simStore[i].key == key) {
+      if (simStore[i].length != length) {
+        return 0;
+      }
+      
+      memcpy(data, simStore[i].data, length);
+      return 1;
+    }
+  }
+  
+  return 0;
+}
+
+/**
+  * @brief  Configuration store stub, values are kept in memory and saved
+  * @param  key: Record key
+  * @param  data: Value
+  * @param  length: Value length, at most SIM_STORE_RECORD_MAX bytes
+  * @retval uint8_t: 1 if successful, 0 if failed
+  */
+uint8_t Config_Store_Write(uint16_t key, const void* data, uint16_t length)
+{
+  uint16_t i;
+  
+  if (data == NULL || length == 0 || length > SIM_STORE_RECORD_MAX) {
+    return 0;
+  }
+  
+  for (i = 0; i < simStoreCount && simStore[i].key != key; i++) {
+  }
+  
+  if (i == SIM_STORE_RECORDS) {
+    return 0;
+  }
+  
+  if (i == simStoreCount) {
+    simStoreCount++;
+  }
+  
+  simStore[i].key = key;
+  simStore[i].length = length;
+  memcpy(simStore[i].data, data, length);
+  
+  Ts_Sim_SaveStore();
+  
+  return 1;
+}
+
+/**
+  * @brief  Configuration store stub, the spare sector is always erased
+  * @param  stats: Pointer to structure receiving the statistics
+  * @retval None
+  */
+void Config_Store_GetStats(Config_Store_Stats_t* stats)
+{
+  memset(stats, 0, sizeof(*stats));
+  stats->freeBytes = CONFIG_STORE_SECTOR_SIZE;
+  stats->keyCount = simStoreCount;
+}
+
+/**
+  * @brief  Serial output stub
+  * @param  None
+  * @retval Serial_Config_t*: Pointer to configuration structure
+  */
+Serial_Config_t* Output_Manager_GetSerialConfig(void)
+{
+  return &simSerialConfig;
+}
+
+/**
+  * @brief  Serial output stub, the new settings are printed to stderr
+  * @param  config: Pointer to configuration structure
+  * @retval uint8_t: 1
+  */
+uint8_t Output_Manager_ConfigureSerial(Serial_Config_t* config)
+{
+  simSerialConfig = *config;
+  fprintf(stderr, "ts_sim: serial output %s, %u baud\n", config->enabled ? "on" : "off", config->baudRate);
+  
+  return 1;
+}
+
+/**
+  * @brief  CAN output stub
+  * @param  None
+  * @retval CAN_Config_t*: Pointer to configuration structure
+  */
+CAN_Config_t* Output_Manager_GetCANConfig(void)
+{
+  return &simCanConfig;
+}
+
+/**
+  * @brief  CAN output stub, the new settings are printed to stderr
+  * @param  config: Pointer to configuration structure
+  * @retval uint8_t: 1
+  */
+uint8_t Output_Manager_ConfigureCAN(CAN_Config_t* config)
+{
+  simCanConfig = *config;
+  fprintf(stderr, "ts_sim: CAN output %s, %u bps\n", config->enabled ? "on" : "off", config->bitRate);
+  
+  return 1;
+}
+
+/**
+  * @brief  CAN output stub, frames are dropped
+  * @param  canId: CAN identifier
+  * @param  data: Frame data
+  * @param  length: Data length
+  * @retval uint8_t: 1
+  */
+uint8_t Output_Manager_SendCAN(uint32_t canId, uint8_t* data, uint8_t length)
+{
+  (void)canId;
+  (void)data;
+  (void)length;
+  
+  return 1;
+}
+
+/**
+  * @brief  CAN receive stub, no frames arrive
+  * @param  callback: Receive callback
+  * @retval uint8_t: 1
+  */
+uint8_t Output_Manager_RegisterCANRxCallback(CAN_Rx_Callback_t callback)
+{
+  (void)callback;
+  
+  return 1;
+}
+
+/**
+  * @brief  Output statistics stub, nothing is sent
+  * @param  stats: Pointer to structure receiving the statistics
+  * @retval None
+  */
+void Output_Manager_GetStats(Output_Manager_Stats_t* stats)
+{
+  memset(stats, 0, sizeof(*stats));
+}
+
+/**
+  * @brief  Mapping engine stub
+  * @param  profileIndex: Profile to activate
+  * @retval None
+  */
+void Mapping_Engine_SelectProfile(uint8_t profileIndex)
+{
+  simProfile = profileIndex;
+}
+
+/**
+  * @brief  Mapping engine stub
+  * @param  None
+  * @retval uint8_t: Active profile
+  */
+uint8_t Mapping_Engine_GetActiveProfile(void)
+{
+  return simProfile;
+}
+
+/**
+  * @brief  Mapping engine stub, no mappings
+  * @param  None
+  * @retval uint8_t: 0
+  */
+uint8_t Mapping_Engine_GetMappingCount(void)
+{
+  return 0;
+}
+
+/**
+  * @brief  Mapping engine stub, the synthetic axis events count as dispatched
+  * @param  stats: Pointer to structure receiving the statistics
+  * @retval None
+  */
+void Mapping_Engine_GetStats(Mapping_Engine_Stats_t* stats)
+{
+  memset(stats, 0, sizeof(*stats));
+  stats->events = simEvents;
+}
+
+/**
+  * @brief  Mapping engine stub, no latency recorded
+  * @param  percent: Percentile
+  * @retval uint32_t: 0
+  */
+uint32_t Mapping_Engine_GetLatencyPercentile(uint8_t percent)
+{
+  (void)percent;
+  
+  return 0;
+}
+
+/**
+  * @brief  Input manager stub, the synthetic axis device
+  * @param  None
+  * @retval uint8_t: 1
+  */
+uint8_t Input_Manager_GetDeviceCount(void)
+{
+  return 1;
+}
+
+/**
+  * @brief  Input manager stub, events are never queued
+  * @param  None
+  * @retval uint8_t: 0
+  */
+uint8_t Input_Manager_GetEventCount(void)
+{
+  return 0;
+}
+
+/**
+  * @brief  Timer wheel stub
+  * @param  None
+  * @retval uint32_t: 0
+  */
+uint32_t Timer_Wheel_GetActiveCount(void)
+{
+  return 0;
+}
+
+/**
+  * @brief  Boot monitor stub, host clock
+  * @param  None
+  * @retval uint32_t: Time in us
+  */
+uint32_t Boot_Monitor_GetMicros(void)
+{
+  return (uint32_t)Ts_Sim_Micros();
+}
+
+/**
+  * @brief  Boot monitor stub, time spent in the last loop pass
+  * @param  None
+  * @retval uint32_t: Loop time in us
+  */
+uint32_t Boot_Monitor_GetLoopTime(void)
+{
+  return simLoopTime;
+}
+
+/**
+  * @brief  Boot monitor stub, longest loop pass since the last call
+  * @param  None
+  * @retval uint32_t: Peak loop time in us
+  */
+uint32_t Boot_Monitor_TakeLoopPeak(void)
+{
+  uint32_t peak = simLoopPeak;
+  
+  simLoopPeak = 0;
+  
+  return peak;
+}
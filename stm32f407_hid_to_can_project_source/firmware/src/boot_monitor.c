@@ -0,0 +1,170 @@
+/**
+ * @file boot_monitor.c
+ * @brief Boot phase timing implementation for STM32F407 HID to Serial/CAN project
+ * @author Manus AI
+ * @date 2025-03-28
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "boot_monitor.h"
+#include "main.h"
+#include "output_manager.h"
+#include <stdint.h>
+#include <string.h>
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private define ------------------------------------------------------------*/
+/* Private macro -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+/* Time of each phase in microseconds since HAL_Init, first mark wins */
+static uint32_t bootTimes[BOOT_PHASE_COUNT];
+static uint32_t bootReported = 0;   /* Bit per phase already sent on CAN */
+
+/* Main loop pass time, measured between Boot_Monitor_Process calls */
+static uint32_t loopLastMicros = BOOT_MONITOR_TIME_NONE;
+static uint32_t loopTime = 0;
+static uint32_t loopPeak = 0;
+
+/* Private function prototypes -----------------------------------------------*/
+
+/**
+  * @brief  Boot monitor initialization function
+  * @note   Call right after HAL_Init, it marks BOOT_PHASE_MAIN.
+  * @param  None
+  * @retval None
+  */
+void Boot_Monitor_Init(void)
+{
+  for (uint8_t i = 0; i < BOOT_PHASE_COUNT; i++) {
+    bootTimes[i] = BOOT_MONITOR_TIME_NONE;
+  }
+  
+  bootReported = 0;
+  loopLastMicros = BOOT_MONITOR_TIME_NONE;
+  loopTime = 0;
+  loopPeak = 0;
+  
+  Boot_Monitor_Mark(BOOT_PHASE_MAIN);
+}
+
+/**
+  * @brief  Boot monitor process function, call once per main loop pass
+  * @note   Sends one report frame per phase once it has been reached. A frame
+  *         the CAN queue cannot take is retried on the next call. The time
+  *         since the previous call is the loop time.
+  * @param  None
+  * @retval None
+  */
+void Boot_Monitor_Process(void)
+{
+  uint8_t frame[5];
+  uint32_t now = Boot_Monitor_GetMicros();
+  
+  if (loopLastMicros != BOOT_MONITOR_TIME_NONE) {
+    loopTime = now - loopLastMicros;
+    
+    if (loopTime > loopPeak) {
+      loopPeak = loopTime;
+    }
+  }
+  
+  loopLastMicros = now;
+  
+  for (uint8_t i = 0; i < BOOT_PHASE_COUNT; i++) {
+    if (bootTimes[i] == BOOT_MONITOR_TIME_NONE || (bootReported & (1UL << i))) {
+      continue;
+    }
+    
+    frame[0] = i;
+    frame[1] = bootTimes[i] & 0xFF;
+    frame[2] = (bootTimes[i] >> 8) & 0xFF;
+    frame[3] = (bootTimes[i] >> 16) & 0xFF;
+    frame[4] = (bootTimes[i] >> 24) & 0xFF;
+    
+    if (!Output_Manager_SendCAN(BOOT_MONITOR_CAN_ID, frame, sizeof(frame))) {
+      return;
+    }
+    
+    bootReported |= 1UL << i;
+  }
+}
+
+/**
+  * @brief  Record the time a boot phase was reached
+  * @param  phase: Boot phase, later marks of the same phase are ignored
+  * @retval None
+  */
+void Boot_Monitor_Mark(Boot_Phase_t phase)
+{
+  if (phase < BOOT_PHASE_COUNT && bootTimes[phase] == BOOT_MONITOR_TIME_NONE) {
+    bootTimes[phase] = Boot_Monitor_GetMicros();
+  }
+}
+
+/**
+  * @brief  Get the time a boot phase was reached
+  * @param  phase: Boot phase
+  * @retval uint32_t: Microseconds since HAL_Init, BOOT_MONITOR_TIME_NONE if not reached
+  */
+uint32_t Boot_Monitor_GetTime(Boot_Phase_t phase)
+{
+  if (phase >= BOOT_PHASE_COUNT) {
+    return BOOT_MONITOR_TIME_NONE;
+  }
+  
+  return bootTimes[phase];
+}
+
+/**
+  * @brief  Get the duration of the last main loop pass
+  * @param  None
+  * @retval uint32_t: Microseconds, 0 before the second pass
+  */
+uint32_t Boot_Monitor_GetLoopTime(void)
+{
+  return loopTime;
+}
+
+/**
+  * @brief  Get the longest main loop pass since the previous call
+  * @note   Restarts the peak, so each caller window sees its own worst case.
+  * @param  None
+  * @retval uint32_t: Microseconds
+  */
+uint32_t Boot_Monitor_TakeLoopPeak(void)
+{
+  uint32_t peak = loopPeak;
+  
+  loopPeak = loopTime;
+  
+  return peak;
+}
+
+/**
+  * @brief  Get the time since HAL_Init in microseconds
+  * @note   Combines the HAL tick with the SysTick down counter, so it stays
+  *         correct across the switch from HSI to the PLL.
+  * @param  None
+  * @retval uint32_t: Microseconds since HAL_Init
+  */
+uint32_t Boot_Monitor_GetMicros(void)
+{
+  uint32_t tick;
+  uint32_t count;
+  
+  /* Read again if the tick advanced while sampling the counter */
+  do {
+    tick = HAL_GetTick();
+    count = SysTick->VAL;
+  } while (tick != HAL_GetTick());
+  
+  uint32_t load = SysTick->LOAD + 1;
+  
+  /* Inside an interrupt that holds off SysTick the counter can wrap before
+     the tick is counted, a freshly reloaded counter then belongs to the next tick */
+  if ((SCB->ICSR & SCB_ICSR_PENDSTSET_Msk) && count > load / 2) {
+    tick++;
+  }
+  
+  return tick * 1000 + ((load - count) * 1000) / load;
+}
@@ -0,0 +1,553 @@
+/**
+ * @file config_store.c
+ * @brief Flash configuration store implementation for STM32F407 HID to Serial/CAN project
+ * @author Manus AI
+ * @date 2025-03-28
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "config_store.h"
+#include "crc32.h"
+#include "main.h"
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+/* Private typedef -----------------------------------------------------------*/
+/* Start of each sector, the magic word is programmed last so a sector that
+   was being compacted when power failed is never taken as valid. */
+typedef struct {
+  uint32_t generation;
+  uint32_t magic;
+} Config_Sector_Header_t;
+
+/* Record header, followed by the payload padded to a whole word */
+typedef struct {
+  uint16_t key;
+  uint16_t length;        /* Payload bytes, 0 marks the key as deleted */
+  uint32_t sequence;      /* Write order across the whole log */
+  uint32_t crc;           /* CRC-32 over key, length, sequence and payload */
+} Config_Record_Header_t;
+
+/* Private define ------------------------------------------------------------*/
+#define CONFIG_STORE_MAGIC        0x43464753  /* "SGFC" */
+#define CONFIG_STORE_ERASED       0xFFFFFFFF
+#define CONFIG_STORE_KEY_NONE     0xFFFF
+#define CONFIG_STORE_NOT_FOUND    0xFFFF
+#define CONFIG_STORE_FIRST_RECORD sizeof(Config_Sector_Header_t)
+
+/* Private macro -------------------------------------------------------------*/
+
+/* Private variables ---------------------------------------------------------*/
+static uint32_t activeAddr = CONFIG_STORE_SECTOR_A_ADDR;
+static uint32_t activeGeneration = 0;
+static uint32_t writeOffset = CONFIG_STORE_FIRST_RECORD;
+static uint32_t nextSequence = 1;
+static uint8_t spareErasePending = 0;
+static uint32_t spareEraseTick = 0;   /* When the erase became pending */
+
+/* Latest record of every live key, sorted by key */
+static uint16_t indexKeys[CONFIG_STORE_MAX_KEYS];
+static uint32_t indexOffsets[CONFIG_STORE_MAX_KEYS];
+static uint16_t indexCount = 0;
+
+/* Private function prototypes -----------------------------------------------*/
+static void Config_Store_Scan(void);
+static uint16_t Config_Store_Find(uint16_t key, uint16_t* position);
+static void Config_Store_IndexSet(uint16_t key, uint32_t offset);
+static void Config_Store_IndexRemove(uint16_t key);
+static uint8_t Config_Store_Append(uint16_t key, const void* data, uint16_t length);
+static uint8_t Config_Store_Program(uint32_t address, const Config_Record_Header_t* header, const uint8_t* payload);
+static uint32_t Config_Store_RecordCRC(const Config_Record_Header_t* header, const uint8_t* payload);
+static uint8_t Config_Store_FormatSector(uint32_t address, uint32_t generation);
+static uint8_t Config_Store_EraseSector(uint32_t address);
+static uint8_t Config_Store_IsErased(uint32_t address, uint32_t size);
+static uint32_t Config_Store_SpareAddr(void);
+
+_Static_assert(sizeof(Config_Record_Header_t) == CONFIG_STORE_RECORD_HEADER, "Record header size differs from CONFIG_STORE_RECORD_HEADER");
+
+/**
+  * @brief  Configuration store initialization function
+  * @note   Selects the active sector and builds the key index with a single
+  *         pass over its log. Must run before the modules load their config.
+  * @param  None
+  * @retval None
+  */
+void Config_Store_Init(void)
+{
+  const Config_Sector_Header_t* headerA = (const Config_Sector_Header_t*)CONFIG_STORE_SECTOR_A_ADDR;
+  const Config_Sector_Header_t* headerB = (const Config_Sector_Header_t*)CONFIG_STORE_SECTOR_B_ADDR;
+  uint8_t validA = (headerA->magic == CONFIG_STORE_MAGIC);
+  uint8_t validB = (headerB->magic == CONFIG_STORE_MAGIC);
+  
+  if (validA && (!validB || (int32_t)(headerA->generation - headerB->generation) > 0)) {
+    activeAddr = CONFIG_STORE_SECTOR_A_ADDR;
+    activeGeneration = headerA->generation;
+  } else if (validB) {
+    activeAddr = CONFIG_STORE_SECTOR_B_ADDR;
+    activeGeneration = headerB->generation;
+  } else {
+    /* First boot, start an empty log in sector A */
+    activeAddr = CONFIG_STORE_SECTOR_A_ADDR;
+    activeGeneration = 1;
+    
+    if (!Config_Store_IsErased(activeAddr, CONFIG_STORE_SECTOR_SIZE)) {
+      Config_Store_EraseSector(activeAddr);
+    }
+    Config_Store_FormatSector(activeAddr, activeGeneration);
+  }
+  
+  /* The spare holds an older log or an interrupted compaction */
+  spareErasePending = !Config_Store_IsErased(Config_Store_SpareAddr(), CONFIG_STORE_SECTOR_SIZE);
+  spareEraseTick = HAL_GetTick();
+  
+  Config_Store_Scan();
+}
+
+/**
+  * @brief  Configuration store process function, should be called periodically
+  * @note   Erases the spare sector after a compaction, or at boot when it
+  *         still holds an old log. The F407 has a single flash bank: for the
+  *         1-2 s of a 128 KB erase nothing runs from flash, interrupt
+  *         handlers included, so the caller decides when that goes
+  *         unnoticed. Until then writes keep appending to the active sector.
+  *         After CONFIG_STORE_ERASE_MAX_MS the erase runs anyway, so writes
+  *         held back for it are never put off for longer than that.
+  * @param  mayErase: 1 if the application can stall for an erase now
+  * @retval None
+  */
+void Config_Store_Process(uint8_t mayErase)
+{
+  if (spareErasePending && (mayErase || HAL_GetTick() - spareEraseTick >= CONFIG_STORE_ERASE_MAX_MS)) {
+    if (Config_Store_EraseSector(Config_Store_SpareAddr())) {
+      spareErasePending = 0;
+    }
+  }
+}
+
+/**
+  * @brief  Read the current value of a key
+  * @param  key: Record key
+  * @param  data: Buffer receiving the value
+  * @param  length: Expected length, the read fails if the stored length differs
+  * @retval uint8_t: 1 if successful, 0 if not found or length mismatch
+  */
+uint8_t Config_Store_Read(uint16_t key, void* data, uint16_t length)
+{
+  uint16_t position;
+  
+  if (data == NULL || Config_Store_Find(key, &position) == CONFIG_STORE_NOT_FOUND) {
+    return 0;
+  }
+  
+  const Config_Record_Header_t* header = (const Config_Record_Header_t*)(activeAddr + indexOffsets[position]);
+  
+  if (header->length != length) {
+    return 0;
+  }
+  
+  memcpy(data, (const uint8_t*)header + sizeof(Config_Record_Header_t), length);
+  
+  return 1;
+}
+
+/**
+  * @brief  Store a new value for a key
+  * @note   Nothing is written if the value is unchanged. Otherwise a record of
+  *         header plus payload is appended; the sector is only compacted
+  *         when the log is full.
+  * @param  key: Record key
+  * @param  data: Pointer to value
+  * @param  length: Value length, 1 to CONFIG_STORE_MAX_RECORD bytes
+  * @retval uint8_t: 1 if successful, 0 if failed
+  */
+uint8_t Config_Store_Write(uint16_t key, const void* data, uint16_t length)
+{
+  uint16_t position;
+  
+  if (data == NULL || key == CONFIG_STORE_KEY_NONE || length == 0 || length > CONFIG_STORE_MAX_RECORD) {
+    return 0;
+  }
+  
+  /* Skip the write if flash already holds this value */
+  if (Config_Store_Find(key, &position) != CONFIG_STORE_NOT_FOUND) {
+    const Config_Record_Header_t* header = (const Config_Record_Header_t*)(activeAddr + indexOffsets[position]);
+    
+    if (header->length == length &&
+        memcmp((const uint8_t*)header + sizeof(Config_Record_Header_t), data, length) == 0) {
+      return 1;
+    }
+  } else if (indexCount >= CONFIG_STORE_MAX_KEYS) {
+    return 0;
+  }
+  
+  return Config_Store_Append(key, data, length);
+}
+
+/**
+  * @brief  Delete a key
+  * @param  key: Record key
+  * @retval uint8_t: 1 if successful or not present, 0 if failed
+  */
+uint8_t Config_Store_Delete(uint16_t key)
+{
+  uint16_t position;
+  
+  if (Config_Store_Find(key, &position) == CONFIG_STORE_NOT_FOUND) {
+    return 1;
+  }
+  
+  return Config_Store_Append(key, NULL, 0);
+}
+
+/**
+  * @brief  Copy all live records into the spare sector and make it active
+  * @param  None
+  * @retval uint8_t: 1 if successful, 0 if failed
+  */
+uint8_t Config_Store_Compact(void)
+{
+  uint32_t target = Config_Store_SpareAddr();
+  uint32_t offset = CONFIG_STORE_FIRST_RECORD;
+  
+  /* Normally erased ahead of time by Config_Store_Process */
+  if (spareErasePending) {
+    if (!Config_Store_EraseSector(target)) {
+      return 0;
+    }
+    spareErasePending = 0;
+  }
+  
+  /* Records keep their sequence numbers and CRCs, only their position changes */
+  for (uint16_t i = 0; i < indexCount; i++) {
+    const Config_Record_Header_t* header = (const Config_Record_Header_t*)(activeAddr + indexOffsets[i]);
+    
+    if (!Config_Store_Program(target + offset, header, (const uint8_t*)header + sizeof(Config_Record_Header_t))) {
+      /* Stay on the old sector, its index is rebuilt from the log */
+      spareErasePending = 1;
+      spareEraseTick = HAL_GetTick();
+      Config_Store_Scan();
+      return 0;
+    }
+    
+    indexOffsets[i] = offset;
+    offset += CONFIG_STORE_RECORD_SIZE(header->length);
+  }
+  
+  if (!Config_Store_FormatSector(target, activeGeneration + 1)) {
+    spareErasePending = 1;
+    spareEraseTick = HAL_GetTick();
+    Config_Store_Scan();
+    return 0;
+  }
+  
+  activeAddr = target;
+  activeGeneration++;
+  writeOffset = offset;
+  
+  /* The old sector becomes the spare */
+  spareErasePending = 1;
+  spareEraseTick = HAL_GetTick();
+  
+  return 1;
+}
+
+/**
+  * @brief  Get store statistics
+  * @param  stats: Pointer to structure receiving the statistics
+  * @retval None
+  */
+void Config_Store_GetStats(Config_Store_Stats_t* stats)
+{
+  if (stats == NULL) {
+    return;
+  }
+  
+  stats->generation = activeGeneration;
+  stats->usedBytes = writeOffset;
+  stats->freeBytes = CONFIG_STORE_SECTOR_SIZE - writeOffset;
+  stats->liveBytes = CONFIG_STORE_FIRST_RECORD;
+  stats->keyCount = indexCount;
+  stats->erasePending = spareErasePending;
+  
+  for (uint16_t i = 0; i < indexCount; i++) {
+    const Config_Record_Header_t* header = (const Config_Record_Header_t*)(activeAddr + indexOffsets[i]);
+    stats->liveBytes += CONFIG_STORE_RECORD_SIZE(header->length);
+  }
+}
+
+/**
+  * @brief  Build the key index from the active sector log
+  * @param  None
+  * @retval None
+  */
+static void Config_Store_Scan(void)
+{
+  uint32_t offset = CONFIG_STORE_FIRST_RECORD;
+  
+  indexCount = 0;
+  nextSequence = 1;
+  
+  while (offset + sizeof(Config_Record_Header_t) <= CONFIG_STORE_SECTOR_SIZE) {
+    const Config_Record_Header_t* header = (const Config_Record_Header_t*)(activeAddr + offset);
+    const uint8_t* payload = (const uint8_t*)header + sizeof(Config_Record_Header_t);
+    
+    /* An erased header is the end of the log */
+    if (Config_Store_IsErased(activeAddr + offset, sizeof(Config_Record_Header_t))) {
+      break;
+    }
+    
+    /* A header cut short by a reset, nothing after it can be trusted */
+    if (header->key == CONFIG_STORE_KEY_NONE || header->length > CONFIG_STORE_MAX_RECORD ||
+        offset + CONFIG_STORE_RECORD_SIZE(header->length) > CONFIG_STORE_SECTOR_SIZE) {
+      offset = CONFIG_STORE_SECTOR_SIZE;
+      break;
+    }
+    
+    /* Records with a bad CRC were interrupted while writing the payload */
+    if (header->crc == Config_Store_RecordCRC(header, payload)) {
+      if (header->length == 0) {
+        Config_Store_IndexRemove(header->key);
+      } else {
+        Config_Store_IndexSet(header->key, offset);
+      }
+      
+      if ((int32_t)(header->sequence - nextSequence) >= 0) {
+        nextSequence = header->sequence + 1;
+      }
+    }
+    
+    offset += CONFIG_STORE_RECORD_SIZE(header->length);
+  }
+  
+  /* A full or damaged log is compacted by the next write */
+  writeOffset = offset;
+}
+
+/**
+  * @brief  Look up a key in the index
+  * @param  key: Record key
+  * @param  position: Receives the index position of the key, or where it would be inserted
+  * @retval uint16_t: Index position, CONFIG_STORE_NOT_FOUND if not present
+  */
+static uint16_t Config_Store_Find(uint16_t key, uint16_t* position)
+{
+  uint16_t low = 0;
+  uint16_t high = indexCount;
+  
+  while (low < high) {
+    uint16_t mid = (low + high) / 2;
+    
+    if (indexKeys[mid] < key) {
+      low = mid + 1;
+    } else {
+      high = mid;
+    }
+  }
+  
+  *position = low;
+  
+  return (low < indexCount && indexKeys[low] == key) ? low : CONFIG_STORE_NOT_FOUND;
+}
+
+/**
+  * @brief  Point the index entry of a key at a record, adding the key if needed
+  * @param  key: Record key
+  * @param  offset: Record offset within the active sector
+  * @retval None
+  */
+static void Config_Store_IndexSet(uint16_t key, uint32_t offset)
+{
+  uint16_t position;
+  
+  if (Config_Store_Find(key, &position) == CONFIG_STORE_NOT_FOUND) {
+    if (indexCount >= CONFIG_STORE_MAX_KEYS) {
+      return;
+    }
+    
+    memmove(&indexKeys[position + 1], &indexKeys[position], (indexCount - position) * sizeof(indexKeys[0]));
+    memmove(&indexOffsets[position + 1], &indexOffsets[position], (indexCount - position) * sizeof(indexOffsets[0]));
+    indexKeys[position] = key;
+    indexCount++;
+  }
+  
+  indexOffsets[position] = offset;
+}
+
+/**
+  * @brief  Remove a key from the index
+  * @param  key: Record key
+  * @retval None
+  */
+static void Config_Store_IndexRemove(uint16_t key)
+{
+  uint16_t position;
+  
+  if (Config_Store_Find(key, &position) == CONFIG_STORE_NOT_FOUND) {
+    return;
+  }
+  
+  indexCount--;
+  memmove(&indexKeys[position], &indexKeys[position + 1], (indexCount - position) * sizeof(indexKeys[0]));
+  memmove(&indexOffsets[position], &indexOffsets[position + 1], (indexCount - position) * sizeof(indexOffsets[0]));
+}
+
+/**
+  * @brief  Append a record to the log, compacting first if it does not fit
+  * @param  key: Record key
+  * @param  data: Pointer to payload, NULL for a delete record
+  * @param  length: Payload length, 0 for a delete record
+  * @retval uint8_t: 1 if successful, 0 if failed
+  */
+static uint8_t Config_Store_Append(uint16_t key, const void* data, uint16_t length)
+{
+  uint32_t size = CONFIG_STORE_RECORD_SIZE(length);
+  Config_Record_Header_t header;
+  
+  if (writeOffset + size > CONFIG_STORE_SECTOR_SIZE) {
+    if (!Config_Store_Compact() || writeOffset + size > CONFIG_STORE_SECTOR_SIZE) {
+      return 0;
+    }
+  }
+  
+  header.key = key;
+  header.length = length;
+  header.sequence = nextSequence++;
+  header.crc = Config_Store_RecordCRC(&header, (const uint8_t*)data);
+  
+  uint32_t offset = writeOffset;
+  
+  /* Never program over a failed write, move past it */
+  writeOffset += size;
+  
+  if (!Config_Store_Program(activeAddr + offset, &header, (const uint8_t*)data)) {
+    return 0;
+  }
+  
+  if (length == 0) {
+    Config_Store_IndexRemove(key);
+  } else {
+    Config_Store_IndexSet(key, offset);
+  }
+  
+  return 1;
+}
+
+/**
+  * @brief  Program a record into flash
+  * @param  address: Flash address, word aligned and erased
+  * @param  header: Pointer to record header
+  * @param  payload: Pointer to header->length bytes of payload
+  * @retval uint8_t: 1 if successful, 0 if failed
+  */
+static uint8_t Config_Store_Program(uint32_t address, const Config_Record_Header_t* header, const uint8_t* payload)
+{
+  const uint32_t* headerWords = (const uint32_t*)header;
+  uint8_t result = 1;
+  
+  HAL_FLASH_Unlock();
+  
+  /* Header first, the CRC covers a payload cut short by a reset */
+  for (uint8_t i = 0; i < sizeof(Config_Record_Header_t) / 4 && result; i++) {
+    result = (HAL_FLASH_Program(FLASH_TYPEPROGRAM_WORD, address, headerWords[i]) == HAL_OK);
+    address += 4;
+  }
+  
+  for (uint16_t i = 0; i < header->length && result; i += 4) {
+    uint32_t word = CONFIG_STORE_ERASED;
+    uint16_t count = (header->length - i < 4) ? (header->length - i) : 4;
+    
+    memcpy(&word, &payload[i], count);
+    result = (HAL_FLASH_Program(FLASH_TYPEPROGRAM_WORD, address, word) == HAL_OK);
+    address += 4;
+  }
+  
+  HAL_FLASH_Lock();
+  
+  return result;
+}
+
+/**
+  * @brief  Calculate the CRC of a record
+  * @param  header: Pointer to record header, the crc field is not included
+  * @param  payload: Pointer to header->length bytes of payload
+  * @retval uint32_t: CRC
+  */
+static uint32_t Config_Store_RecordCRC(const Config_Record_Header_t* header, const uint8_t* payload)
+{
+  uint32_t crc = CRC32_Calculate(header, offsetof(Config_Record_Header_t, crc));
+  
+  return CRC32_Update(crc, payload, header->length);
+}
+
+/**
+  * @brief  Write the header that marks an erased sector as a valid log
+  * @param  address: Sector address
+  * @param  generation: Generation number of the log
+  * @retval uint8_t: 1 if successful, 0 if failed
+  */
+static uint8_t Config_Store_FormatSector(uint32_t address, uint32_t generation)
+{
+  uint8_t result;
+  
+  HAL_FLASH_Unlock();
+  result = (HAL_FLASH_Program(FLASH_TYPEPROGRAM_WORD, address + offsetof(Config_Sector_Header_t, generation), generation) == HAL_OK);
+  if (result) {
+    result = (HAL_FLASH_Program(FLASH_TYPEPROGRAM_WORD, address + offsetof(Config_Sector_Header_t, magic), CONFIG_STORE_MAGIC) == HAL_OK);
+  }
+  HAL_FLASH_Lock();
+  
+  return result;
+}
+
+/**
+  * @brief  Erase one of the store sectors
+  * @param  address: Sector address
+  * @retval uint8_t: 1 if successful, 0 if failed
+  */
+static uint8_t Config_Store_EraseSector(uint32_t address)
+{
+  FLASH_EraseInitTypeDef eraseInit;
+  uint32_t sectorError = 0;
+  HAL_StatusTypeDef status;
+  
+  eraseInit.TypeErase = FLASH_TYPEERASE_SECTORS;
+  eraseInit.Sector = (address == CONFIG_STORE_SECTOR_A_ADDR) ? CONFIG_STORE_SECTOR_A : CONFIG_STORE_SECTOR_B;
+  eraseInit.NbSectors = 1;
+  eraseInit.VoltageRange = FLASH_VOLTAGE_RANGE_3;
+  
+  HAL_FLASH_Unlock();
+  status = HAL_FLASHEx_Erase(&eraseInit, &sectorError);
+  HAL_FLASH_Lock();
+  
+  return (status == HAL_OK) ? 1 : 0;
+}
+
+/**
+  * @brief  Check that a flash region is erased
+  * @param  address: Start address, word aligned
+  * @param  size: Size in bytes, multiple of 4
+  * @retval uint8_t: 1 if erased, 0 otherwise
+  */
+static uint8_t Config_Store_IsErased(uint32_t address, uint32_t size)
+{
+  const uint32_t* words = (const uint32_t*)address;
+  
+  for (uint32_t i = 0; i < size / 4; i++) {
+    if (words[i] != CONFIG_STORE_ERASED) {
+      return 0;
+    }
+  }
+  
+  return 1;
+}
+
+/**
+  * @brief  Get the address of the sector that is not active
+  * @param  None
+  * @retval uint32_t: Sector address
+  */
+static uint32_t Config_Store_SpareAddr(void)
+{
+  return (activeAddr == CONFIG_STORE_SECTOR_A_ADDR) ? CONFIG_STORE_SECTOR_B_ADDR : CONFIG_STORE_SECTOR_A_ADDR;
+}
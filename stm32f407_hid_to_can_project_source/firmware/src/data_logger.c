@@ -0,0 +1,272 @@
+/**
+ * @file data_logger.c
+ * @brief Event data logger implementation for STM32F407 HID to Serial/CAN project
+ * @author Manus AI
+ * @date 2025-03-28
+ *
+ * Captures input events, mapped outputs and received CAN frames into a RAM
+ * ring with microsecond timestamps, as they happen. Records are written from
+ * the main loop and from the CAN receive interrupt; each write runs with
+ * interrupts masked for a few dozen cycles, which also keeps timestamps in
+ * ring order. The main loop reads the ring out in blocks while capture goes
+ * on. A record that finds the ring full is dropped and counted as an overrun,
+ * so records already captured are never lost.
+ *
+ * Block format, all multi-byte fields little endian:
+ *
+ *   u16 records, u32 timestamp of the first record in us, u32 overruns since
+ *   the start, u16 records still pending after this block
+ *
+ * followed by the records:
+ *
+ *   varint  microseconds since the previous record, 0 for the first
+ *   u8      source << 4 | data length
+ *   varint  identifier
+ *   bytes   data
+ *
+ * Varints hold 7 bits per byte, least significant first, the top bit set on
+ * every byte but the last.
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "data_logger.h"
+#include "boot_monitor.h"
+#include <string.h>
+
+/* Private typedef -----------------------------------------------------------*/
+typedef struct {
+  uint32_t micros;
+  uint32_t id;
+  uint8_t source;
+  uint8_t length;
+  uint8_t data[8];
+} Data_Logger_Record_t;
+
+/* Private define ------------------------------------------------------------*/
+#define DATA_LOGGER_RING_MASK     (DATA_LOGGER_RING_SIZE - 1)
+
+/* Private variables ---------------------------------------------------------*/
+static Data_Logger_Record_t loggerRing[DATA_LOGGER_RING_SIZE];
+static volatile uint32_t loggerHead = 0;    /* Free running, advanced by writers */
+static volatile uint32_t loggerTail = 0;    /* Free running, advanced by the reader */
+static volatile uint32_t loggerRecords = 0;
+static volatile uint32_t loggerOverruns = 0;
+static volatile uint8_t loggerRunning = 0;
+static Data_Logger_Config_t loggerConfig;
+
+/* Private function prototypes -----------------------------------------------*/
+static uint8_t Data_Logger_PutVarint(uint8_t* buffer, uint32_t value);
+static void Data_Logger_PutU16(uint8_t* buffer, uint16_t value);
+static void Data_Logger_PutU32(uint8_t* buffer, uint32_t value);
+
+/**
+  * @brief  Data logger initialization function
+  * @note   The logger starts stopped, call before the receive interrupts are enabled.
+  * @param  None
+  * @retval None
+  */
+void Data_Logger_Init(void)
+{
+  loggerRunning = 0;
+  loggerHead = 0;
+  loggerTail = 0;
+  loggerRecords = 0;
+  loggerOverruns = 0;
+  memset(&loggerConfig, 0, sizeof(loggerConfig));
+}
+
+/**
+  * @brief  Start capturing, records left from an earlier capture are dropped
+  * @param  config: Sources and CAN IDs to capture
+  * @retval None
+  */
+void Data_Logger_Start(const Data_Logger_Config_t* config)
+{
+  if (config == NULL) {
+    return;
+  }
+  
+  __disable_irq();
+  
+  loggerConfig = *config;
+  loggerHead = 0;
+  loggerTail = 0;
+  loggerRecords = 0;
+  loggerOverruns = 0;
+  loggerRunning = 1;
+  
+  __enable_irq();
+}
+
+/**
+  * @brief  Stop capturing, captured records can still be read
+  * @param  None
+  * @retval None
+  */
+void Data_Logger_Stop(void)
+{
+  loggerRunning = 0;
+}
+
+/**
+  * @brief  Capture a record if its source is selected
+  * @note   Safe from the main loop and from interrupts.
+  * @param  source: Record source
+  * @param  id: Identifier, see DATA_LOGGER_INPUT_ID and DATA_LOGGER_OUTPUT_ID; the CAN ID for frames
+  * @param  data: Record data
+  * @param  length: Data length, at most 8 bytes
+  * @retval None
+  */
+void Data_Logger_Record(Data_Logger_Source_t source, uint32_t id, const uint8_t* data, uint8_t length)
+{
+  if (!loggerRunning || !(loggerConfig.sourceMask & DATA_LOGGER_SOURCE_BIT(source))) {
+    return;
+  }
+  
+  if (source == DATA_LOGGER_SOURCE_CAN_RX && (id < loggerConfig.canIdFirst || id > loggerConfig.canIdLast)) {
+    return;
+  }
+  
+  if (length > sizeof(loggerRing[0].data)) {
+    length = sizeof(loggerRing[0].data);
+  }
+  
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+  
+  uint32_t head = loggerHead;
+  
+  if (head - loggerTail >= DATA_LOGGER_RING_SIZE) {
+    loggerOverruns++;
+  } else {
+    Data_Logger_Record_t* record = &loggerRing[head & DATA_LOGGER_RING_MASK];
+    
+    /* Taken with interrupts masked, so timestamps never go back along the ring */
+    record->micros = Boot_Monitor_GetMicros();
+    record->id = id;
+    record->source = source;
+    record->length = length;
+    memcpy(record->data, data, length);
+    
+    loggerHead = head + 1;
+    loggerRecords++;
+  }
+  
+  __set_PRIMASK(primask);
+}
+
+/**
+  * @brief  Encode the oldest records into a block and release them
+  * @note   Main loop only. A block with no records still carries the
+  *         overrun count.
+  * @param  buffer: Block buffer
+  * @param  size: Buffer size, at least DATA_LOGGER_BLOCK_HEADER
+  * @retval uint16_t: Block length, 0 if the buffer is too small
+  */
+uint16_t Data_Logger_ReadBlock(uint8_t* buffer, uint16_t size)
+{
+  uint32_t head = loggerHead;
+  uint32_t tail = loggerTail;
+  uint32_t first = 0;
+  uint32_t previous = 0;
+  uint16_t count = 0;
+  uint16_t length = DATA_LOGGER_BLOCK_HEADER;
+  
+  if (buffer == NULL || size < DATA_LOGGER_BLOCK_HEADER) {
+    return 0;
+  }
+  
+  while (tail != head && size - length >= DATA_LOGGER_RECORD_MAX) {
+    const Data_Logger_Record_t* record = &loggerRing[tail & DATA_LOGGER_RING_MASK];
+    
+    if (count == 0) {
+      first = record->micros;
+      previous = first;
+    }
+    
+    length += Data_Logger_PutVarint(&buffer[length], record->micros - previous);
+    buffer[length++] = (record->source << 4) | record->length;
+    length += Data_Logger_PutVarint(&buffer[length], record->id);
+    memcpy(&buffer[length], record->data, record->length);
+    length += record->length;
+    
+    previous = record->micros;
+    tail++;
+    count++;
+  }
+  
+  /* The slots are handed back only after they have been copied */
+  __DMB();
+  loggerTail = tail;
+  
+  uint32_t pending = loggerHead - tail;
+  
+  Data_Logger_PutU16(&buffer[0], count);
+  Data_Logger_PutU32(&buffer[2], first);
+  Data_Logger_PutU32(&buffer[6], loggerOverruns);
+  Data_Logger_PutU16(&buffer[10], pending > 0xFFFF ? 0xFFFF : (uint16_t)pending);
+  
+  return length;
+}
+
+/**
+  * @brief  Get capture counters
+  * @param  stats: Pointer to structure receiving the statistics
+  * @retval None
+  */
+void Data_Logger_GetStats(Data_Logger_Stats_t* stats)
+{
+  if (stats == NULL) {
+    return;
+  }
+  
+  stats->records = loggerRecords;
+  stats->overruns = loggerOverruns;
+  stats->pending = (uint16_t)(loggerHead - loggerTail);
+  stats->running = loggerRunning;
+}
+
+/**
+  * @brief  Write a varint
+  * @param  buffer: Destination, room for 5 bytes
+  * @param  value: Value
+  * @retval uint8_t: Bytes written
+  */
+static uint8_t Data_Logger_PutVarint(uint8_t* buffer, uint32_t value)
+{
+  uint8_t length = 0;
+  
+  while (value >= 0x80) {
+    buffer[length++] = (uint8_t)value | 0x80;
+    value >>= 7;
+  }
+  
+  buffer[length++] = (uint8_t)value;
+  
+  return length;
+}
+
+/**
+  * @brief  Write a 16-bit value, little endian
+  * @param  buffer: Destination
+  * @param  value: Value
+  * @retval None
+  */
+static void Data_Logger_PutU16(uint8_t* buffer, uint16_t value)
+{
+  buffer[0] = (uint8_t)value;
+  buffer[1] = (uint8_t)(value >> 8);
+}
+
+/**
+  * @brief  Write a 32-bit value, little endian
+  * @param  buffer: Destination
+  * @param  value: Value
+  * @retval None
+  */
+static void Data_Logger_PutU32(uint8_t* buffer, uint32_t value)
+{
+  for (uint8_t i = 0; i < 4; i++) {
+    buffer[i] = (uint8_t)(value >> (8 * i));
+  }
+}
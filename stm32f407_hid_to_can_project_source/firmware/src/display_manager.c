@@ -8,6 +8,12 @@
 /* Includes ------------------------------------------------------------------*/
 #include "display_manager.h"
 #include "main.h"
+#include "config_store.h"
+#include "timer_wheel.h"
+#include "boot_monitor.h"
+#include "output_manager.h"
+#include "rx_cache.h"
+#include "font.h"
 #include <stdint.h>
 #include <string.h>
 #include <stdio.h>
@@ -18,9 +24,34 @@
 #include <stdlib.h>
 
 /* Private typedef -----------------------------------------------------------*/
+/* GC9A01 power-up sequence, one step per timer wheel expiry */
+typedef enum {
+  DISPLAY_INIT_RESET = 0,
+  DISPLAY_INIT_RELEASE,
+  DISPLAY_INIT_SWRESET,
+  DISPLAY_INIT_SLPOUT,
+  DISPLAY_INIT_CONFIGURE,
+  DISPLAY_INIT_CLEAR,
+  DISPLAY_INIT_DONE
+} Display_Init_State_t;
+
+/* Screen area, end coordinates exclusive */
+typedef struct {
+  uint16_t x0;
+  uint16_t y0;
+  uint16_t x1;
+  uint16_t y1;
+} Display_Rect_t;
+
+/* What was last drawn for an item, kept apart from the stored item configuration */
+typedef struct {
+  uint32_t value;
+  uint32_t deadline;      /* HAL tick of the next value check */
+  uint8_t drawn;
+  uint8_t scheduled;      /* Item has an entry in the deadline heap */
+} Display_Item_State_t;
+
 /* Private define ------------------------------------------------------------*/
-#define DISPLAY_CONFIG_ADDR       0x08080000  /* Flash sector for configuration storage */
-#define DISPLAY_CONFIG_SIZE       (sizeof(Display_Item_t) * MAX_DISPLAY_ITEMS + 8)
 
 /* GC9A01 Commands */
 #define GC9A01_SWRESET            0x01
@@ -36,6 +67,29 @@
 #define GC9A01_MADCTL             0x36
 #define GC9A01_COLMOD             0x3A
 
+/* SPI1 TX DMA: DMA2 stream 3, channel 3. NDTR is 16 bits wide. */
+#define DISPLAY_DMA_STREAM        DMA2_Stream3
+#define DISPLAY_DMA_CHANNEL       DMA_CHANNEL_3
+#define DISPLAY_DMA_IRQn          DMA2_Stream3_IRQn
+#define DISPLAY_DMA_MAX_ITEMS     0xFFFF
+
+/* Renderer: dirty areas are rasterized a band of lines at a time. The band
+   buffer is DMA source memory and so cannot live in CCMRAM. */
+#define DISPLAY_BAND_LINES        16
+#define DISPLAY_BAND_BUFFERS      2
+#define DISPLAY_BAND_NONE         0xFF
+#define DISPLAY_MAX_DIRTY_RECTS   8
+
+/* Register-level byte write, the host simulator in sim/ replaces it with
+   its command decoder */
+#ifndef DISPLAY_SPI_WRITE_BYTE
+#define DISPLAY_SPI_WRITE_BYTE(byte)  (*(volatile uint8_t*)&hspi1.Instance->DR = (byte))
+#endif
+
+/* Gauges: angles in degrees clockwise from 12 o'clock, trig in Q15 */
+#define DISPLAY_GAUGE_DEFAULT_MAX 100
+#define DISPLAY_TRIG_ONE          32767
+
 /* Color definitions */
 #define COLOR_BLACK               0x0000
 #define COLOR_WHITE               0xFFFF
@@ -48,18 +102,109 @@
 
 /* Private macro -------------------------------------------------------------*/
 /* Private variables ---------------------------------------------------------*/
+/* sin(i degrees) * 32767 for i = 0..90, the other quadrants are mirrored */
+static const int16_t displaySinTable[91] = {
+      0,   572,  1144,  1715,  2286,  2856,  3425,  3993,  4560,  5126,
+   5690,  6252,  6813,  7371,  7927,  8481,  9032,  9580, 10126, 10668,
+  11207, 11743, 12275, 12803, 13328, 13848, 14364, 14876, 15383, 15886,
+  16383, 16876, 17364, 17846, 18323, 18794, 19260, 19720, 20173, 20621,
+  21062, 21497, 21925, 22347, 22762, 23170, 23571, 23964, 24351, 24730,
+  25101, 25465, 25821, 26169, 26509, 26841, 27165, 27481, 27788, 28087,
+  28377, 28659, 28932, 29196, 29451, 29697, 29934, 30162, 30381, 30591,
+  30791, 30982, 31163, 31335, 31498, 31650, 31794, 31927, 32051, 32165,
+  32269, 32364, 32448, 32523, 32587, 32642, 32687, 32722, 32747, 32762,
+  32767
+};
+
 SPI_HandleTypeDef hspi1;
 Display_Item_t displayItems[MAX_DISPLAY_ITEMS];
 uint8_t displayItemCount = 0;
-uint8_t displayBuffer[DISPLAY_WIDTH * DISPLAY_HEIGHT * 2];  /* 16-bit color, 2 bytes per pixel */
+static Display_Item_State_t displayItemStates[MAX_DISPLAY_ITEMS];
+
+/* Item indexes in a min-heap on deadline. Entries of removed items are
+   dropped when they reach the top. */
+static uint8_t deadlineHeap[MAX_DISPLAY_ITEMS];
+static uint8_t deadlineHeapSize = 0;
+static Display_Init_State_t displayInitState = DISPLAY_INIT_RESET;
+static Timer_Wheel_Timer_t displayInitTimer;
+
+/* Pixel transfer in progress. CS stays low until the last chunk completes,
+   busy stays set until a queued band has been sent as well. */
+static DMA_HandleTypeDef hdma_spi1_tx;
+static volatile uint8_t displayDmaBusy = 0;
+static const uint16_t* displayDmaData;
+static uint32_t displayDmaRemaining;
+static uint8_t displayDmaIncrement;
+static uint16_t displayFillColor;
+static volatile uint8_t displayDmaBand = DISPLAY_BAND_NONE;
+static volatile uint32_t displayBytesSent = 0;
+
+/* Areas that no longer match what is on the panel */
+static Display_Rect_t dirtyRects[DISPLAY_MAX_DIRTY_RECTS];
+static uint8_t dirtyRectCount = 0;
+
+/* Two band buffers: one is rasterized while DMA sends the other. A band
+   finished while the previous one is still going out waits in the pending
+   slot and is started from the completion interrupt. */
+static uint16_t bandBuffers[DISPLAY_BAND_BUFFERS][DISPLAY_WIDTH * DISPLAY_BAND_LINES];
+static volatile uint8_t bandBusy[DISPLAY_BAND_BUFFERS];
+static uint8_t bandNext = 0;
+static volatile uint8_t pendingBand = DISPLAY_BAND_NONE;
+static Display_Rect_t pendingRect;
+
+/* Band being rasterized, the Draw functions write into it. Pixels are
+   stored row by row with a stride of the band width. */
+static uint16_t* bandPixels;
+static Display_Rect_t bandRect;
+static Display_Rect_t clipRect;
 
 /* Private function prototypes -----------------------------------------------*/
 static void Display_Manager_InitGC9A01(void);
-static void Display_Manager_WriteCommand(uint8_t cmd);
-static void Display_Manager_WriteData(uint8_t data);
-static void Display_Manager_SetWindow(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1);
-static void Display_Manager_UpdateItem(Display_Item_t* item);
+static void Display_Manager_InitStep(void* context);
+static void Display_Manager_InitDMA(void);
+static void Display_Manager_WaitIdle(void);
+static void Display_Manager_SetFrameSize(uint32_t dataSize);
+static void Display_Manager_SendBytes(const uint8_t* data, uint8_t length);
+static void Display_Manager_SendCommand(uint8_t cmd, const uint8_t* params, uint8_t length);
+static void Display_Manager_WriteCommand(uint8_t cmd, const uint8_t* params, uint8_t length);
+static void Display_Manager_StartTransfer(const Display_Rect_t* rect, const uint16_t* data, uint8_t increment);
+static void Display_Manager_NextChunk(void);
+static void Display_Manager_TransferDone(void);
+static void Display_Manager_SubmitBand(uint8_t band, const Display_Rect_t* rect);
+static void Display_Manager_FillRect(uint16_t x, uint16_t y, uint16_t width, uint16_t height, uint16_t color);
+static void Display_Manager_GetItemRect(const Display_Item_t* item, Display_Rect_t* rect);
+static void Display_Manager_MarkDirty(const Display_Rect_t* rect);
+static void Display_Manager_InvalidateAll(void);
+static void Display_Manager_RenderDirty(void);
+static void Display_Manager_RenderBand(const Display_Rect_t* band);
+#ifdef DISPLAY_BENCHMARK
+static void Display_Manager_ReportBenchmark(void);
+#endif
+static void Display_Manager_RasterFill(int16_t x, int16_t y, int16_t width, int16_t height, uint16_t color);
+static void Display_Manager_RasterGlyph(int16_t x, int16_t y, const Font_Glyph_t* glyph, uint16_t color);
+static uint16_t Display_Manager_BlendColor(uint16_t foreground, uint16_t background, uint8_t level);
+static const Font_Glyph_t* Display_Manager_GetGlyph(char c);
+static uint16_t Display_Manager_TextWidth(const char* text);
+static uint8_t Display_Manager_FormatInt(int32_t value, char* text);
+static void Display_Manager_DrawGauge(const Display_Item_t* item, uint32_t value);
+static void Display_Manager_GetGaugeGeometry(const Display_Item_t* item, int16_t* cx, int16_t* cy, uint16_t* radius, uint8_t* thickness);
+static int16_t Display_Manager_GetGaugeAngle(const Display_Item_t* item, uint32_t value);
+static void Display_Manager_GetSweptRect(const Display_Item_t* item, uint32_t oldValue, uint32_t newValue, Display_Rect_t* rect);
+static void Display_Manager_IncludePolar(int16_t* bounds, int16_t cx, int16_t cy, int16_t angle, uint16_t distance);
+static void Display_Manager_RasterArc(int16_t cx, int16_t cy, uint16_t outer, uint16_t inner, int16_t startAngle, int16_t sweepAngle, uint16_t color);
+static void Display_Manager_RasterNeedle(int16_t cx, int16_t cy, uint16_t length, uint8_t width, int16_t angle, uint16_t color);
+static uint8_t Display_Manager_GetRasterClip(int16_t x0, int16_t y0, int16_t x1, int16_t y1, Display_Rect_t* clip);
+static int16_t Display_Manager_Sin(int16_t angle);
+static int16_t Display_Manager_Cos(int16_t angle);
+static uint16_t Display_Manager_Sqrt(uint32_t value);
+static void Display_Manager_UpdateItem(uint8_t itemIndex);
+static void Display_Manager_ScheduleItem(uint8_t itemIndex, uint32_t deadline);
+static uint8_t Display_Manager_DeadlineBefore(uint8_t a, uint8_t b);
+static void Display_Manager_HeapSiftUp(uint8_t position);
+static void Display_Manager_HeapSiftDown(uint8_t position);
+static void Display_Manager_DrawItem(const Display_Item_t* item, uint32_t value);
 static uint32_t Display_Manager_GetItemValue(Display_Item_t* item);
+static uint32_t Display_Manager_GetCANValue(Display_Item_t* item);
 
 /* External variables --------------------------------------------------------*/
 
@@ -78,7 +223,7 @@ void Display_Manager_Init(void)
   hspi1.Init.CLKPolarity = SPI_POLARITY_LOW;
   hspi1.Init.CLKPhase = SPI_PHASE_1EDGE;
   hspi1.Init.NSS = SPI_NSS_SOFT;
-  hspi1.Init.BaudRatePrescaler = SPI_BAUDRATEPRESCALER_4;
+  hspi1.Init.BaudRatePrescaler = SPI_BAUDRATEPRESCALER_2;  /* 42 MHz from APB2 */
   hspi1.Init.FirstBit = SPI_FIRSTBIT_MSB;
   hspi1.Init.TIMode = SPI_TIMODE_DISABLE;
   hspi1.Init.CRCCalculation = SPI_CRCCALCULATION_DISABLE;
@@ -88,8 +233,8 @@ void Display_Manager_Init(void)
     Error_Handler();
   }
   
-  /* Initialize GC9A01 display controller */
-  Display_Manager_InitGC9A01();
+  /* Pixel data is streamed by DMA */
+  Display_Manager_InitDMA();
   
   /* Initialize display items */
   for (uint8_t i = 0; i < MAX_DISPLAY_ITEMS; i++) {
@@ -101,8 +246,8 @@ void Display_Manager_Init(void)
   /* Load configuration from flash */
   Display_Manager_LoadConfig();
   
-  /* Clear display */
-  Display_Manager_Clear();
+  /* Start the GC9A01 power-up sequence, it completes in the background */
+  Display_Manager_InitGC9A01();
 }
 
 /**
@@ -112,23 +257,117 @@ void Display_Manager_Init(void)
   */
 void Display_Manager_Process(void)
 {
-  static uint32_t lastUpdateTime = 0;
   uint32_t currentTime = HAL_GetTick();
   
-  /* Update display items based on their refresh rate */
-  for (uint8_t i = 0; i < MAX_DISPLAY_ITEMS; i++) {
-    if (displayItems[i].enabled) {
-      /* Check if it's time to update this item */
-      if (currentTime - lastUpdateTime >= displayItems[i].refreshRate) {
-        Display_Manager_UpdateItem(&displayItems[i]);
-      }
+  /* Nothing to draw on until the controller is initialized */
+  if (displayInitState != DISPLAY_INIT_DONE) {
+    return;
+  }
+  
+  /* Check only the items that are due, earliest deadline first */
+  while (deadlineHeapSize > 0) {
+    uint8_t itemIndex = deadlineHeap[0];
+    Display_Item_State_t* state = &displayItemStates[itemIndex];
+    
+    if (displayItems[itemIndex].enabled && (int32_t)(currentTime - state->deadline) < 0) {
+      break;
+    }
+    
+    deadlineHeap[0] = deadlineHeap[--deadlineHeapSize];
+    Display_Manager_HeapSiftDown(0);
+    state->scheduled = 0;
+    
+    if (!displayItems[itemIndex].enabled) {
+      continue;
     }
+    
+    Display_Manager_UpdateItem(itemIndex);
+    
+    /* Due again one period from now, never in the same pass */
+    uint16_t refreshRate = displayItems[itemIndex].refreshRate;
+    Display_Manager_ScheduleItem(itemIndex, currentTime + (refreshRate > 0 ? refreshRate : 1));
+  }
+  
+  /* Send only the areas of items whose content changed */
+  Display_Manager_RenderDirty();
+  
+  Boot_Monitor_Mark(BOOT_PHASE_FIRST_FRAME);
+  
+#ifdef DISPLAY_BENCHMARK
+  Display_Manager_ReportBenchmark();
+#endif
+}
+
+/**
+  * @brief  Check whether the display controller has finished initializing
+  * @param  None
+  * @retval uint8_t: 1 if ready, 0 if still initializing
+  */
+uint8_t Display_Manager_IsReady(void)
+{
+  return displayInitState == DISPLAY_INIT_DONE;
+}
+
+/**
+  * @brief  Measure frame rate and SPI bus utilization of the render pipeline
+  * @note   Blocks for the whole run. Each frame marks the benchmark area
+  *         dirty and renders it with the current items, so the panel shows
+  *         the normal screen afterwards. Time is taken from the DWT cycle
+  *         counter, bus time from the bytes sent at the SPI1 bit rate.
+  * @param  mode: Area redrawn every frame
+  * @param  frames: Number of frames to render
+  * @param  result: Pointer to the result
+  * @retval uint8_t: 1 if successful, 0 otherwise
+  */
+uint8_t Display_Manager_RunBenchmark(Display_Benchmark_Mode_t mode, uint16_t frames, Display_Benchmark_Result_t* result)
+{
+  Display_Rect_t area = { 0, 0, DISPLAY_WIDTH, DISPLAY_HEIGHT };
+  
+  if (result == NULL || frames == 0 || !Display_Manager_IsReady()) {
+    return 0;
+  }
+  
+  if (mode == DISPLAY_BENCHMARK_GAUGE) {
+    area.x0 = (DISPLAY_WIDTH - DISPLAY_BENCHMARK_GAUGE_SIZE) / 2;
+    area.y0 = (DISPLAY_HEIGHT - DISPLAY_BENCHMARK_GAUGE_SIZE) / 2;
+    area.x1 = area.x0 + DISPLAY_BENCHMARK_GAUGE_SIZE;
+    area.y1 = area.y0 + DISPLAY_BENCHMARK_GAUGE_SIZE;
+  }
+  
+  /* Start from an idle bus with nothing else pending */
+  Display_Manager_RenderDirty();
+  Display_Manager_WaitIdle();
+  
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+  
+  uint32_t startBytes = displayBytesSent;
+  uint32_t startCycles = DWT->CYCCNT;
+  
+  for (uint16_t i = 0; i < frames; i++) {
+    Display_Manager_MarkDirty(&area);
+    Display_Manager_RenderDirty();
   }
   
-  /* Update last update time if any item was updated */
-  if (currentTime - lastUpdateTime >= 100) {  /* Minimum update interval */
-    lastUpdateTime = currentTime;
+  Display_Manager_WaitIdle();
+  
+  uint32_t cycles = DWT->CYCCNT - startCycles;
+  uint32_t bytes = displayBytesSent - startBytes;
+  
+  /* SPI1 runs at PCLK2 / 2 */
+  uint64_t busCycles = (uint64_t)bytes * 8 * SystemCoreClock / (HAL_RCC_GetPCLK2Freq() / 2);
+  
+  if (cycles == 0) {
+    cycles = 1;
   }
+  
+  result->frames = frames;
+  result->elapsedUs = cycles / (SystemCoreClock / 1000000);
+  result->bytesSent = bytes;
+  result->fpsX10 = (uint16_t)((uint64_t)frames * 10 * SystemCoreClock / cycles);
+  result->busPermille = (uint16_t)(busCycles * 1000 / cycles);
+  
+  return 1;
 }
 
 /**
@@ -148,6 +387,8 @@ uint8_t Display_Manager_AddItem(Display_Item_t* item)
       /* Copy item to the slot */
       memcpy(&displayItems[i], item, sizeof(Display_Item_t));
       displayItems[i].enabled = 1;
+      displayItemStates[i].drawn = 0;
+      Display_Manager_ScheduleItem(i, HAL_GetTick());
       
       /* Update item count */
       displayItemCount++;
@@ -171,7 +412,11 @@ uint8_t Display_Manager_RemoveItem(uint8_t itemIndex)
     return 0;
   }
   
-  /* Disable the item */
+  /* Disable the item and repaint the area it covered */
+  Display_Rect_t rect;
+  Display_Manager_GetItemRect(&displayItems[itemIndex], &rect);
+  Display_Manager_MarkDirty(&rect);
+  
   displayItems[itemIndex].enabled = 0;
   
   /* Update item count */
@@ -194,6 +439,27 @@ Display_Item_t* Display_Manager_GetItem(uint8_t itemIndex)
   return &displayItems[itemIndex];
 }
 
+/**
+  * @brief  Force a display item to be redrawn
+  * @note   Call after changing an item obtained with Display_Manager_GetItem.
+  *         Moving an item also needs the old area: invalidate before and after.
+  * @param  itemIndex: Index of the item
+  * @retval uint8_t: 1 if successful, 0 if failed
+  */
+uint8_t Display_Manager_InvalidateItem(uint8_t itemIndex)
+{
+  if (itemIndex >= MAX_DISPLAY_ITEMS) {
+    return 0;
+  }
+  
+  Display_Rect_t rect;
+  Display_Manager_GetItemRect(&displayItems[itemIndex], &rect);
+  Display_Manager_MarkDirty(&rect);
+  displayItemStates[itemIndex].drawn = 0;
+  
+  return 1;
+}
+
 /**
   * @brief  Get number of active display items
   * @param  None
@@ -211,8 +477,13 @@ uint8_t Display_Manager_GetItemCount(void)
   */
 uint8_t Display_Manager_SaveConfig(void)
 {
-  /* In a real implementation, this would save the configuration to flash memory
-     using the STM32 HAL flash functions. For this example, we'll just return success. */
+  /* Disabled slots are stored too so a cleared default stays cleared,
+     unchanged slots are skipped by the store */
+  for (uint8_t i = 0; i < MAX_DISPLAY_ITEMS; i++) {
+    if (!Config_Store_Write(CONFIG_KEY_DISPLAY_ITEM(i), &displayItems[i], sizeof(Display_Item_t))) {
+      return 0;
+    }
+  }
   
   return 1;
 }
@@ -224,12 +495,22 @@ uint8_t Display_Manager_SaveConfig(void)
   */
 uint8_t Display_Manager_LoadConfig(void)
 {
-  /* In a real implementation, this would load the configuration from flash memory
-     using the STM32 HAL flash functions. For this example, we'll set default values. */
-  
-  /* Add default display items */
+  /* Start from the default items, stored slots replace them */
   Display_Manager_ResetConfig();
   
+  displayItemCount = 0;
+  
+  for (uint8_t i = 0; i < MAX_DISPLAY_ITEMS; i++) {
+    Config_Store_Read(CONFIG_KEY_DISPLAY_ITEM(i), &displayItems[i], sizeof(Display_Item_t));
+    
+    if (displayItems[i].enabled) {
+      displayItemCount++;
+      Display_Manager_ScheduleItem(i, HAL_GetTick());
+    }
+  }
+  
+  Display_Manager_InvalidateAll();
+  
   return 1;
 }
 
@@ -263,6 +544,7 @@ void Display_Manager_ResetConfig(void)
   defaultItem.backgroundColor = COLOR_BLACK;
   strcpy(defaultItem.label, "Status");
   defaultItem.refreshRate = 1000;  /* Update every second */
+  defaultItem.hysteresis = 0;
   
   Display_Manager_AddItem(&defaultItem);
   
@@ -277,12 +559,16 @@ void Display_Manager_ResetConfig(void)
   defaultItem.source.can.canId = 0x100;
   defaultItem.source.can.dataIndex = 0;
   defaultItem.source.can.dataLength = 2;
+  defaultItem.source.can.flags = 0;
   defaultItem.color = COLOR_GREEN;
   defaultItem.backgroundColor = COLOR_BLACK;
   strcpy(defaultItem.label, "RPM");
   defaultItem.refreshRate = 100;  /* Update 10 times per second */
+  defaultItem.hysteresis = 0;
   
   Display_Manager_AddItem(&defaultItem);
+  
+  Display_Manager_InvalidateAll();
 }
 
 /**
@@ -292,20 +578,22 @@ void Display_Manager_ResetConfig(void)
   */
 void Display_Manager_Clear(void)
 {
-  /* Set window to entire display */
-  Display_Manager_SetWindow(0, 0, DISPLAY_WIDTH - 1, DISPLAY_HEIGHT - 1);
+  /* Fill with black, returns while the DMA is still running */
+  Display_Manager_FillRect(0, 0, DISPLAY_WIDTH, DISPLAY_HEIGHT, COLOR_BLACK);
   
-  /* Fill with black */
-  Display_Manager_WriteCommand(GC9A01_RAMWR);
+  /* Nothing left to repaint but the items themselves */
+  dirtyRectCount = 0;
   
-  for (uint32_t i = 0; i < DISPLAY_WIDTH * DISPLAY_HEIGHT; i++) {
-    Display_Manager_WriteData(0x00);  /* Black, high byte */
-    Display_Manager_WriteData(0x00);  /* Black, low byte */
+  for (uint8_t i = 0; i < MAX_DISPLAY_ITEMS; i++) {
+    displayItemStates[i].drawn = 0;
   }
 }
 
 /**
   * @brief  Draw text on display
+  * @note   The Draw functions rasterize into the band being rendered and are
+  *         called while display items are drawn. Output is clipped to the
+  *         item being drawn.
   * @param  x: X coordinate
   * @param  y: Y coordinate
   * @param  text: Text to draw
@@ -314,21 +602,22 @@ void Display_Manager_Clear(void)
   */
 void Display_Manager_DrawText(uint8_t x, uint8_t y, const char* text, uint16_t color)
 {
-  /* In a real implementation, this would use a font library to draw text.
-     For this example, we'll just set a window and fill it with the text color. */
-  
-  uint8_t width = strlen(text) * 8;  /* Assume 8 pixels per character */
-  uint8_t height = 16;  /* Assume 16 pixels height */
+  int16_t penX = x;
   
-  /* Set window */
-  Display_Manager_SetWindow(x, y, x + width - 1, y + height - 1);
-  
-  /* Fill with color */
-  Display_Manager_WriteCommand(GC9A01_RAMWR);
-  
-  for (uint32_t i = 0; i < width * height; i++) {
-    Display_Manager_WriteData((color >> 8) & 0xFF);  /* High byte */
-    Display_Manager_WriteData(color & 0xFF);  /* Low byte */
+  /* Glyphs are blitted from the flash atlas, the line is fontDefault.height high */
+  while (*text != '\0') {
+    const Font_Glyph_t* glyph = Display_Manager_GetGlyph(*text++);
+    
+    if (glyph->width > 0) {
+      Display_Manager_RasterGlyph(penX + glyph->xOffset, y + glyph->yOffset, glyph, color);
+    }
+    
+    penX += glyph->advance;
+    
+    /* Nothing further right can be visible */
+    if (penX >= (int16_t)clipRect.x1 || penX >= (int16_t)bandRect.x1) {
+      break;
+    }
   }
 }
 
@@ -343,8 +632,8 @@ void Display_Manager_DrawText(uint8_t x, uint8_t y, const char* text, uint16_t c
 void Display_Manager_DrawValue(uint8_t x, uint8_t y, int32_t value, uint16_t color)
 {
   /* Convert value to string */
-  char valueStr[16];
-  sprintf(valueStr, "%ld", value);
+  char valueStr[12];
+  Display_Manager_FormatInt(value, valueStr);
   
   /* Draw text */
   Display_Manager_DrawText(x, y, valueStr, color);
@@ -370,29 +659,8 @@ void Display_Manager_DrawBar(uint8_t x, uint8_t y, uint8_t width, uint8_t height
   /* Calculate bar width based on value */
   uint8_t barWidth = (width * value) / 100;
   
-  /* Set window for bar */
-  Display_Manager_SetWindow(x, y, x + barWidth - 1, y + height - 1);
-  
-  /* Fill with color */
-  Display_Manager_WriteCommand(GC9A01_RAMWR);
-  
-  for (uint32_t i = 0; i < barWidth * height; i++) {
-    Display_Manager_WriteData((color >> 8) & 0xFF);  /* High byte */
-    Display_Manager_WriteData(color & 0xFF);  /* Low byte */
-  }
-  
-  /* Set window for background */
-  if (barWidth < width) {
-    Display_Manager_SetWindow(x + barWidth, y, x + width - 1, y + height - 1);
-    
-    /* Fill with black */
-    Display_Manager_WriteCommand(GC9A01_RAMWR);
-    
-    for (uint32_t i = 0; i < (width - barWidth) * height; i++) {
-      Display_Manager_WriteData(0x00);  /* Black, high byte */
-      Display_Manager_WriteData(0x00);  /* Black, low byte */
-    }
-  }
+  /* Fill bar with color, the rest shows the item background */
+  Display_Manager_RasterFill(x, y, barWidth, height, color);
 }
 
 /**
@@ -410,184 +678,1447 @@ void Display_Manager_DrawIcon(uint8_t x, uint8_t y, uint8_t iconId, uint16_t col
   
   uint8_t size = 16;  /* Icon size */
   
-  /* Set window */
-  Display_Manager_SetWindow(x, y, x + size - 1, y + size - 1);
-  
   /* Fill with color */
-  Display_Manager_WriteCommand(GC9A01_RAMWR);
+  Display_Manager_RasterFill(x, y, size, size, color);
+}
+
+/**
+  * @brief  Draw arc on display
+  * @param  x: X coordinate of the center
+  * @param  y: Y coordinate of the center
+  * @param  radius: Outer radius
+  * @param  thickness: Ring width in pixels
+  * @param  startAngle: Start in degrees clockwise from 12 o'clock
+  * @param  sweepAngle: Degrees covered clockwise from the start, 360 for a full ring
+  * @param  color: Arc color
+  * @retval None
+  */
+void Display_Manager_DrawArc(uint8_t x, uint8_t y, uint8_t radius, uint8_t thickness, int16_t startAngle, int16_t sweepAngle, uint16_t color)
+{
+  uint16_t inner = thickness < radius ? radius - thickness : 0;
   
-  for (uint32_t i = 0; i < size * size; i++) {
-    Display_Manager_WriteData((color >> 8) & 0xFF);  /* High byte */
-    Display_Manager_WriteData(color & 0xFF);  /* Low byte */
-  }
+  Display_Manager_RasterArc(x, y, radius, inner, startAngle, sweepAngle, color);
+}
+
+/**
+  * @brief  Draw needle on display
+  * @param  x: X coordinate of the pivot
+  * @param  y: Y coordinate of the pivot
+  * @param  length: Length from the pivot to the tip
+  * @param  width: Needle width in pixels
+  * @param  angle: Direction in degrees clockwise from 12 o'clock
+  * @param  color: Needle color
+  * @retval None
+  */
+void Display_Manager_DrawNeedle(uint8_t x, uint8_t y, uint8_t length, uint8_t width, int16_t angle, uint16_t color)
+{
+  Display_Manager_RasterNeedle(x, y, length, width, angle, color);
 }
 
 /**
   * @brief  Initialize GC9A01 display controller
+  * @note   Only starts the power-up sequence. The reset and sleep-out waits
+  *         run on the timer wheel, see Display_Manager_IsReady.
   * @param  None
   * @retval None
   */
 static void Display_Manager_InitGC9A01(void)
 {
-  /* Reset display */
-  HAL_GPIO_WritePin(DISPLAY_RST_PORT, DISPLAY_RST_PIN, GPIO_PIN_RESET);
-  HAL_Delay(10);
-  HAL_GPIO_WritePin(DISPLAY_RST_PORT, DISPLAY_RST_PIN, GPIO_PIN_SET);
-  HAL_Delay(120);
+  Timer_Wheel_Stop(&displayInitTimer);
+  displayInitState = DISPLAY_INIT_RESET;
+  Display_Manager_InitStep(NULL);
+}
+
+/**
+  * @brief  Run one step of the GC9A01 power-up sequence
+  * @param  context: Unused
+  * @retval None
+  */
+static void Display_Manager_InitStep(void* context)
+{
+  uint32_t delayMs;
+  
+  (void)context;
+  
+  switch (displayInitState) {
+    case DISPLAY_INIT_RESET:
+      /* Reset display */
+      HAL_GPIO_WritePin(DISPLAY_RST_PORT, DISPLAY_RST_PIN, GPIO_PIN_RESET);
+      delayMs = 10;
+      break;
+    
+    case DISPLAY_INIT_RELEASE:
+      HAL_GPIO_WritePin(DISPLAY_RST_PORT, DISPLAY_RST_PIN, GPIO_PIN_SET);
+      delayMs = 120;
+      break;
+    
+    case DISPLAY_INIT_SWRESET:
+      Display_Manager_WriteCommand(GC9A01_SWRESET, NULL, 0);  /* Software reset */
+      delayMs = 120;
+      break;
+    
+    case DISPLAY_INIT_SLPOUT:
+      Display_Manager_WriteCommand(GC9A01_SLPOUT, NULL, 0);  /* Sleep out */
+      delayMs = 120;
+      break;
+    
+    case DISPLAY_INIT_CONFIGURE: {
+      static const uint8_t madctl = 0x08;  /* RGB order */
+      static const uint8_t colmod = 0x05;  /* 16-bit color */
+      
+      Display_Manager_WriteCommand(GC9A01_MADCTL, &madctl, 1);  /* Memory data access control */
+      Display_Manager_WriteCommand(GC9A01_COLMOD, &colmod, 1);  /* Interface pixel format */
+      Display_Manager_WriteCommand(GC9A01_INVON, NULL, 0);  /* Display inversion on */
+      Display_Manager_WriteCommand(GC9A01_DISPON, NULL, 0);  /* Display on */
+      delayMs = 20;
+      break;
+    }
+    
+    case DISPLAY_INIT_CLEAR:
+      /* Clear before the backlight comes on so the power-up contents never show */
+      Display_Manager_Clear();
+      HAL_GPIO_WritePin(DISPLAY_BL_PORT, DISPLAY_BL_PIN, GPIO_PIN_SET);
+      
+      displayInitState = DISPLAY_INIT_DONE;
+      Boot_Monitor_Mark(BOOT_PHASE_DISPLAY_READY);
+      return;
+    
+    default:
+      return;
+  }
+  
+  /* The wheel counts whole ticks, one more makes each wait at least delayMs */
+  displayInitState++;
+  Timer_Wheel_Start(&displayInitTimer, delayMs + 1, Display_Manager_InitStep, NULL);
+}
+
+/**
+  * @brief  Configure the SPI1 TX DMA stream
+  * @note   Only used for pixel data in 16-bit frame mode, so both sides are
+  *         half-word wide. Memory increment is switched per transfer.
+  * @param  None
+  * @retval None
+  */
+static void Display_Manager_InitDMA(void)
+{
+  __HAL_RCC_DMA2_CLK_ENABLE();
   
-  /* Initialize display */
-  Display_Manager_WriteCommand(GC9A01_SWRESET);  /* Software reset */
-  HAL_Delay(120);
+  hdma_spi1_tx.Instance = DISPLAY_DMA_STREAM;
+  hdma_spi1_tx.Init.Channel = DISPLAY_DMA_CHANNEL;
+  hdma_spi1_tx.Init.Direction = DMA_MEMORY_TO_PERIPH;
+  hdma_spi1_tx.Init.PeriphInc = DMA_PINC_DISABLE;
+  hdma_spi1_tx.Init.MemInc = DMA_MINC_ENABLE;
+  hdma_spi1_tx.Init.PeriphDataAlignment = DMA_PDATAALIGN_HALFWORD;
+  hdma_spi1_tx.Init.MemDataAlignment = DMA_MDATAALIGN_HALFWORD;
+  hdma_spi1_tx.Init.Mode = DMA_NORMAL;
+  hdma_spi1_tx.Init.Priority = DMA_PRIORITY_HIGH;
+  hdma_spi1_tx.Init.FIFOMode = DMA_FIFOMODE_DISABLE;
   
-  Display_Manager_WriteCommand(GC9A01_SLPOUT);  /* Sleep out */
-  HAL_Delay(120);
+  if (HAL_DMA_Init(&hdma_spi1_tx) != HAL_OK) {
+    Error_Handler();
+  }
   
-  Display_Manager_WriteCommand(GC9A01_MADCTL);  /* Memory data access control */
-  Display_Manager_WriteData(0x08);  /* RGB order */
+  __HAL_LINKDMA(&hspi1, hdmatx, hdma_spi1_tx);
   
-  Display_Manager_WriteCommand(GC9A01_COLMOD);  /* Interface pixel format */
-  Display_Manager_WriteData(0x05);  /* 16-bit color */
+  HAL_NVIC_SetPriority(DISPLAY_DMA_IRQn, 5, 0);
+  HAL_NVIC_EnableIRQ(DISPLAY_DMA_IRQn);
   
-  Display_Manager_WriteCommand(GC9A01_INVON);  /* Display inversion on */
+  displayDmaBusy = 0;
+}
+
+/**
+  * @brief  Wait for the pixel transfer in progress and any queued band to finish
+  * @param  None
+  * @retval None
+  */
+static void Display_Manager_WaitIdle(void)
+{
+  while (displayDmaBusy) {
+  }
+}
+
+/**
+  * @brief  Switch SPI1 between 8-bit and 16-bit frames
+  * @note   DFF may only change while the SPI is disabled and idle.
+  * @param  dataSize: SPI_DATASIZE_8BIT or SPI_DATASIZE_16BIT
+  * @retval None
+  */
+static void Display_Manager_SetFrameSize(uint32_t dataSize)
+{
+  if (hspi1.Init.DataSize == dataSize) {
+    return;
+  }
   
-  Display_Manager_WriteCommand(GC9A01_DISPON);  /* Display on */
-  HAL_Delay(20);
+  while (__HAL_SPI_GET_FLAG(&hspi1, SPI_FLAG_BSY)) {
+  }
   
-  /* Turn on backlight */
-  HAL_GPIO_WritePin(DISPLAY_BL_PORT, DISPLAY_BL_PIN, GPIO_PIN_SET);
+  __HAL_SPI_DISABLE(&hspi1);
+  hspi1.Instance->CR1 = (hspi1.Instance->CR1 & ~SPI_CR1_DFF) | dataSize;
+  hspi1.Init.DataSize = dataSize;
+  __HAL_SPI_ENABLE(&hspi1);
 }
 
 /**
-  * @brief  Write command to GC9A01
-  * @param  cmd: Command byte
+  * @brief  Send bytes in 8-bit frame mode by polling
+  * @note   Register level so it can run from the DMA completion interrupt,
+  *         where the HAL tick used for HAL_SPI_Transmit timeouts is stopped.
+  * @param  data: Bytes to send
+  * @param  length: Number of bytes
   * @retval None
   */
-static void Display_Manager_WriteCommand(uint8_t cmd)
+static void Display_Manager_SendBytes(const uint8_t* data, uint8_t length)
 {
-  /* Set DC pin low for command */
-  HAL_GPIO_WritePin(DISPLAY_DC_PORT, DISPLAY_DC_PIN, GPIO_PIN_RESET);
+  __HAL_SPI_ENABLE(&hspi1);
   
-  /* Set CS pin low to select display */
-  HAL_GPIO_WritePin(DISPLAY_CS_PORT, DISPLAY_CS_PIN, GPIO_PIN_RESET);
+  for (uint8_t i = 0; i < length; i++) {
+    while (!__HAL_SPI_GET_FLAG(&hspi1, SPI_FLAG_TXE)) {
+    }
+    
+    DISPLAY_SPI_WRITE_BYTE(data[i]);
+  }
+  
+  while (!__HAL_SPI_GET_FLAG(&hspi1, SPI_FLAG_TXE) || __HAL_SPI_GET_FLAG(&hspi1, SPI_FLAG_BSY)) {
+  }
   
-  /* Send command */
-  HAL_SPI_Transmit(&hspi1, &cmd, 1, 10);
+  /* Nothing is read back, clear the overrun the received bytes caused */
+  (void)hspi1.Instance->DR;
+  (void)hspi1.Instance->SR;
   
-  /* Set CS pin high to deselect display */
-  HAL_GPIO_WritePin(DISPLAY_CS_PORT, DISPLAY_CS_PIN, GPIO_PIN_SET);
+  displayBytesSent += length;
 }
 
 /**
-  * @brief  Write data to GC9A01
-  * @param  data: Data byte
+  * @brief  Send a command and its parameters with CS held low throughout
+  * @note   Caller must make sure no pixel transfer is running.
+  * @param  cmd: Command byte
+  * @param  params: Parameter bytes, may be NULL if length is 0
+  * @param  length: Number of parameter bytes
   * @retval None
   */
-static void Display_Manager_WriteData(uint8_t data)
+static void Display_Manager_SendCommand(uint8_t cmd, const uint8_t* params, uint8_t length)
 {
-  /* Set DC pin high for data */
-  HAL_GPIO_WritePin(DISPLAY_DC_PORT, DISPLAY_DC_PIN, GPIO_PIN_SET);
+  Display_Manager_SetFrameSize(SPI_DATASIZE_8BIT);
   
   /* Set CS pin low to select display */
   HAL_GPIO_WritePin(DISPLAY_CS_PORT, DISPLAY_CS_PIN, GPIO_PIN_RESET);
   
-  /* Send data */
-  HAL_SPI_Transmit(&hspi1, &data, 1, 10);
+  /* Set DC pin low for command */
+  HAL_GPIO_WritePin(DISPLAY_DC_PORT, DISPLAY_DC_PIN, GPIO_PIN_RESET);
+  Display_Manager_SendBytes(&cmd, 1);
+  
+  /* Set DC pin high for parameters */
+  if (length > 0) {
+    HAL_GPIO_WritePin(DISPLAY_DC_PORT, DISPLAY_DC_PIN, GPIO_PIN_SET);
+    Display_Manager_SendBytes(params, length);
+  }
   
   /* Set CS pin high to deselect display */
   HAL_GPIO_WritePin(DISPLAY_CS_PORT, DISPLAY_CS_PIN, GPIO_PIN_SET);
 }
 
 /**
-  * @brief  Set display window for drawing
-  * @param  x0: Start X coordinate
-  * @param  y0: Start Y coordinate
-  * @param  x1: End X coordinate
-  * @param  y1: End Y coordinate
+  * @brief  Write command and its parameters to GC9A01
+  * @note   Waits for pixel transfers in progress first.
+  * @param  cmd: Command byte
+  * @param  params: Parameter bytes, may be NULL if length is 0
+  * @param  length: Number of parameter bytes
+  * @retval None
+  */
+static void Display_Manager_WriteCommand(uint8_t cmd, const uint8_t* params, uint8_t length)
+{
+  Display_Manager_WaitIdle();
+  Display_Manager_SendCommand(cmd, params, length);
+}
+
+/**
+  * @brief  Set the window and start streaming pixels into it
+  * @note   Caller must have claimed displayDmaBusy. Returns as soon as the
+  *         first DMA chunk is started. CS is held low from RAMWR until the
+  *         completion interrupt of the last chunk.
+  * @param  rect: Window to write
+  * @param  data: Pixels in RGB565, a single color if increment is 0
+  * @param  increment: 1 to walk the pixel array, 0 to repeat data[0]
   * @retval None
   */
-static void Display_Manager_SetWindow(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1)
+static void Display_Manager_StartTransfer(const Display_Rect_t* rect, const uint16_t* data, uint8_t increment)
 {
+  uint8_t params[4];
+  uint8_t cmd = GC9A01_RAMWR;
+  
   /* Set column address */
-  Display_Manager_WriteCommand(GC9A01_CASET);
-  Display_Manager_WriteData(x0 >> 8);
-  Display_Manager_WriteData(x0 & 0xFF);
-  Display_Manager_WriteData(x1 >> 8);
-  Display_Manager_WriteData(x1 & 0xFF);
+  params[0] = rect->x0 >> 8;
+  params[1] = rect->x0 & 0xFF;
+  params[2] = (rect->x1 - 1) >> 8;
+  params[3] = (rect->x1 - 1) & 0xFF;
+  Display_Manager_SendCommand(GC9A01_CASET, params, sizeof(params));
   
   /* Set row address */
-  Display_Manager_WriteCommand(GC9A01_RASET);
-  Display_Manager_WriteData(y0 >> 8);
-  Display_Manager_WriteData(y0 & 0xFF);
-  Display_Manager_WriteData(y1 >> 8);
-  Display_Manager_WriteData(y1 & 0xFF);
+  params[0] = rect->y0 >> 8;
+  params[1] = rect->y0 & 0xFF;
+  params[2] = (rect->y1 - 1) >> 8;
+  params[3] = (rect->y1 - 1) & 0xFF;
+  Display_Manager_SendCommand(GC9A01_RASET, params, sizeof(params));
+  
+  HAL_GPIO_WritePin(DISPLAY_CS_PORT, DISPLAY_CS_PIN, GPIO_PIN_RESET);
+  HAL_GPIO_WritePin(DISPLAY_DC_PORT, DISPLAY_DC_PIN, GPIO_PIN_RESET);
+  Display_Manager_SendBytes(&cmd, 1);
+  HAL_GPIO_WritePin(DISPLAY_DC_PORT, DISPLAY_DC_PIN, GPIO_PIN_SET);
+  
+  /* One 16-bit frame per pixel, the SPI sends the high byte first as the panel expects */
+  Display_Manager_SetFrameSize(SPI_DATASIZE_16BIT);
+  
+  if (increment) {
+    hdma_spi1_tx.Instance->CR |= DMA_SxCR_MINC;
+  } else {
+    hdma_spi1_tx.Instance->CR &= ~DMA_SxCR_MINC;
+  }
+  
+  displayDmaData = data;
+  displayDmaRemaining = (uint32_t)(rect->x1 - rect->x0) * (rect->y1 - rect->y0);
+  displayDmaIncrement = increment;
+  displayBytesSent += displayDmaRemaining * 2;
+  
+  Display_Manager_NextChunk();
 }
 
 /**
-  * @brief  Update a display item
-  * @param  item: Pointer to display item structure
+  * @brief  Start the next DMA chunk of the current pixel transfer
+  * @param  None
   * @retval None
   */
-static void Display_Manager_UpdateItem(Display_Item_t* item)
+static void Display_Manager_NextChunk(void)
 {
-  if (item == NULL || !item->enabled) {
-    return;
+  uint32_t chunk = displayDmaRemaining;
+  
+  if (chunk > DISPLAY_DMA_MAX_ITEMS) {
+    chunk = DISPLAY_DMA_MAX_ITEMS;
   }
   
-  /* Get value for the item */
-  uint32_t value = Display_Manager_GetItemValue(item);
+  const uint16_t* data = displayDmaData;
+  displayDmaRemaining -= chunk;
   
-  /* Draw item based on its type */
-  switch (item->type) {
-    case DISPLAY_ITEM_TEXT:
-      /* Draw label */
-      Display_Manager_DrawText(item->x, item->y, item->label, item->color);
-      break;
-    
-    case DISPLAY_ITEM_VALUE:
-      /* Draw label */
-      Display_Manager_DrawText(item->x, item->y, item->label, item->color);
-      
-      /* Draw value */
-      Display_Manager_DrawValue(item->x + strlen(item->label) * 8 + 5, item->y, value, item->color);
-      break;
-    
-    case DISPLAY_ITEM_BAR:
-      /* Draw label */
-      Display_Manager_DrawText(item->x, item->y, item->label, item->color);
-      
-      /* Draw bar */
-      Display_Manager_DrawBar(item->x, item->y + 20, item->width, item->height - 20, value, item->color);
-      break;
-    
-    case DISPLAY_ITEM_ICON:
-      /* Draw icon */
-      Display_Manager_DrawIcon(item->x, item->y, value, item->color);
-      break;
-    
-    default:
-      break;
+  if (displayDmaIncrement) {
+    displayDmaData += chunk;
+  }
+  
+  if (HAL_SPI_Transmit_DMA(&hspi1, (uint8_t*)data, (uint16_t)chunk) != HAL_OK) {
+    /* Abandon the transfer rather than leave CS low */
+    displayDmaRemaining = 0;
+    Display_Manager_TransferDone();
   }
 }
 
 /**
-  * @brief  Get value for a display item
-  * @param  item: Pointer to display item structure
-  * @retval uint32_t: Value for the item
+  * @brief  Finish the current transfer and start the queued band, if any
+  * @note   Runs from the DMA completion interrupt.
+  * @param  None
+  * @retval None
   */
-static uint32_t Display_Manager_GetItemValue(Display_Item_t* item)
+static void Display_Manager_TransferDone(void)
 {
-  uint32_t value = 0;
+  /* Set CS pin high to deselect display */
+  HAL_GPIO_WritePin(DISPLAY_CS_PORT, DISPLAY_CS_PIN, GPIO_PIN_SET);
   
-  /* Get value based on data source */
-  switch (item->dataSource) {
-    case DISPLAY_DATA_SOURCE_SERIAL:
-      /* In a real implementation, this would get data from serial buffer */
-      value = 0;
+  if (displayDmaBand != DISPLAY_BAND_NONE) {
+    bandBusy[displayDmaBand] = 0;
+    displayDmaBand = DISPLAY_BAND_NONE;
+  }
+  
+  /* The next band was rendered while this one was sent */
+  if (pendingBand != DISPLAY_BAND_NONE) {
+    displayDmaBand = pendingBand;
+    pendingBand = DISPLAY_BAND_NONE;
+    Display_Manager_StartTransfer(&pendingRect, bandBuffers[displayDmaBand], 1);
+    return;
+  }
+  
+  displayDmaBusy = 0;
+}
+
+/**
+  * @brief  Send a rendered band, or queue it behind the transfer in progress
+  * @param  band: Index of the band buffer
+  * @param  rect: Screen area the band covers
+  * @retval None
+  */
+static void Display_Manager_SubmitBand(uint8_t band, const Display_Rect_t* rect)
+{
+  /* Only one band can wait, with two buffers the slot is free by now */
+  while (pendingBand != DISPLAY_BAND_NONE) {
+  }
+  
+  bandBusy[band] = 1;
+  
+  __disable_irq();
+  
+  if (displayDmaBusy) {
+    pendingRect = *rect;
+    pendingBand = band;
+    __enable_irq();
+    return;
+  }
+  
+  displayDmaBusy = 1;
+  __enable_irq();
+  
+  displayDmaBand = band;
+  Display_Manager_StartTransfer(rect, bandBuffers[band], 1);
+}
+
+/**
+  * @brief  Fill a rectangle with a solid color
+  * @note   The color is sent from a single word with memory increment off,
+  *         so no line buffer is needed. Returns while the DMA is running.
+  * @param  x: X coordinate
+  * @param  y: Y coordinate
+  * @param  width: Width in pixels
+  * @param  height: Height in pixels
+  * @param  color: Fill color in RGB565
+  * @retval None
+  */
+static void Display_Manager_FillRect(uint16_t x, uint16_t y, uint16_t width, uint16_t height, uint16_t color)
+{
+  Display_Rect_t rect = { x, y, x + width, y + height };
+  
+  if (width == 0 || height == 0) {
+    return;
+  }
+  
+  /* Idle once this returns, safe to change the source word */
+  Display_Manager_WaitIdle();
+  
+  displayFillColor = color;
+  displayDmaBusy = 1;
+  Display_Manager_StartTransfer(&rect, &displayFillColor, 0);
+}
+
+/**
+  * @brief  SPI TX complete callback, continues or ends the pixel transfer
+  * @param  hspi: SPI handle
+  * @retval None
+  */
+void HAL_SPI_TxCpltCallback(SPI_HandleTypeDef* hspi)
+{
+  if (hspi != &hspi1 || !displayDmaBusy) {
+    return;
+  }
+  
+  if (displayDmaRemaining > 0) {
+    Display_Manager_NextChunk();
+    return;
+  }
+  
+  Display_Manager_TransferDone();
+}
+
+/**
+  * @brief  DMA2 stream 3 interrupt handler, SPI1 TX
+  * @param  None
+  * @retval None
+  */
+void DMA2_Stream3_IRQHandler(void)
+{
+  HAL_DMA_IRQHandler(&hdma_spi1_tx);
+}
+
+/**
+  * @brief  Get the screen area of a display item
+  * @note   Items are drawn clipped to their own area, so this is all a redraw
+  *         of the item can touch.
+  * @param  item: Pointer to display item structure
+  * @param  rect: Pointer to rectangle receiving the area
+  * @retval None
+  */
+static void Display_Manager_GetItemRect(const Display_Item_t* item, Display_Rect_t* rect)
+{
+  rect->x0 = item->x;
+  rect->y0 = item->y;
+  rect->x1 = item->x + item->width;
+  rect->y1 = item->y + item->height;
+  
+  if (rect->x1 > DISPLAY_WIDTH) {
+    rect->x1 = DISPLAY_WIDTH;
+  }
+  
+  if (rect->y1 > DISPLAY_HEIGHT) {
+    rect->y1 = DISPLAY_HEIGHT;
+  }
+}
+
+/**
+  * @brief  Add an area to the dirty list
+  * @note   Overlapping areas are merged. When the list is full the area is
+  *         merged into the entry whose bounding box grows least.
+  * @param  rect: Area to repaint
+  * @retval None
+  */
+static void Display_Manager_MarkDirty(const Display_Rect_t* rect)
+{
+  Display_Rect_t area = *rect;
+  
+  if (area.x0 >= area.x1 || area.y0 >= area.y1) {
+    return;
+  }
+  
+  /* Absorb every entry the area overlaps, the union may overlap others */
+  uint8_t i = 0;
+  
+  while (i < dirtyRectCount) {
+    Display_Rect_t* dirty = &dirtyRects[i];
+    
+    if (area.x0 <= dirty->x1 && dirty->x0 <= area.x1 &&
+        area.y0 <= dirty->y1 && dirty->y0 <= area.y1) {
+      area.x0 = area.x0 < dirty->x0 ? area.x0 : dirty->x0;
+      area.y0 = area.y0 < dirty->y0 ? area.y0 : dirty->y0;
+      area.x1 = area.x1 > dirty->x1 ? area.x1 : dirty->x1;
+      area.y1 = area.y1 > dirty->y1 ? area.y1 : dirty->y1;
+      
+      dirtyRects[i] = dirtyRects[--dirtyRectCount];
+      i = 0;
+    } else {
+      i++;
+    }
+  }
+  
+  if (dirtyRectCount < DISPLAY_MAX_DIRTY_RECTS) {
+    dirtyRects[dirtyRectCount++] = area;
+    return;
+  }
+  
+  /* List full, grow the entry that costs the fewest extra pixels */
+  uint8_t best = 0;
+  uint32_t bestGrowth = 0xFFFFFFFF;
+  
+  for (i = 0; i < dirtyRectCount; i++) {
+    const Display_Rect_t* dirty = &dirtyRects[i];
+    uint32_t width = (area.x1 > dirty->x1 ? area.x1 : dirty->x1) - (area.x0 < dirty->x0 ? area.x0 : dirty->x0);
+    uint32_t height = (area.y1 > dirty->y1 ? area.y1 : dirty->y1) - (area.y0 < dirty->y0 ? area.y0 : dirty->y0);
+    uint32_t growth = width * height - (uint32_t)(dirty->x1 - dirty->x0) * (dirty->y1 - dirty->y0);
+    
+    if (growth < bestGrowth) {
+      bestGrowth = growth;
+      best = i;
+    }
+  }
+  
+  /* Merge and re-add, the grown entry may now overlap others */
+  Display_Rect_t merged = dirtyRects[best];
+  dirtyRects[best] = dirtyRects[--dirtyRectCount];
+  merged.x0 = area.x0 < merged.x0 ? area.x0 : merged.x0;
+  merged.y0 = area.y0 < merged.y0 ? area.y0 : merged.y0;
+  merged.x1 = area.x1 > merged.x1 ? area.x1 : merged.x1;
+  merged.y1 = area.y1 > merged.y1 ? area.y1 : merged.y1;
+  Display_Manager_MarkDirty(&merged);
+}
+
+/**
+  * @brief  Mark the whole screen for repainting
+  * @param  None
+  * @retval None
+  */
+static void Display_Manager_InvalidateAll(void)
+{
+  Display_Rect_t screen = { 0, 0, DISPLAY_WIDTH, DISPLAY_HEIGHT };
+  
+  dirtyRectCount = 0;
+  Display_Manager_MarkDirty(&screen);
+  
+  for (uint8_t i = 0; i < MAX_DISPLAY_ITEMS; i++) {
+    displayItemStates[i].drawn = 0;
+  }
+}
+
+/**
+  * @brief  Rasterize and send all dirty areas
+  * @param  None
+  * @retval None
+  */
+static void Display_Manager_RenderDirty(void)
+{
+  while (dirtyRectCount > 0) {
+    Display_Rect_t area = dirtyRects[--dirtyRectCount];
+    Display_Rect_t band = area;
+    
+    /* Bands span the full width of the area, so each is one window */
+    for (band.y0 = area.y0; band.y0 < area.y1; band.y0 = band.y1) {
+      band.y1 = band.y0 + DISPLAY_BAND_LINES;
+      
+      if (band.y1 > area.y1) {
+        band.y1 = area.y1;
+      }
+      
+      Display_Manager_RenderBand(&band);
+    }
+  }
+}
+
+/**
+  * @brief  Rasterize one band and send it
+  * @note   Only waits if the buffer is still being sent, which is the case
+  *         when rasterizing is faster than the SPI.
+  * @param  band: Area of the band, at most DISPLAY_BAND_LINES high
+  * @retval None
+  */
+static void Display_Manager_RenderBand(const Display_Rect_t* band)
+{
+  uint16_t width = band->x1 - band->x0;
+  uint16_t height = band->y1 - band->y0;
+  uint8_t buffer = bandNext;
+  
+  bandNext = (bandNext + 1) % DISPLAY_BAND_BUFFERS;
+  
+  while (bandBusy[buffer]) {
+  }
+  
+  bandPixels = bandBuffers[buffer];
+  bandRect = *band;
+  
+  /* Screen background */
+  clipRect = *band;
+  Display_Manager_RasterFill(band->x0, band->y0, width, height, COLOR_BLACK);
+  
+  /* Items in slot order, later items draw over earlier ones */
+  for (uint8_t i = 0; i < MAX_DISPLAY_ITEMS; i++) {
+    const Display_Item_t* item = &displayItems[i];
+    Display_Rect_t itemRect;
+    
+    if (!item->enabled) {
+      continue;
+    }
+    
+    Display_Manager_GetItemRect(item, &itemRect);
+    
+    if (itemRect.x0 >= band->x1 || itemRect.x1 <= band->x0 ||
+        itemRect.y0 >= band->y1 || itemRect.y1 <= band->y0) {
+      continue;
+    }
+    
+    clipRect = itemRect;
+    Display_Manager_DrawItem(item, displayItemStates[i].value);
+  }
+  
+  Display_Manager_SubmitBand(buffer, band);
+}
+
+/**
+  * @brief  Fill a rectangle of the band being rendered
+  * @note   Clipped to the band and to the item being drawn.
+  * @param  x: X coordinate
+  * @param  y: Y coordinate
+  * @param  width: Width in pixels
+  * @param  height: Height in pixels
+  * @param  color: Fill color in RGB565
+  * @retval None
+  */
+static void Display_Manager_RasterFill(int16_t x, int16_t y, int16_t width, int16_t height, uint16_t color)
+{
+  int16_t x0 = x > (int16_t)clipRect.x0 ? x : (int16_t)clipRect.x0;
+  int16_t y0 = y > (int16_t)clipRect.y0 ? y : (int16_t)clipRect.y0;
+  int16_t x1 = x + width < (int16_t)clipRect.x1 ? x + width : (int16_t)clipRect.x1;
+  int16_t y1 = y + height < (int16_t)clipRect.y1 ? y + height : (int16_t)clipRect.y1;
+  
+  x0 = x0 > (int16_t)bandRect.x0 ? x0 : (int16_t)bandRect.x0;
+  y0 = y0 > (int16_t)bandRect.y0 ? y0 : (int16_t)bandRect.y0;
+  x1 = x1 < (int16_t)bandRect.x1 ? x1 : (int16_t)bandRect.x1;
+  y1 = y1 < (int16_t)bandRect.y1 ? y1 : (int16_t)bandRect.y1;
+  
+  if (x0 >= x1 || y0 >= y1) {
+    return;
+  }
+  
+  uint16_t stride = bandRect.x1 - bandRect.x0;
+  
+  for (int16_t row = y0; row < y1; row++) {
+    uint16_t* pixel = &bandPixels[(row - bandRect.y0) * stride + (x0 - bandRect.x0)];
+    
+    for (int16_t column = x0; column < x1; column++) {
+      *pixel++ = color;
+    }
+  }
+}
+
+/**
+  * @brief  Blit a run-length encoded glyph into the band being rendered
+  * @note   Clipped to the band and to the item being drawn. Partly covered
+  *         pixels are blended with what is already in the band.
+  * @param  x: X coordinate of the glyph ink box
+  * @param  y: Y coordinate of the glyph ink box
+  * @param  glyph: Glyph to draw
+  * @param  color: Text color in RGB565
+  * @retval None
+  */
+static void Display_Manager_RasterGlyph(int16_t x, int16_t y, const Font_Glyph_t* glyph, uint16_t color)
+{
+  int16_t x0 = x > (int16_t)clipRect.x0 ? x : (int16_t)clipRect.x0;
+  int16_t y0 = y > (int16_t)clipRect.y0 ? y : (int16_t)clipRect.y0;
+  int16_t x1 = x + glyph->width < (int16_t)clipRect.x1 ? x + glyph->width : (int16_t)clipRect.x1;
+  int16_t y1 = y + glyph->height < (int16_t)clipRect.y1 ? y + glyph->height : (int16_t)clipRect.y1;
+  
+  x0 = x0 > (int16_t)bandRect.x0 ? x0 : (int16_t)bandRect.x0;
+  y0 = y0 > (int16_t)bandRect.y0 ? y0 : (int16_t)bandRect.y0;
+  x1 = x1 < (int16_t)bandRect.x1 ? x1 : (int16_t)bandRect.x1;
+  y1 = y1 < (int16_t)bandRect.y1 ? y1 : (int16_t)bandRect.y1;
+  
+  if (x0 >= x1 || y0 >= y1) {
+    return;
+  }
+  
+  uint16_t stride = bandRect.x1 - bandRect.x0;
+  const uint8_t* run = &fontDefault.data[glyph->offset];
+  int16_t column = 0;
+  int16_t row = 0;
+  
+  /* The background under a glyph is nearly always the item background,
+     so the last blend of each level is reused */
+  uint16_t blendBackground[FONT_LEVEL_MAX] = { 0 };
+  uint16_t blendColor[FONT_LEVEL_MAX] = { 0 };
+  uint8_t blendValid[FONT_LEVEL_MAX] = { 0 };
+  
+  while (y + row < y1) {
+    uint8_t level = FONT_RUN_LEVEL(*run);
+    uint8_t length = FONT_RUN_LENGTH(*run);
+    run++;
+    
+    /* Uncovered runs only move the position */
+    if (level == 0) {
+      column += length;
+      
+      while (column >= glyph->width) {
+        column -= glyph->width;
+        row++;
+      }
+      
+      continue;
+    }
+    
+    /* A run can continue on the next row */
+    while (length > 0) {
+      uint8_t span = glyph->width - column;
+      
+      if (span > length) {
+        span = length;
+      }
+      
+      int16_t pixelY = y + row;
+      int16_t spanX0 = x + column > x0 ? x + column : x0;
+      int16_t spanX1 = x + column + span < x1 ? x + column + span : x1;
+      
+      if (pixelY >= y0 && pixelY < y1 && spanX0 < spanX1) {
+        uint16_t* pixel = &bandPixels[(pixelY - bandRect.y0) * stride + (spanX0 - bandRect.x0)];
+        
+        for (int16_t pixelX = spanX0; pixelX < spanX1; pixelX++, pixel++) {
+          if (level == FONT_LEVEL_MAX) {
+            *pixel = color;
+            continue;
+          }
+          
+          if (!blendValid[level] || blendBackground[level] != *pixel) {
+            blendBackground[level] = *pixel;
+            blendColor[level] = Display_Manager_BlendColor(color, *pixel, level);
+            blendValid[level] = 1;
+          }
+          
+          *pixel = blendColor[level];
+        }
+      }
+      
+      column += span;
+      length -= span;
+      
+      if (column == glyph->width) {
+        column = 0;
+        row++;
+      }
+    }
+  }
+}
+
+/**
+  * @brief  Blend two RGB565 colors by glyph coverage
+  * @param  foreground: Text color
+  * @param  background: Color under the pixel
+  * @param  level: Coverage, 0 to FONT_LEVEL_MAX
+  * @retval uint16_t: Blended color
+  */
+static uint16_t Display_Manager_BlendColor(uint16_t foreground, uint16_t background, uint8_t level)
+{
+  int32_t red = (foreground >> 11) - (background >> 11);
+  int32_t green = ((foreground >> 5) & 0x3F) - ((background >> 5) & 0x3F);
+  int32_t blue = (foreground & 0x1F) - (background & 0x1F);
+  
+  red = (background >> 11) + red * level / FONT_LEVEL_MAX;
+  green = ((background >> 5) & 0x3F) + green * level / FONT_LEVEL_MAX;
+  blue = (background & 0x1F) + blue * level / FONT_LEVEL_MAX;
+  
+  return (uint16_t)((red << 11) | (green << 5) | blue);
+}
+
+/**
+  * @brief  Get the glyph of a character, '?' for characters not in the font
+  * @param  c: Character
+  * @retval const Font_Glyph_t*: Pointer to the glyph
+  */
+static const Font_Glyph_t* Display_Manager_GetGlyph(char c)
+{
+  uint8_t index = (uint8_t)c - fontDefault.firstChar;
+  
+  if (index >= fontDefault.glyphCount) {
+    index = '?' - fontDefault.firstChar;
+  }
+  
+  return &fontDefault.glyphs[index];
+}
+
+/**
+  * @brief  Get the width of a text in the display font
+  * @param  text: Text to measure
+  * @retval uint16_t: Width in pixels
+  */
+static uint16_t Display_Manager_TextWidth(const char* text)
+{
+  uint16_t width = 0;
+  
+  while (*text != '\0') {
+    width += Display_Manager_GetGlyph(*text++)->advance;
+  }
+  
+  return width;
+}
+
+/**
+  * @brief  Convert an integer to decimal text
+  * @note   Used instead of sprintf, which costs far more than the digits.
+  * @param  value: Value to convert
+  * @param  text: Buffer of at least 12 characters
+  * @retval uint8_t: Number of characters written, without the terminator
+  */
+static uint8_t Display_Manager_FormatInt(int32_t value, char* text)
+{
+  char digits[10];
+  uint32_t magnitude = value < 0 ? 0u - (uint32_t)value : (uint32_t)value;
+  uint8_t count = 0;
+  uint8_t length = 0;
+  
+  do {
+    digits[count++] = '0' + magnitude % 10;
+    magnitude /= 10;
+  } while (magnitude > 0);
+  
+  if (value < 0) {
+    text[length++] = '-';
+  }
+  
+  while (count > 0) {
+    text[length++] = digits[--count];
+  }
+  
+  text[length] = '\0';
+  
+  return length;
+}
+
+/**
+  * @brief  Update a display item
+  * @note   Reads the item value and marks the item area dirty only if the
+  *         value moved further than the item hysteresis from what is on
+  *         the panel.
+  * @param  itemIndex: Index of the item
+  * @retval None
+  */
+static void Display_Manager_UpdateItem(uint8_t itemIndex)
+{
+  Display_Item_t* item = &displayItems[itemIndex];
+  Display_Item_State_t* state = &displayItemStates[itemIndex];
+  
+  if (!item->enabled) {
+    return;
+  }
+  
+  /* Get value for the item */
+  uint32_t value = Display_Manager_GetItemValue(item);
+  
+  /* Values are signed on screen, compare the signed distance */
+  int32_t delta = (int32_t)(value - state->value);
+  uint32_t distance = delta < 0 ? 0u - (uint32_t)delta : (uint32_t)delta;
+  
+  if (state->drawn && distance <= item->hysteresis) {
+    return;
+  }
+  
+  Display_Rect_t rect;
+  
+  /* Gauges on the panel only change between the old and the new angle */
+  if (state->drawn && (item->type == DISPLAY_ITEM_ARC || item->type == DISPLAY_ITEM_NEEDLE ||
+                       item->type == DISPLAY_ITEM_RING)) {
+    Display_Manager_GetSweptRect(item, state->value, value, &rect);
+  } else {
+    Display_Manager_GetItemRect(item, &rect);
+  }
+  
+  state->value = value;
+  state->drawn = 1;
+  
+  if (rect.x0 < rect.x1 && rect.y0 < rect.y1) {
+    Display_Manager_MarkDirty(&rect);
+  }
+}
+
+/**
+  * @brief  Put an item in the deadline heap
+  * @note   An item already in the heap, such as a removed item whose slot
+  *         is reused before its entry reached the top, moves to the new
+  *         deadline.
+  * @param  itemIndex: Index of the item
+  * @param  deadline: HAL tick at which the item value is checked next
+  * @retval None
+  */
+static void Display_Manager_ScheduleItem(uint8_t itemIndex, uint32_t deadline)
+{
+  Display_Item_State_t* state = &displayItemStates[itemIndex];
+  
+  state->deadline = deadline;
+  
+  if (state->scheduled) {
+    for (uint8_t position = 0; position < deadlineHeapSize; position++) {
+      if (deadlineHeap[position] == itemIndex) {
+        Display_Manager_HeapSiftUp(position);
+        Display_Manager_HeapSiftDown(position);
+        break;
+      }
+    }
+    return;
+  }
+  
+  state->scheduled = 1;
+  deadlineHeap[deadlineHeapSize] = itemIndex;
+  Display_Manager_HeapSiftUp(deadlineHeapSize++);
+}
+
+/**
+  * @brief  Compare the deadlines of two items, tick wraparound safe
+  * @param  a: Index of the first item
+  * @param  b: Index of the second item
+  * @retval uint8_t: 1 if item a is due before item b, 0 otherwise
+  */
+static uint8_t Display_Manager_DeadlineBefore(uint8_t a, uint8_t b)
+{
+  return (int32_t)(displayItemStates[a].deadline - displayItemStates[b].deadline) < 0;
+}
+
+/**
+  * @brief  Move a heap entry up to its place
+  * @param  position: Position of the entry in the heap
+  * @retval None
+  */
+static void Display_Manager_HeapSiftUp(uint8_t position)
+{
+  while (position > 0) {
+    uint8_t parent = (position - 1) / 2;
+    
+    if (!Display_Manager_DeadlineBefore(deadlineHeap[position], deadlineHeap[parent])) {
+      break;
+    }
+    
+    uint8_t entry = deadlineHeap[position];
+    deadlineHeap[position] = deadlineHeap[parent];
+    deadlineHeap[parent] = entry;
+    position = parent;
+  }
+}
+
+/**
+  * @brief  Move a heap entry down to its place
+  * @param  position: Position of the entry in the heap
+  * @retval None
+  */
+static void Display_Manager_HeapSiftDown(uint8_t position)
+{
+  while (1) {
+    uint8_t child = position * 2 + 1;
+    
+    if (child >= deadlineHeapSize) {
+      break;
+    }
+    
+    if (child + 1 < deadlineHeapSize &&
+        Display_Manager_DeadlineBefore(deadlineHeap[child + 1], deadlineHeap[child])) {
+      child++;
+    }
+    
+    if (!Display_Manager_DeadlineBefore(deadlineHeap[child], deadlineHeap[position])) {
+      break;
+    }
+    
+    uint8_t entry = deadlineHeap[position];
+    deadlineHeap[position] = deadlineHeap[child];
+    deadlineHeap[child] = entry;
+    position = child;
+  }
+}
+
+/**
+  * @brief  Draw a display item into the band being rendered
+  * @param  item: Pointer to display item structure
+  * @param  value: Value to show
+  * @retval None
+  */
+static void Display_Manager_DrawItem(const Display_Item_t* item, uint32_t value)
+{
+  /* Item background */
+  Display_Manager_RasterFill(item->x, item->y, item->width, item->height, item->backgroundColor);
+  
+  /* Draw item based on its type */
+  switch (item->type) {
+    case DISPLAY_ITEM_TEXT:
+      /* Draw label */
+      Display_Manager_DrawText(item->x, item->y, item->label, item->color);
+      break;
+    
+    case DISPLAY_ITEM_VALUE:
+      /* Draw label */
+      Display_Manager_DrawText(item->x, item->y, item->label, item->color);
+      
+      /* Draw value */
+      Display_Manager_DrawValue(item->x + Display_Manager_TextWidth(item->label) + 5, item->y, value, item->color);
+      break;
+    
+    case DISPLAY_ITEM_BAR:
+      /* Draw label */
+      Display_Manager_DrawText(item->x, item->y, item->label, item->color);
+      
+      /* Draw bar */
+      Display_Manager_DrawBar(item->x, item->y + 20, item->width, item->height - 20, value, item->color);
+      break;
+    
+    case DISPLAY_ITEM_ICON:
+      /* Draw icon */
+      Display_Manager_DrawIcon(item->x, item->y, value, item->color);
+      break;
+    
+    case DISPLAY_ITEM_ARC:
+    case DISPLAY_ITEM_NEEDLE:
+    case DISPLAY_ITEM_RING:
+      Display_Manager_DrawGauge(item, value);
+      break;
+    
+    default:
+      break;
+  }
+}
+
+/**
+  * @brief  Draw a round gauge item
+  * @note   The unfilled part of arcs and the needle dial use the item color
+  *         blended into the background.
+  * @param  item: Pointer to display item structure
+  * @param  value: Value to show
+  * @retval None
+  */
+static void Display_Manager_DrawGauge(const Display_Item_t* item, uint32_t value)
+{
+  int16_t cx;
+  int16_t cy;
+  uint16_t radius;
+  uint8_t thickness;
+  uint16_t trackColor = Display_Manager_BlendColor(item->color, item->backgroundColor, 1);
+  int16_t angle = Display_Manager_GetGaugeAngle(item, value);
+  int16_t start = item->gauge.startAngle;
+  
+  Display_Manager_GetGaugeGeometry(item, &cx, &cy, &radius, &thickness);
+  
+  switch (item->type) {
+    case DISPLAY_ITEM_ARC:
+      Display_Manager_RasterArc(cx, cy, radius, radius - thickness, start + angle, item->gauge.sweepAngle - angle, trackColor);
+      Display_Manager_RasterArc(cx, cy, radius, radius - thickness, start, angle, item->color);
+      break;
+    
+    case DISPLAY_ITEM_RING:
+      Display_Manager_RasterArc(cx, cy, radius, radius - thickness, start, angle, item->color);
+      break;
+    
+    case DISPLAY_ITEM_NEEDLE:
+      /* Dial along the rim, then the needle and its hub */
+      Display_Manager_RasterArc(cx, cy, radius, radius - 2, start, item->gauge.sweepAngle, trackColor);
+      Display_Manager_RasterNeedle(cx, cy, radius - 4, thickness, start + angle, item->color);
+      Display_Manager_RasterArc(cx, cy, thickness + 1, 0, 0, 360, item->color);
+      break;
+    
+    default:
+      break;
+  }
+}
+
+/**
+  * @brief  Get center, radius and ring width of a gauge item
+  * @param  item: Pointer to display item structure
+  * @param  cx: Center X coordinate
+  * @param  cy: Center Y coordinate
+  * @param  radius: Outer radius, the largest circle in the item area
+  * @param  thickness: Ring or needle width
+  * @retval None
+  */
+static void Display_Manager_GetGaugeGeometry(const Display_Item_t* item, int16_t* cx, int16_t* cy, uint16_t* radius, uint8_t* thickness)
+{
+  *cx = item->x + item->width / 2;
+  *cy = item->y + item->height / 2;
+  *radius = (item->width < item->height ? item->width : item->height) / 2;
+  *thickness = item->gauge.thickness;
+  
+  if (*thickness == 0) {
+    *thickness = item->type == DISPLAY_ITEM_NEEDLE ? 3 : *radius / 5 + 1;
+  }
+  
+  if (*thickness > *radius) {
+    *thickness = *radius;
+  }
+}
+
+/**
+  * @brief  Get the angle a gauge value is drawn at
+  * @param  item: Pointer to display item structure
+  * @param  value: Value to show, limited to 0..maxValue
+  * @retval int16_t: Degrees from the gauge start angle
+  */
+static int16_t Display_Manager_GetGaugeAngle(const Display_Item_t* item, uint32_t value)
+{
+  uint16_t maxValue = item->gauge.maxValue > 0 ? item->gauge.maxValue : DISPLAY_GAUGE_DEFAULT_MAX;
+  int16_t sweep = item->type == DISPLAY_ITEM_RING ? 360 : item->gauge.sweepAngle;
+  
+  /* Values are signed on screen, negative ones pin to the start */
+  if ((int32_t)value < 0) {
+    value = 0;
+  }
+  
+  if (value > maxValue) {
+    value = maxValue;
+  }
+  
+  return (int16_t)((int32_t)sweep * (int32_t)value / maxValue);
+}
+
+/**
+  * @brief  Get the area a gauge changes in when its value changes
+  * @note   Covers the sector between the old and new angle, so a needle
+  *         move repaints a wedge instead of the whole dial.
+  * @param  item: Pointer to display item structure
+  * @param  oldValue: Value on the panel
+  * @param  newValue: Value to show
+  * @param  rect: Area, clipped to the item
+  * @retval None
+  */
+static void Display_Manager_GetSweptRect(const Display_Item_t* item, uint32_t oldValue, uint32_t newValue, Display_Rect_t* rect)
+{
+  int16_t cx;
+  int16_t cy;
+  uint16_t radius;
+  uint8_t thickness;
+  int16_t from = Display_Manager_GetGaugeAngle(item, oldValue);
+  int16_t to = Display_Manager_GetGaugeAngle(item, newValue);
+  int16_t bounds[4] = { INT16_MAX, INT16_MAX, INT16_MIN, INT16_MIN };
+  Display_Rect_t itemRect;
+  
+  Display_Manager_GetGaugeGeometry(item, &cx, &cy, &radius, &thickness);
+  Display_Manager_GetItemRect(item, &itemRect);
+  
+  if (from > to) {
+    int16_t swap = from;
+    from = to;
+    to = swap;
+  }
+  
+  from += item->gauge.startAngle;
+  to += item->gauge.startAngle;
+  
+  /* Needles sweep from the pivot and have width, arcs only cover the ring */
+  uint16_t inner = item->type == DISPLAY_ITEM_NEEDLE ? 0 : radius - thickness;
+  int16_t margin = item->type == DISPLAY_ITEM_NEEDLE ? thickness + 2 : 2;
+  
+  /* Sector corners, then the rim extremes at the quarter angles in between */
+  Display_Manager_IncludePolar(bounds, cx, cy, from, radius);
+  Display_Manager_IncludePolar(bounds, cx, cy, to, radius);
+  Display_Manager_IncludePolar(bounds, cx, cy, from, inner);
+  Display_Manager_IncludePolar(bounds, cx, cy, to, inner);
+  
+  for (int16_t quarter = from + 90 - ((from % 90) + 90) % 90; quarter < to; quarter += 90) {
+    Display_Manager_IncludePolar(bounds, cx, cy, quarter, radius);
+  }
+  
+  /* Clip to the item, the rest of the panel is not affected */
+  int16_t x0 = bounds[0] - margin;
+  int16_t y0 = bounds[1] - margin;
+  int16_t x1 = bounds[2] + margin + 1;
+  int16_t y1 = bounds[3] + margin + 1;
+  
+  rect->x0 = x0 > (int16_t)itemRect.x0 ? x0 : itemRect.x0;
+  rect->y0 = y0 > (int16_t)itemRect.y0 ? y0 : itemRect.y0;
+  rect->x1 = x1 < (int16_t)itemRect.x1 ? x1 : itemRect.x1;
+  rect->y1 = y1 < (int16_t)itemRect.y1 ? y1 : itemRect.y1;
+}
+
+/**
+  * @brief  Grow a bounding box to include a point given by angle and distance
+  * @param  bounds: Left, top, right and bottom, inclusive
+  * @param  cx: Center X coordinate
+  * @param  cy: Center Y coordinate
+  * @param  angle: Degrees clockwise from 12 o'clock
+  * @param  distance: Distance from the center
+  * @retval None
+  */
+static void Display_Manager_IncludePolar(int16_t* bounds, int16_t cx, int16_t cy, int16_t angle, uint16_t distance)
+{
+  int16_t x = cx + (int16_t)(((int32_t)Display_Manager_Sin(angle) * distance) >> 15);
+  int16_t y = cy - (int16_t)(((int32_t)Display_Manager_Cos(angle) * distance) >> 15);
+  
+  bounds[0] = x < bounds[0] ? x : bounds[0];
+  bounds[1] = y < bounds[1] ? y : bounds[1];
+  bounds[2] = x > bounds[2] ? x : bounds[2];
+  bounds[3] = y > bounds[3] ? y : bounds[3];
+}
+
+/**
+  * @brief  Rasterize a ring sector into the band being rendered
+  * @note   Integer only: each row is cut into at most two spans by the
+  *         outer and inner circle, pixels in the spans are tested against
+  *         the sector edges with cross products. Clipped to the band and to
+  *         the item being drawn.
+  * @param  cx: Center X coordinate
+  * @param  cy: Center Y coordinate
+  * @param  outer: Outer radius, exclusive
+  * @param  inner: Inner radius, 0 for a filled sector
+  * @param  startAngle: Start in degrees clockwise from 12 o'clock
+  * @param  sweepAngle: Degrees covered clockwise from the start
+  * @param  color: Fill color in RGB565
+  * @retval None
+  */
+static void Display_Manager_RasterArc(int16_t cx, int16_t cy, uint16_t outer, uint16_t inner, int16_t startAngle, int16_t sweepAngle, uint16_t color)
+{
+  Display_Rect_t clip;
+  
+  if (sweepAngle <= 0 || outer == 0 ||
+      !Display_Manager_GetRasterClip(cx - outer, cy - outer, cx + outer + 1, cy + outer + 1, &clip)) {
+    return;
+  }
+  
+  /* Sector edge directions, screen Y grows downwards */
+  int32_t startX = Display_Manager_Sin(startAngle);
+  int32_t startY = -Display_Manager_Cos(startAngle);
+  int32_t endX = Display_Manager_Sin(startAngle + sweepAngle);
+  int32_t endY = -Display_Manager_Cos(startAngle + sweepAngle);
+  uint8_t full = sweepAngle >= 360;
+  uint8_t wide = sweepAngle > 180;
+  uint32_t outerSquared = (uint32_t)outer * outer;
+  uint32_t innerSquared = (uint32_t)inner * inner;
+  uint16_t stride = bandRect.x1 - bandRect.x0;
+  
+  for (int16_t y = clip.y0; y < (int16_t)clip.y1; y++) {
+    int32_t dy = y - cy;
+    uint32_t dySquared = (uint32_t)(dy * dy);
+    
+    if (dySquared >= outerSquared) {
+      continue;
+    }
+    
+    /* |dx| <= outerX is inside the outer circle, |dx| <= innerX inside the hole */
+    int16_t outerX = Display_Manager_Sqrt(outerSquared - dySquared - 1);
+    int16_t innerX = dySquared < innerSquared ? (int16_t)Display_Manager_Sqrt(innerSquared - dySquared - 1) : -1;
+    int16_t spans[2][2] = {
+      { cx - outerX, cx - innerX - 1 },
+      { cx + innerX + 1, cx + outerX }
+    };
+    
+    for (uint8_t i = 0; i < 2; i++) {
+      int16_t x0 = spans[i][0] > (int16_t)clip.x0 ? spans[i][0] : (int16_t)clip.x0;
+      int16_t x1 = spans[i][1] < (int16_t)clip.x1 - 1 ? spans[i][1] : (int16_t)clip.x1 - 1;
+      
+      if (x0 > x1) {
+        continue;
+      }
+      
+      uint16_t* pixel = &bandPixels[(y - bandRect.y0) * stride + (x0 - bandRect.x0)];
+      
+      for (int16_t x = x0; x <= x1; x++, pixel++) {
+        int32_t dx = x - cx;
+        
+        if (!full) {
+          /* Clockwise of the start edge and counterclockwise of the end edge */
+          uint8_t afterStart = startX * dy - startY * dx >= 0;
+          uint8_t beforeEnd = endX * dy - endY * dx <= 0;
+          
+          if (wide ? !(afterStart || beforeEnd) : !(afterStart && beforeEnd)) {
+            continue;
+          }
+        }
+        
+        *pixel = color;
+      }
+    }
+  }
+}
+
+/**
+  * @brief  Rasterize a needle into the band being rendered
+  * @note   Pixels are kept if their projection on the needle direction is
+  *         within the length and their distance from it within half the
+  *         width, both in Q15. Only the needle bounding box is scanned.
+  * @param  cx: Pivot X coordinate
+  * @param  cy: Pivot Y coordinate
+  * @param  length: Length from the pivot to the tip
+  * @param  width: Needle width in pixels
+  * @param  angle: Direction in degrees clockwise from 12 o'clock
+  * @param  color: Needle color in RGB565
+  * @retval None
+  */
+static void Display_Manager_RasterNeedle(int16_t cx, int16_t cy, uint16_t length, uint8_t width, int16_t angle, uint16_t color)
+{
+  int32_t directionX = Display_Manager_Sin(angle);
+  int32_t directionY = -Display_Manager_Cos(angle);
+  int16_t tipX = cx + (int16_t)((directionX * length) >> 15);
+  int16_t tipY = cy + (int16_t)((directionY * length) >> 15);
+  Display_Rect_t clip;
+  
+  if (!Display_Manager_GetRasterClip((tipX < cx ? tipX : cx) - width, (tipY < cy ? tipY : cy) - width,
+                                     (tipX > cx ? tipX : cx) + width + 1, (tipY > cy ? tipY : cy) + width + 1, &clip)) {
+    return;
+  }
+  
+  int32_t maxAlong = (int32_t)length << 15;
+  int32_t maxAcross = (int32_t)width << 14;
+  uint16_t stride = bandRect.x1 - bandRect.x0;
+  
+  for (int16_t y = clip.y0; y < (int16_t)clip.y1; y++) {
+    int32_t dy = y - cy;
+    uint16_t* pixel = &bandPixels[(y - bandRect.y0) * stride + (clip.x0 - bandRect.x0)];
+    
+    for (int16_t x = clip.x0; x < (int16_t)clip.x1; x++, pixel++) {
+      int32_t dx = x - cx;
+      int32_t along = dx * directionX + dy * directionY;
+      int32_t across = directionX * dy - directionY * dx;
+      
+      if (along < 0 || along > maxAlong || across > maxAcross || across < -maxAcross) {
+        continue;
+      }
+      
+      *pixel = color;
+    }
+  }
+}
+
+/**
+  * @brief  Intersect an area with the band and the item being drawn
+  * @param  x0: Left edge
+  * @param  y0: Top edge
+  * @param  x1: Right edge, exclusive
+  * @param  y1: Bottom edge, exclusive
+  * @param  clip: Intersection
+  * @retval uint8_t: 1 if the intersection is not empty, 0 otherwise
+  */
+static uint8_t Display_Manager_GetRasterClip(int16_t x0, int16_t y0, int16_t x1, int16_t y1, Display_Rect_t* clip)
+{
+  x0 = x0 > (int16_t)clipRect.x0 ? x0 : (int16_t)clipRect.x0;
+  y0 = y0 > (int16_t)clipRect.y0 ? y0 : (int16_t)clipRect.y0;
+  x1 = x1 < (int16_t)clipRect.x1 ? x1 : (int16_t)clipRect.x1;
+  y1 = y1 < (int16_t)clipRect.y1 ? y1 : (int16_t)clipRect.y1;
+  
+  x0 = x0 > (int16_t)bandRect.x0 ? x0 : (int16_t)bandRect.x0;
+  y0 = y0 > (int16_t)bandRect.y0 ? y0 : (int16_t)bandRect.y0;
+  x1 = x1 < (int16_t)bandRect.x1 ? x1 : (int16_t)bandRect.x1;
+  y1 = y1 < (int16_t)bandRect.y1 ? y1 : (int16_t)bandRect.y1;
+  
+  if (x0 >= x1 || y0 >= y1) {
+    return 0;
+  }
+  
+  clip->x0 = x0;
+  clip->y0 = y0;
+  clip->x1 = x1;
+  clip->y1 = y1;
+  
+  return 1;
+}
+
+/**
+  * @brief  Sine from the quarter-wave table
+  * @param  angle: Degrees, any range
+  * @retval int16_t: Sine in Q15
+  */
+static int16_t Display_Manager_Sin(int16_t angle)
+{
+  angle %= 360;
+  
+  if (angle < 0) {
+    angle += 360;
+  }
+  
+  if (angle <= 90) {
+    return displaySinTable[angle];
+  } else if (angle <= 180) {
+    return displaySinTable[180 - angle];
+  } else if (angle <= 270) {
+    return -displaySinTable[angle - 180];
+  }
+  
+  return -displaySinTable[360 - angle];
+}
+
+/**
+  * @brief  Cosine from the quarter-wave table
+  * @param  angle: Degrees, any range
+  * @retval int16_t: Cosine in Q15
+  */
+static int16_t Display_Manager_Cos(int16_t angle)
+{
+  return Display_Manager_Sin(angle % 360 + 90);
+}
+
+/**
+  * @brief  Integer square root
+  * @param  value: Value
+  * @retval uint16_t: Largest integer whose square is not above value
+  */
+static uint16_t Display_Manager_Sqrt(uint32_t value)
+{
+  uint32_t root = 0;
+  uint32_t bit = 1UL << 30;
+  
+  while (bit > value) {
+    bit >>= 2;
+  }
+  
+  while (bit != 0) {
+    if (value >= root + bit) {
+      value -= root + bit;
+      root = (root >> 1) + bit;
+    } else {
+      root >>= 1;
+    }
+    
+    bit >>= 2;
+  }
+  
+  return (uint16_t)root;
+}
+
+/**
+  * @brief  Get value for a display item
+  * @param  item: Pointer to display item structure
+  * @retval uint32_t: Value for the item
+  */
+static uint32_t Display_Manager_GetItemValue(Display_Item_t* item)
+{
+  uint32_t value = 0;
+  int32_t field;
+  
+  /* Get value based on data source */
+  switch (item->dataSource) {
+    case DISPLAY_DATA_SOURCE_SERIAL:
+      /* Field of the last line received on the serial port */
+      if (Rx_Cache_ReadSerial(item->source.serial.dataIndex, &field)) {
+        value = (uint32_t)field;
+      }
       break;
     
     case DISPLAY_DATA_SOURCE_CAN:
-      /* In a real implementation, this would get data from CAN buffer */
-      value = 0;
+      value = Display_Manager_GetCANValue(item);
       break;
     
     case DISPLAY_DATA_SOURCE_SYSTEM:
@@ -622,3 +2153,83 @@ static uint32_t Display_Manager_GetItemValue(Display_Item_t* item)
   
   return value;
 }
+
+/**
+  * @brief  Get the value of a CAN item from the last frame received for its ID
+  * @note   Reads the receive cache only, the CAN interrupt is never held off.
+  *         An item subscribes its ID the first time it is read.
+  * @param  item: Pointer to display item structure
+  * @retval uint32_t: Value, 0 until a long enough frame has been received
+  */
+static uint32_t Display_Manager_GetCANValue(Display_Item_t* item)
+{
+  Rx_Cache_Frame_t frame;
+  uint8_t index = item->source.can.dataIndex;
+  uint8_t length = item->source.can.dataLength;
+  uint32_t value = 0;
+  
+  if (!Rx_Cache_ReadCAN(item->source.can.canId, &frame)) {
+    Rx_Cache_Subscribe(item->source.can.canId);
+    return 0;
+  }
+  
+  if (length == 0) {
+    length = 1;
+  } else if (length > 4) {
+    length = 4;
+  }
+  
+  if (index + length > frame.length) {
+    return 0;
+  }
+  
+  for (uint8_t i = 0; i < length; i++) {
+    if (item->source.can.flags & DISPLAY_CAN_LSB_FIRST) {
+      value = (value << 8) | frame.data[index + length - 1 - i];
+    } else {
+      value = (value << 8) | frame.data[index + i];
+    }
+  }
+  
+  if ((item->source.can.flags & DISPLAY_CAN_SIGNED) && length < 4 &&
+      (value & (1UL << (length * 8 - 1)))) {
+    value |= 0xFFFFFFFFUL << (length * 8);
+  }
+  
+  return value;
+}
+
+#ifdef DISPLAY_BENCHMARK
+/**
+  * @brief  Run both benchmark modes once after the first frame and send the results
+  * @param  None
+  * @retval None
+  */
+static void Display_Manager_ReportBenchmark(void)
+{
+  static uint8_t reported = 0;
+  Display_Benchmark_Result_t result;
+  uint8_t frame[7];
+  
+  if (reported) {
+    return;
+  }
+  
+  reported = 1;
+  
+  for (uint8_t mode = DISPLAY_BENCHMARK_FULL_SCREEN; mode <= DISPLAY_BENCHMARK_GAUGE; mode++) {
+    if (!Display_Manager_RunBenchmark((Display_Benchmark_Mode_t)mode, 50, &result)) {
+      continue;
+    }
+    
+    frame[0] = mode;
+    frame[1] = result.fpsX10 & 0xFF;
+    frame[2] = result.fpsX10 >> 8;
+    frame[3] = result.busPermille & 0xFF;
+    frame[4] = result.busPermille >> 8;
+    frame[5] = result.frames & 0xFF;
+    frame[6] = result.frames >> 8;
+    Output_Manager_SendCAN(DISPLAY_BENCHMARK_CAN_ID, frame, sizeof(frame));
+  }
+}
+#endif
@@ -0,0 +1,350 @@
+/**
+ * @file font_atlas.c
+ * @brief Generated by tools/gen_font.py from SourceCodePro-Regular.ttf at 16 px, do not edit
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "font.h"
+
+/* Private variables ---------------------------------------------------------*/
+static const uint8_t fontDefaultData[3698] = {
+  0x00, 0xC0, 0x40, 0x00, 0x80, 0x40, 0x00, 0x80, 0x40, 0x00, 0x80, 0x40, 0x00, 0x80, 0x40, 0x00,
+  0x80, 0x40, 0x00, 0x80, 0x40, 0x00, 0x80, 0x40, 0x02, 0x40, 0xC0, 0x80, 0x40, 0xC0, 0x80, 0xC1,
+  0x00, 0x40, 0xC0, 0x80, 0xC0, 0x80, 0x00, 0x40, 0xC0, 0x40, 0x81, 0x01, 0xC0, 0x40, 0x81, 0x01,
+  0xC0, 0x40, 0x80, 0x40, 0x01, 0xC0, 0x00, 0x01, 0x80, 0x40, 0x00, 0x80, 0x40, 0x02, 0x80, 0x01,
+  0x80, 0x01, 0x40, 0xC5, 0x40, 0x01, 0xC0, 0x01, 0xC0, 0x03, 0x80, 0x01, 0x80, 0x02, 0x40, 0x80,
+  0x00, 0x40, 0x80, 0x01, 0x80, 0xC5, 0x01, 0x41, 0x00, 0x41, 0x02, 0x80, 0x40, 0x00, 0x80, 0x40,
+  0x02, 0x80, 0x40, 0x00, 0x80, 0x40, 0x01, 0x02, 0x80, 0x40, 0x04, 0x80, 0x40, 0x03, 0x80, 0xC1,
+  0x80, 0x40, 0x00, 0xC0, 0x80, 0x01, 0x40, 0x80, 0x00, 0xC0, 0x05, 0xC0, 0x80, 0x04, 0x40, 0xC1,
+  0x80, 0x04, 0x40, 0x80, 0xC0, 0x40, 0x04, 0x80, 0xC0, 0x05, 0xC0, 0x40, 0x80, 0x40, 0x01, 0x81,
+  0x00, 0x40, 0x80, 0xC1, 0x80, 0x03, 0x80, 0x40, 0x04, 0x80, 0x40, 0x01, 0x00, 0x80, 0xC0, 0x80,
+  0x03, 0x80, 0x40, 0x80, 0x00, 0x40, 0x80, 0x01, 0x80, 0x40, 0x80, 0x40, 0x01, 0xC0, 0x00, 0x80,
+  0x40, 0x00, 0x40, 0x80, 0x00, 0x40, 0x80, 0x00, 0x40, 0x02, 0x80, 0xC0, 0x80, 0x07, 0x40, 0x00,
+  0x40, 0xC1, 0x40, 0x01, 0x80, 0x40, 0x00, 0xC0, 0x00, 0x40, 0xC0, 0x00, 0x80, 0x40, 0x00, 0x40,
+  0x80, 0x01, 0xC0, 0x40, 0x80, 0x02, 0xC0, 0x00, 0x40, 0xC0, 0x04, 0x40, 0xC1, 0x40, 0x01, 0x40,
+  0x80, 0xC0, 0x80, 0x04, 0xC0, 0x40, 0x00, 0xC0, 0x04, 0xC0, 0x01, 0xC0, 0x40, 0x03, 0xC0, 0x41,
+  0x80, 0x04, 0x80, 0xC1, 0x05, 0xC1, 0x40, 0x01, 0x40, 0x80, 0x00, 0x81, 0x40, 0xC0, 0x01, 0x81,
+  0x40, 0xC0, 0x01, 0x81, 0x00, 0xC0, 0x41, 0xC0, 0x02, 0x80, 0xC0, 0x80, 0x01, 0xC0, 0x80, 0x01,
+  0x80, 0xC1, 0x40, 0x01, 0x80, 0xC1, 0x80, 0x00, 0x40, 0x80, 0xC0, 0x80, 0xC0, 0x80, 0xC0, 0x81,
+  0x40, 0x80, 0x40, 0x02, 0x80, 0x40, 0x01, 0x81, 0x01, 0x40, 0xC0, 0x02, 0x80, 0x40, 0x02, 0xC0,
+  0x02, 0x40, 0x80, 0x02, 0x81, 0x02, 0x81, 0x02, 0x81, 0x02, 0x40, 0x80, 0x03, 0xC0, 0x03, 0x80,
+  0x40, 0x02, 0x40, 0xC0, 0x03, 0x81, 0x03, 0x80, 0x40, 0x80, 0x40, 0x02, 0x40, 0xC0, 0x40, 0x02,
+  0x40, 0x80, 0x03, 0x80, 0x40, 0x02, 0x40, 0x80, 0x03, 0xC0, 0x03, 0xC0, 0x03, 0xC0, 0x40, 0x02,
+  0xC0, 0x03, 0xC0, 0x02, 0x40, 0x80, 0x02, 0x80, 0x40, 0x01, 0x40, 0x80, 0x01, 0x40, 0xC0, 0x40,
+  0x01, 0x80, 0x40, 0x02, 0x02, 0x80, 0x40, 0x04, 0x80, 0x40, 0x01, 0x40, 0x80, 0x40, 0x80, 0x41,
+  0x80, 0x00, 0x40, 0x80, 0xC1, 0x80, 0x40, 0x01, 0x40, 0x80, 0xC0, 0x03, 0xC0, 0x00, 0x40, 0x80,
+  0x01, 0x80, 0x40, 0x01, 0x80, 0x00, 0x02, 0x80, 0x40, 0x05, 0x80, 0x40, 0x05, 0x80, 0x40, 0x02,
+  0x80, 0xC5, 0x40, 0x02, 0x80, 0x40, 0x05, 0x80, 0x40, 0x05, 0x80, 0x40, 0x02, 0x40, 0xC0, 0x80,
+  0x00, 0x40, 0xC1, 0x40, 0x01, 0xC0, 0x40, 0x00, 0x40, 0xC0, 0x00, 0x40, 0xC0, 0x01, 0x40, 0x02,
+  0x80, 0xC5, 0x40, 0x40, 0xC0, 0x80, 0x40, 0xC1, 0x40, 0xC0, 0x80, 0x04, 0x40, 0x80, 0x04, 0x80,
+  0x40, 0x04, 0xC0, 0x04, 0x40, 0x80, 0x04, 0xC0, 0x40, 0x03, 0x40, 0xC0, 0x04, 0x81, 0x04, 0xC0,
+  0x40, 0x03, 0x40, 0x80, 0x04, 0x80, 0x40, 0x04, 0xC0, 0x04, 0x40, 0x80, 0x04, 0xC0, 0x40, 0x03,
+  0x40, 0xC0, 0x04, 0x00, 0x40, 0x80, 0xC1, 0x80, 0x02, 0xC0, 0x80, 0x00, 0x40, 0x81, 0x00, 0x81,
+  0x02, 0x40, 0xC0, 0x00, 0x80, 0x40, 0x03, 0xC0, 0x40, 0xC0, 0x40, 0x00, 0xC0, 0x80, 0x00, 0x80,
+  0x40, 0xC0, 0x40, 0x00, 0xC0, 0x80, 0x00, 0x80, 0x40, 0x81, 0x03, 0xC0, 0x41, 0x80, 0x02, 0x40,
+  0xC0, 0x01, 0xC0, 0x80, 0x00, 0x40, 0xC0, 0x80, 0x01, 0x40, 0x80, 0xC1, 0x80, 0x01, 0x00, 0x40,
+  0x80, 0xC0, 0x80, 0x03, 0x40, 0x82, 0x05, 0x81, 0x05, 0x81, 0x05, 0x81, 0x05, 0x81, 0x05, 0x81,
+  0x05, 0x81, 0x05, 0x81, 0x02, 0x40, 0xC5, 0x40, 0x00, 0x80, 0xC1, 0x80, 0x40, 0x01, 0x81, 0x01,
+  0x40, 0xC0, 0x40, 0x05, 0x81, 0x05, 0x81, 0x05, 0xC0, 0x40, 0x04, 0x81, 0x04, 0x81, 0x04, 0x81,
+  0x04, 0x81, 0x04, 0x80, 0xC5, 0x40, 0x00, 0x40, 0xC2, 0x80, 0x01, 0x40, 0x80, 0x40, 0x00, 0x40,
+  0x81, 0x05, 0x40, 0xC0, 0x04, 0x40, 0xC0, 0x40, 0x02, 0x80, 0xC1, 0x40, 0x05, 0x40, 0xC0, 0x80,
+  0x05, 0x40, 0xC0, 0x06, 0xC0, 0x40, 0xC0, 0x80, 0x01, 0x40, 0x81, 0x01, 0x80, 0xC2, 0x80, 0x01,
+  0x04, 0x80, 0xC0, 0x05, 0x81, 0xC0, 0x04, 0x40, 0x80, 0x00, 0xC0, 0x03, 0x40, 0xC0, 0x01, 0xC0,
+  0x03, 0xC0, 0x40, 0x01, 0xC0, 0x02, 0x80, 0x40, 0x02, 0xC0, 0x01, 0x40, 0xC6, 0x80, 0x05, 0xC0,
+  0x07, 0xC0, 0x07, 0xC0, 0x01, 0x00, 0xC5, 0x01, 0xC0, 0x40, 0x05, 0xC0, 0x05, 0x40, 0xC0, 0x05,
+  0x40, 0xC3, 0x80, 0x06, 0x80, 0xC0, 0x06, 0xC0, 0x40, 0x05, 0xC0, 0x40, 0x81, 0x01, 0x40, 0x81,
+  0x00, 0x40, 0x80, 0xC2, 0x80, 0x01, 0x01, 0x40, 0xC2, 0x80, 0x01, 0x81, 0x40, 0x00, 0x40, 0x80,
+  0x00, 0x40, 0xC0, 0x05, 0x81, 0x05, 0x81, 0x40, 0xC1, 0x80, 0x40, 0x00, 0x80, 0xC0, 0x40, 0x01,
+  0x40, 0xC0, 0x40, 0x81, 0x03, 0x80, 0x41, 0xC0, 0x03, 0x80, 0x40, 0x00, 0xC0, 0x80, 0x01, 0x40,
+  0xC0, 0x02, 0x80, 0xC1, 0x80, 0x01, 0xC6, 0x40, 0x04, 0x40, 0x80, 0x05, 0xC0, 0x05, 0x81, 0x04,
+  0x40, 0xC0, 0x05, 0x81, 0x05, 0xC0, 0x40, 0x05, 0xC0, 0x40, 0x04, 0x40, 0xC0, 0x05, 0x40, 0xC0,
+  0x03, 0x00, 0x40, 0x80, 0xC1, 0x80, 0x02, 0xC0, 0x40, 0x01, 0x81, 0x01, 0xC0, 0x03, 0xC0, 0x01,
+  0x40, 0x80, 0x40, 0x00, 0x81, 0x01, 0x40, 0xC3, 0x01, 0x40, 0xC0, 0x40, 0x00, 0x81, 0x40, 0x00,
+  0x80, 0x40, 0x03, 0xC0, 0x40, 0x80, 0x40, 0x03, 0xC0, 0x41, 0xC0, 0x40, 0x01, 0x40, 0xC0, 0x40,
+  0x00, 0x40, 0x80, 0xC1, 0x80, 0x40, 0x00, 0x00, 0x40, 0x80, 0xC1, 0x40, 0x01, 0x40, 0xC0, 0x40,
+  0x00, 0x40, 0xC0, 0x80, 0x00, 0xC0, 0x40, 0x02, 0x40, 0xC0, 0x00, 0xC0, 0x40, 0x03, 0xC0, 0x40,
+  0x80, 0xC0, 0x40, 0x00, 0x40, 0x80, 0xC0, 0x40, 0x00, 0x80, 0xC1, 0x80, 0x40, 0xC0, 0x40, 0x05,
+  0xC0, 0x05, 0x40, 0xC0, 0x00, 0x41, 0x01, 0x40, 0xC0, 0x40, 0x00, 0x40, 0x80, 0xC1, 0x80, 0x40,
+  0x01, 0x40, 0xC0, 0x80, 0x40, 0xC1, 0x40, 0xC0, 0x80, 0x08, 0x40, 0xC0, 0x80, 0x40, 0xC1, 0x40,
+  0xC0, 0x80, 0x40, 0xC0, 0x80, 0x00, 0x40, 0xC1, 0x00, 0x40, 0xC0, 0x80, 0x10, 0x40, 0xC0, 0x80,
+  0x00, 0x40, 0xC1, 0x40, 0x01, 0xC0, 0x40, 0x00, 0x40, 0xC0, 0x00, 0x40, 0xC0, 0x01, 0x40, 0x02,
+  0x04, 0x80, 0x02, 0x40, 0xC0, 0x40, 0x01, 0x81, 0x01, 0x40, 0xC0, 0x40, 0x02, 0xC0, 0x40, 0x03,
+  0x40, 0xC0, 0x40, 0x04, 0x81, 0x04, 0x40, 0xC0, 0x40, 0x04, 0x80, 0x80, 0xC5, 0x40, 0x17, 0x80,
+  0xC5, 0x40, 0x41, 0x05, 0x81, 0x05, 0x40, 0xC0, 0x40, 0x05, 0x81, 0x05, 0x81, 0x03, 0x81, 0x02,
+  0x40, 0xC0, 0x40, 0x02, 0x81, 0x03, 0x41, 0x04, 0x40, 0x80, 0xC1, 0x40, 0x00, 0x80, 0x40, 0x00,
+  0x40, 0xC0, 0x40, 0x03, 0x81, 0x03, 0x80, 0x40, 0x02, 0x40, 0xC0, 0x02, 0x40, 0xC0, 0x40, 0x02,
+  0xC0, 0x40, 0x03, 0xC0, 0x09, 0x40, 0xC0, 0x80, 0x02, 0x40, 0xC0, 0x80, 0x01, 0x02, 0x80, 0xC2,
+  0x40, 0x02, 0x81, 0x01, 0x40, 0xC0, 0x01, 0x40, 0x80, 0x03, 0x40, 0x80, 0x00, 0xC0, 0x40, 0x03,
+  0x40, 0x80, 0x00, 0xC0, 0x02, 0x40, 0x80, 0xC0, 0x80, 0x40, 0x80, 0x01, 0xC0, 0x80, 0x41, 0x80,
+  0x40, 0x80, 0x00, 0x40, 0x80, 0x01, 0x40, 0x80, 0x00, 0xC0, 0x00, 0x40, 0xC0, 0x01, 0x81, 0x00,
+  0xC0, 0x40, 0x00, 0x80, 0xC0, 0x80, 0x40, 0x80, 0x00, 0x40, 0x80, 0x07, 0x81, 0x40, 0x01, 0x80,
+  0x03, 0x40, 0xC1, 0x80, 0x40, 0x00, 0x03, 0xC0, 0x80, 0x05, 0x40, 0x80, 0xC0, 0x05, 0x80, 0x40,
+  0x80, 0x40, 0x04, 0xC0, 0x00, 0x81, 0x03, 0x40, 0xC0, 0x00, 0x40, 0xC0, 0x03, 0x81, 0x01, 0xC0,
+  0x40, 0x02, 0xC0, 0x40, 0x01, 0x81, 0x01, 0x40, 0xC5, 0x01, 0x81, 0x03, 0xC0, 0x40, 0x00, 0xC0,
+  0x40, 0x03, 0x81, 0x40, 0xC0, 0x04, 0x40, 0xC0, 0x40, 0xC3, 0x80, 0x01, 0x40, 0xC0, 0x01, 0x40,
+  0x81, 0x00, 0x40, 0xC0, 0x02, 0x40, 0xC0, 0x00, 0x40, 0xC0, 0x02, 0x40, 0xC0, 0x00, 0x40, 0xC0,
+  0x01, 0x40, 0x81, 0x00, 0x40, 0xC3, 0x80, 0x01, 0x40, 0xC0, 0x02, 0x40, 0xC0, 0x41, 0xC0, 0x03,
+  0x81, 0x40, 0xC0, 0x03, 0x81, 0x40, 0xC0, 0x02, 0x40, 0xC0, 0x41, 0xC3, 0x80, 0x40, 0x00, 0x01,
+  0x40, 0x80, 0xC1, 0x80, 0x01, 0x80, 0xC0, 0x40, 0x01, 0x80, 0x41, 0xC0, 0x40, 0x04, 0x81, 0x05,
+  0xC0, 0x80, 0x05, 0xC0, 0x40, 0x05, 0xC0, 0x80, 0x05, 0x81, 0x05, 0x40, 0xC0, 0x40, 0x05, 0x80,
+  0xC0, 0x40, 0x01, 0x81, 0x01, 0x40, 0xC2, 0x80, 0x00, 0x80, 0xC2, 0x80, 0x40, 0x01, 0x81, 0x01,
+  0x40, 0xC0, 0x80, 0x00, 0x81, 0x02, 0x40, 0xC0, 0x40, 0x81, 0x03, 0xC0, 0x82, 0x03, 0x83, 0x03,
+  0x83, 0x03, 0x83, 0x03, 0xC0, 0x82, 0x02, 0x40, 0xC0, 0x40, 0x81, 0x01, 0x40, 0xC0, 0x80, 0x00,
+  0x80, 0xC2, 0x80, 0x40, 0x01, 0xC5, 0x40, 0xC0, 0x40, 0x04, 0xC0, 0x40, 0x04, 0xC0, 0x40, 0x04,
+  0xC0, 0x40, 0x04, 0xC4, 0x80, 0x00, 0xC0, 0x40, 0x04, 0xC0, 0x40, 0x04, 0xC0, 0x40, 0x04, 0xC0,
+  0x40, 0x04, 0xC5, 0x40, 0xC5, 0x80, 0xC0, 0x40, 0x04, 0xC0, 0x40, 0x04, 0xC0, 0x40, 0x04, 0xC0,
+  0x40, 0x04, 0xC4, 0x80, 0x00, 0xC0, 0x40, 0x04, 0xC0, 0x40, 0x04, 0xC0, 0x40, 0x04, 0xC0, 0x40,
+  0x04, 0xC0, 0x40, 0x04, 0x01, 0x80, 0xC2, 0x80, 0x01, 0x81, 0x40, 0x00, 0x40, 0x80, 0x00, 0x80,
+  0xC0, 0x05, 0xC0, 0x80, 0x05, 0xC0, 0x40, 0x05, 0xC0, 0x40, 0x01, 0x80, 0xC1, 0x80, 0xC0, 0x40,
+  0x03, 0x81, 0xC0, 0x80, 0x03, 0x82, 0xC0, 0x03, 0x81, 0x00, 0x81, 0x40, 0x00, 0x40, 0xC0, 0x40,
+  0x01, 0x80, 0xC2, 0x40, 0x00, 0x81, 0x03, 0xC0, 0x40, 0x81, 0x03, 0xC0, 0x40, 0x81, 0x03, 0xC0,
+  0x40, 0x81, 0x03, 0xC0, 0x40, 0x81, 0x03, 0xC0, 0x40, 0x80, 0xC5, 0x40, 0x81, 0x03, 0xC0, 0x40,
+  0x81, 0x03, 0xC0, 0x40, 0x81, 0x03, 0xC0, 0x40, 0x81, 0x03, 0xC0, 0x40, 0x81, 0x03, 0xC0, 0x40,
+  0x40, 0xC5, 0x02, 0xC0, 0x40, 0x04, 0xC0, 0x40, 0x04, 0xC0, 0x40, 0x04, 0xC0, 0x40, 0x04, 0xC0,
+  0x40, 0x04, 0xC0, 0x40, 0x04, 0xC0, 0x40, 0x04, 0xC0, 0x40, 0x04, 0xC0, 0x40, 0x01, 0x40, 0xC5,
+  0x00, 0xC5, 0x04, 0x40, 0xC0, 0x04, 0x40, 0xC0, 0x04, 0x40, 0xC0, 0x04, 0x40, 0xC0, 0x04, 0x40,
+  0xC0, 0x04, 0x40, 0xC0, 0x04, 0x40, 0xC0, 0x04, 0x81, 0x40, 0xC0, 0x40, 0x00, 0x40, 0xC0, 0x40,
+  0x00, 0x80, 0xC2, 0x40, 0x00, 0x40, 0xC0, 0x03, 0xC0, 0x41, 0xC0, 0x02, 0x81, 0x00, 0x40, 0xC0,
+  0x01, 0x80, 0xC0, 0x01, 0x40, 0xC0, 0x00, 0x40, 0xC0, 0x40, 0x01, 0x40, 0xC0, 0x40, 0xC0, 0x80,
+  0x02, 0x40, 0xC1, 0x80, 0xC0, 0x40, 0x01, 0x40, 0xC0, 0x80, 0x00, 0x81, 0x01, 0x40, 0xC0, 0x02,
+  0xC0, 0x40, 0x00, 0x40, 0xC0, 0x02, 0x80, 0xC0, 0x00, 0x40, 0xC0, 0x03, 0xC0, 0x41, 0xC0, 0x03,
+  0x40, 0xC0, 0xC0, 0x40, 0x04, 0xC0, 0x40, 0x04, 0xC0, 0x40, 0x04, 0xC0, 0x40, 0x04, 0xC0, 0x40,
+  0x04, 0xC0, 0x40, 0x04, 0xC0, 0x40, 0x04, 0xC0, 0x40, 0x04, 0xC0, 0x40, 0x04, 0xC0, 0x40, 0x04,
+  0xC5, 0x80, 0x80, 0xC0, 0x02, 0x40, 0xC0, 0x40, 0x80, 0xC0, 0x40, 0x01, 0x80, 0xC0, 0x40, 0x81,
+  0x40, 0x01, 0x81, 0x40, 0x80, 0x40, 0x80, 0x00, 0x40, 0x81, 0x40, 0x80, 0x40, 0x80, 0x00, 0x41,
+  0x80, 0x40, 0x80, 0x42, 0x80, 0x00, 0x80, 0x40, 0x80, 0x40, 0x00, 0x81, 0x00, 0x80, 0x40, 0x80,
+  0x40, 0x00, 0x80, 0x40, 0x00, 0x80, 0x40, 0x80, 0x40, 0x03, 0x80, 0x40, 0x80, 0x40, 0x03, 0x80,
+  0x40, 0x80, 0x40, 0x03, 0x80, 0x40, 0x80, 0xC0, 0x03, 0xC0, 0x40, 0x81, 0x40, 0x02, 0xC0, 0x40,
+  0x81, 0xC0, 0x02, 0xC0, 0x40, 0x82, 0x40, 0x01, 0xC0, 0x40, 0x81, 0x40, 0xC0, 0x01, 0xC0, 0x40,
+  0x81, 0x00, 0x80, 0x40, 0x00, 0xC0, 0x40, 0x81, 0x00, 0x40, 0xC0, 0x00, 0xC0, 0x40, 0x81, 0x01,
+  0x80, 0x40, 0xC0, 0x40, 0x81, 0x01, 0x40, 0x80, 0xC0, 0x40, 0x81, 0x02, 0x80, 0xC0, 0x40, 0x81,
+  0x02, 0x40, 0xC0, 0x40, 0x01, 0x40, 0x80, 0xC1, 0x80, 0x03, 0xC0, 0x80, 0x01, 0x81, 0x01, 0x81,
+  0x03, 0xC0, 0x40, 0x00, 0xC0, 0x40, 0x03, 0x81, 0x40, 0xC0, 0x40, 0x03, 0x81, 0x40, 0xC0, 0x04,
+  0x81, 0x00, 0xC0, 0x40, 0x03, 0x81, 0x00, 0xC0, 0x40, 0x03, 0x81, 0x00, 0x81, 0x02, 0x40, 0xC0,
+  0x40, 0x01, 0xC0, 0x80, 0x01, 0x81, 0x02, 0x40, 0x80, 0xC1, 0x80, 0x01, 0x40, 0xC3, 0x80, 0x40,
+  0x00, 0x40, 0xC0, 0x02, 0x40, 0xC0, 0x41, 0xC0, 0x03, 0x81, 0x40, 0xC0, 0x03, 0x81, 0x40, 0xC0,
+  0x03, 0x81, 0x40, 0xC0, 0x02, 0x80, 0xC0, 0x00, 0x40, 0xC3, 0x80, 0x40, 0x00, 0x40, 0xC0, 0x05,
+  0x40, 0xC0, 0x05, 0x40, 0xC0, 0x05, 0x40, 0xC0, 0x05, 0x01, 0x40, 0x80, 0xC1, 0x80, 0x03, 0xC0,
+  0x80, 0x00, 0x40, 0x81, 0x01, 0x81, 0x02, 0x40, 0xC0, 0x40, 0x00, 0xC0, 0x40, 0x03, 0xC0, 0x80,
+  0x00, 0xC0, 0x40, 0x03, 0x81, 0x40, 0xC0, 0x04, 0x81, 0x00, 0xC0, 0x40, 0x03, 0x81, 0x00, 0xC0,
+  0x40, 0x03, 0xC0, 0x80, 0x00, 0x81, 0x02, 0x40, 0xC0, 0x02, 0xC0, 0x80, 0x00, 0x40, 0xC0, 0x80,
+  0x02, 0x40, 0x80, 0xC1, 0x80, 0x05, 0x81, 0x07, 0xC0, 0x80, 0x06, 0x40, 0x80, 0xC0, 0x80, 0x40,
+  0xC3, 0x80, 0x40, 0x00, 0x40, 0xC0, 0x02, 0x40, 0xC0, 0x41, 0xC0, 0x03, 0xC0, 0x41, 0xC0, 0x03,
+  0xC0, 0x41, 0xC0, 0x02, 0x80, 0xC0, 0x00, 0x40, 0xC3, 0x80, 0x40, 0x00, 0x40, 0xC0, 0x01, 0xC0,
+  0x80, 0x01, 0x40, 0xC0, 0x01, 0x40, 0xC0, 0x01, 0x40, 0xC0, 0x02, 0xC0, 0x80, 0x00, 0x40, 0xC0,
+  0x02, 0x40, 0xC0, 0x00, 0x40, 0xC0, 0x03, 0xC0, 0x80, 0x01, 0x80, 0xC1, 0x80, 0x40, 0x01, 0xC0,
+  0x80, 0x01, 0x40, 0x80, 0x00, 0x40, 0xC0, 0x05, 0x40, 0xC0, 0x40, 0x05, 0x80, 0xC0, 0x80, 0x40,
+  0x04, 0x40, 0xC1, 0x80, 0x40, 0x04, 0x40, 0x80, 0xC0, 0x06, 0xC0, 0x80, 0x05, 0xC0, 0x81, 0xC0,
+  0x40, 0x01, 0x80, 0xC0, 0x01, 0x81, 0xC1, 0x80, 0x40, 0x00, 0x40, 0xC7, 0x03, 0xC0, 0x40, 0x06,
+  0xC0, 0x40, 0x06, 0xC0, 0x40, 0x06, 0xC0, 0x40, 0x06, 0xC0, 0x40, 0x06, 0xC0, 0x40, 0x06, 0xC0,
+  0x40, 0x06, 0xC0, 0x40, 0x06, 0xC0, 0x40, 0x06, 0xC0, 0x40, 0x02, 0x81, 0x03, 0xC0, 0x40, 0x81,
+  0x03, 0xC0, 0x40, 0x81, 0x03, 0xC0, 0x40, 0x81, 0x03, 0xC0, 0x40, 0x81, 0x03, 0xC0, 0x40, 0x81,
+  0x03, 0xC0, 0x40, 0x81, 0x03, 0xC0, 0x40, 0x81, 0x03, 0xC0, 0x40, 0x80, 0xC0, 0x02, 0x40, 0xC0,
+  0x01, 0xC0, 0x80, 0x01, 0x81, 0x01, 0x40, 0x80, 0xC1, 0x80, 0x01, 0xC0, 0x40, 0x03, 0x81, 0xC0,
+  0x80, 0x03, 0xC0, 0x40, 0x81, 0x03, 0xC0, 0x00, 0x40, 0xC0, 0x02, 0x40, 0xC0, 0x01, 0xC0, 0x40,
+  0x01, 0x81, 0x01, 0x81, 0x01, 0xC0, 0x40, 0x01, 0x40, 0xC0, 0x00, 0x40, 0xC0, 0x03, 0xC0, 0x00,
+  0x40, 0x80, 0x03, 0x80, 0x40, 0x80, 0x40, 0x03, 0x40, 0x80, 0xC0, 0x05, 0xC0, 0x80, 0x02, 0x81,
+  0x05, 0xC0, 0x40, 0x81, 0x05, 0xC0, 0x41, 0x80, 0x05, 0xC0, 0x00, 0x40, 0xC0, 0x01, 0x80, 0x40,
+  0x00, 0x40, 0xC0, 0x00, 0x40, 0xC0, 0x01, 0x81, 0x00, 0x40, 0x80, 0x01, 0xC0, 0x00, 0x41, 0xC0,
+  0x00, 0x40, 0x80, 0x01, 0xC0, 0x40, 0x80, 0x40, 0x80, 0x40, 0x81, 0x01, 0x80, 0x40, 0x80, 0x00,
+  0x40, 0x81, 0x40, 0x01, 0x80, 0x40, 0x80, 0x00, 0x40, 0x81, 0x40, 0x01, 0x40, 0x81, 0x01, 0xC0,
+  0x80, 0x02, 0x40, 0xC0, 0x40, 0x01, 0x80, 0xC0, 0x01, 0x81, 0x03, 0xC0, 0x40, 0x00, 0xC0, 0x40,
+  0x01, 0x81, 0x01, 0x80, 0xC0, 0x01, 0xC0, 0x40, 0x02, 0xC0, 0x40, 0x81, 0x03, 0x40, 0xC1, 0x05,
+  0xC0, 0x80, 0x04, 0x81, 0xC0, 0x40, 0x02, 0x40, 0xC0, 0x00, 0x81, 0x02, 0x81, 0x01, 0xC0, 0x40,
+  0x00, 0x40, 0xC0, 0x02, 0x80, 0xC0, 0x00, 0xC0, 0x80, 0x03, 0xC0, 0x40, 0xC0, 0x40, 0x03, 0x83,
+  0x03, 0xC0, 0x40, 0x00, 0xC0, 0x40, 0x01, 0x81, 0x01, 0x81, 0x01, 0xC0, 0x40, 0x02, 0xC0, 0x40,
+  0x81, 0x03, 0x81, 0xC0, 0x40, 0x03, 0x40, 0xC0, 0x80, 0x05, 0xC0, 0x40, 0x05, 0xC0, 0x40, 0x05,
+  0xC0, 0x40, 0x05, 0xC0, 0x40, 0x02, 0x40, 0xC5, 0x80, 0x04, 0x40, 0xC0, 0x05, 0xC0, 0x40, 0x04,
+  0x81, 0x04, 0x40, 0xC0, 0x05, 0xC0, 0x80, 0x04, 0x80, 0xC0, 0x04, 0x40, 0xC0, 0x40, 0x04, 0x81,
+  0x04, 0x40, 0xC0, 0x05, 0xC6, 0x80, 0x40, 0xC3, 0x40, 0x80, 0x02, 0x40, 0x80, 0x02, 0x40, 0x80,
+  0x02, 0x40, 0x80, 0x02, 0x40, 0x80, 0x02, 0x40, 0x80, 0x02, 0x40, 0x80, 0x02, 0x40, 0x80, 0x02,
+  0x40, 0x80, 0x02, 0x40, 0x80, 0x02, 0x40, 0x80, 0x02, 0x40, 0x80, 0x02, 0x40, 0xC3, 0x40, 0xC0,
+  0x05, 0xC0, 0x40, 0x04, 0x40, 0x80, 0x05, 0xC0, 0x05, 0x80, 0x40, 0x04, 0x40, 0x80, 0x05, 0xC0,
+  0x40, 0x04, 0x81, 0x04, 0x40, 0xC0, 0x05, 0xC0, 0x40, 0x04, 0x40, 0x80, 0x05, 0xC0, 0x05, 0x80,
+  0x40, 0x04, 0x40, 0x80, 0x40, 0xC3, 0x03, 0xC0, 0x03, 0xC0, 0x03, 0xC0, 0x03, 0xC0, 0x03, 0xC0,
+  0x03, 0xC0, 0x03, 0xC0, 0x03, 0xC0, 0x03, 0xC0, 0x03, 0xC0, 0x03, 0xC0, 0x03, 0xC0, 0x40, 0xC3,
+  0x01, 0xC0, 0x80, 0x02, 0x40, 0x80, 0xC0, 0x02, 0x80, 0x40, 0x80, 0x40, 0x00, 0x40, 0xC0, 0x00,
+  0x40, 0x80, 0x00, 0x81, 0x01, 0xC0, 0x40, 0xC0, 0x02, 0x81, 0xC6, 0x80, 0x81, 0x01, 0x80, 0x40,
+  0x00, 0x40, 0x80, 0xC1, 0x80, 0x02, 0x80, 0x40, 0x01, 0x81, 0x05, 0x40, 0xC0, 0x02, 0x40, 0x80,
+  0xC2, 0x41, 0xC0, 0x80, 0x40, 0x01, 0xC0, 0x40, 0x81, 0x03, 0xC0, 0x40, 0x80, 0xC0, 0x01, 0x40,
+  0x80, 0xC0, 0x40, 0x00, 0x80, 0xC1, 0x80, 0x40, 0xC0, 0x40, 0x81, 0x05, 0x81, 0x05, 0x81, 0x05,
+  0x81, 0x40, 0xC1, 0x80, 0x40, 0x00, 0x80, 0xC0, 0x80, 0x01, 0x80, 0xC0, 0x00, 0x81, 0x03, 0xC0,
+  0x40, 0x81, 0x03, 0x83, 0x03, 0x83, 0x03, 0xC0, 0x40, 0x80, 0xC0, 0x40, 0x01, 0x81, 0x00, 0x81,
+  0x40, 0xC1, 0x80, 0x01, 0x01, 0x40, 0xC2, 0x80, 0x01, 0x81, 0x40, 0x00, 0x40, 0x80, 0x00, 0x40,
+  0xC0, 0x05, 0x81, 0x05, 0x81, 0x05, 0x40, 0xC0, 0x06, 0x81, 0x40, 0x01, 0x80, 0x40, 0x01, 0x80,
+  0xC2, 0x80, 0x00, 0x04, 0x40, 0xC0, 0x04, 0x40, 0xC0, 0x04, 0x40, 0xC0, 0x00, 0x40, 0x80, 0xC0,
+  0x80, 0x40, 0xC0, 0x40, 0xC0, 0x40, 0x00, 0x40, 0x80, 0xC0, 0x81, 0x02, 0x40, 0xC1, 0x40, 0x02,
+  0x40, 0xC1, 0x40, 0x02, 0x40, 0xC0, 0x81, 0x02, 0x40, 0xC0, 0x40, 0xC0, 0x40, 0x00, 0x40, 0x80,
+  0xC0, 0x00, 0x40, 0xC1, 0x80, 0x00, 0xC0, 0x01, 0x80, 0xC1, 0x80, 0x40, 0x01, 0xC0, 0x40, 0x01,
+  0x40, 0xC0, 0x00, 0x81, 0x03, 0x80, 0x40, 0xC6, 0x80, 0xC0, 0x80, 0x05, 0x80, 0xC0, 0x06, 0xC0,
+  0x80, 0x40, 0x00, 0x40, 0x80, 0x02, 0x80, 0xC1, 0x80, 0x40, 0x00, 0x02, 0x40, 0x80, 0xC1, 0x80,
+  0x02, 0xC0, 0x80, 0x01, 0x40, 0x02, 0xC0, 0x40, 0x02, 0x40, 0xC5, 0x40, 0x02, 0xC0, 0x40, 0x05,
+  0xC0, 0x40, 0x05, 0xC0, 0x40, 0x05, 0xC0, 0x40, 0x05, 0xC0, 0x40, 0x05, 0xC0, 0x40, 0x05, 0xC0,
+  0x40, 0x02, 0x00, 0x40, 0x80, 0xC4, 0x00, 0xC0, 0x40, 0x00, 0x40, 0xC0, 0x40, 0x00, 0x40, 0xC0,
+  0x02, 0x81, 0x01, 0xC0, 0x40, 0x00, 0x40, 0xC0, 0x40, 0x01, 0x81, 0xC1, 0x40, 0x01, 0x40, 0xC0,
+  0x05, 0x40, 0xC0, 0x06, 0x80, 0xC4, 0x40, 0x81, 0x03, 0x40, 0xC0, 0x81, 0x02, 0x40, 0x81, 0x00,
+  0x80, 0xC2, 0x80, 0x40, 0x00, 0x81, 0x05, 0x81, 0x05, 0x81, 0x05, 0x81, 0x00, 0x80, 0xC1, 0x40,
+  0x00, 0x80, 0xC0, 0x80, 0x40, 0x00, 0x80, 0xC0, 0x00, 0x80, 0xC0, 0x03, 0xC0, 0x40, 0x81, 0x03,
+  0xC0, 0x40, 0x81, 0x03, 0xC0, 0x40, 0x81, 0x03, 0xC0, 0x40, 0x81, 0x03, 0xC0, 0x40, 0x81, 0x03,
+  0xC0, 0x40, 0x02, 0x40, 0xC0, 0x40, 0x02, 0x40, 0xC0, 0x40, 0x0B, 0x80, 0xC3, 0x40, 0x03, 0xC0,
+  0x40, 0x03, 0xC0, 0x40, 0x03, 0xC0, 0x40, 0x03, 0xC0, 0x40, 0x03, 0xC0, 0x40, 0x03, 0xC0, 0x40,
+  0x03, 0xC0, 0x40, 0x02, 0x40, 0xC0, 0x40, 0x02, 0x40, 0xC0, 0x40, 0x0B, 0x80, 0xC3, 0x40, 0x03,
+  0xC0, 0x40, 0x03, 0xC0, 0x40, 0x03, 0xC0, 0x40, 0x03, 0xC0, 0x40, 0x03, 0xC0, 0x40, 0x03, 0xC0,
+  0x40, 0x03, 0xC0, 0x40, 0x03, 0xC0, 0x41, 0x01, 0x80, 0xC0, 0x00, 0x80, 0xC1, 0x80, 0x40, 0x00,
+  0x40, 0xC0, 0x05, 0x40, 0xC0, 0x05, 0x40, 0xC0, 0x05, 0x40, 0xC0, 0x02, 0x40, 0xC0, 0x41, 0xC0,
+  0x01, 0x40, 0xC0, 0x40, 0x00, 0x40, 0xC0, 0x01, 0xC0, 0x80, 0x01, 0x40, 0xC0, 0x00, 0xC1, 0x02,
+  0x40, 0xC1, 0x80, 0xC0, 0x40, 0x01, 0x40, 0xC0, 0x40, 0x00, 0x40, 0xC0, 0x40, 0x00, 0x40, 0xC0,
+  0x02, 0x40, 0xC0, 0x00, 0x40, 0xC0, 0x03, 0x81, 0x80, 0xC2, 0x40, 0x05, 0xC0, 0x40, 0x05, 0xC0,
+  0x40, 0x05, 0xC0, 0x40, 0x05, 0xC0, 0x40, 0x05, 0xC0, 0x40, 0x05, 0xC0, 0x40, 0x05, 0xC0, 0x40,
+  0x05, 0xC0, 0x40, 0x05, 0x81, 0x05, 0x40, 0x80, 0xC1, 0x40, 0xC0, 0x40, 0xC1, 0x40, 0x80, 0xC0,
+  0x40, 0xC0, 0x80, 0x00, 0x81, 0x00, 0x81, 0xC0, 0x40, 0x00, 0x80, 0x40, 0x00, 0x40, 0xC1, 0x40,
+  0x00, 0x80, 0x40, 0x00, 0x40, 0xC1, 0x40, 0x00, 0x80, 0x40, 0x00, 0x40, 0xC1, 0x40, 0x00, 0x80,
+  0x40, 0x00, 0x40, 0xC1, 0x40, 0x00, 0x80, 0x40, 0x00, 0x40, 0xC1, 0x40, 0x00, 0x80, 0x40, 0x00,
+  0x40, 0xC0, 0x81, 0x00, 0x80, 0xC1, 0x40, 0x00, 0x80, 0xC0, 0x80, 0x40, 0x00, 0x80, 0xC0, 0x00,
+  0x80, 0xC0, 0x03, 0xC0, 0x40, 0x81, 0x03, 0xC0, 0x40, 0x81, 0x03, 0xC0, 0x40, 0x81, 0x03, 0xC0,
+  0x40, 0x81, 0x03, 0xC0, 0x40, 0x81, 0x03, 0xC0, 0x40, 0x00, 0x40, 0x80, 0xC1, 0x80, 0x01, 0x40,
+  0xC0, 0x40, 0x01, 0x81, 0x00, 0x81, 0x03, 0xC0, 0x40, 0xC0, 0x40, 0x03, 0x81, 0xC0, 0x40, 0x03,
+  0x83, 0x03, 0xC0, 0x41, 0xC0, 0x40, 0x01, 0x81, 0x01, 0x40, 0x80, 0xC1, 0x80, 0x01, 0x81, 0x40,
+  0xC1, 0x80, 0x40, 0x00, 0x80, 0xC0, 0x80, 0x01, 0x80, 0xC0, 0x00, 0x81, 0x03, 0xC0, 0x40, 0x81,
+  0x03, 0x83, 0x03, 0x83, 0x03, 0xC0, 0x40, 0x80, 0xC0, 0x40, 0x01, 0x81, 0x00, 0x81, 0x40, 0xC1,
+  0x80, 0x01, 0x81, 0x05, 0x81, 0x05, 0x81, 0x05, 0x00, 0x40, 0x80, 0xC0, 0x80, 0x40, 0xC0, 0x40,
+  0xC0, 0x40, 0x00, 0x40, 0x80, 0xC0, 0x81, 0x02, 0x40, 0xC1, 0x40, 0x02, 0x40, 0xC1, 0x40, 0x02,
+  0x40, 0xC0, 0x81, 0x02, 0x40, 0xC0, 0x40, 0xC0, 0x40, 0x00, 0x40, 0x80, 0xC0, 0x00, 0x40, 0xC1,
+  0x80, 0x40, 0xC0, 0x04, 0x40, 0xC0, 0x04, 0x40, 0xC0, 0x04, 0x40, 0xC0, 0x80, 0x40, 0x00, 0x80,
+  0xC1, 0x40, 0x82, 0x40, 0x02, 0x80, 0xC0, 0x04, 0x81, 0x04, 0x81, 0x04, 0x81, 0x04, 0x81, 0x04,
+  0x81, 0x04, 0x00, 0x40, 0x80, 0xC1, 0x80, 0x40, 0x00, 0x40, 0xC0, 0x40, 0x01, 0x41, 0x00, 0x40,
+  0xC0, 0x40, 0x05, 0x40, 0xC0, 0x80, 0x41, 0x04, 0x40, 0x80, 0xC0, 0x80, 0x06, 0xC0, 0x40, 0x81,
+  0x40, 0x01, 0x40, 0xC0, 0x40, 0x00, 0x40, 0x80, 0xC1, 0x80, 0x40, 0x00, 0x01, 0x81, 0x05, 0x81,
+  0x03, 0xC6, 0x40, 0x01, 0x81, 0x05, 0x81, 0x05, 0x81, 0x05, 0x81, 0x05, 0x81, 0x05, 0x40, 0xC0,
+  0x40, 0x05, 0x80, 0xC2, 0x40, 0x81, 0x02, 0x40, 0xC0, 0x81, 0x02, 0x40, 0xC0, 0x81, 0x02, 0x40,
+  0xC0, 0x81, 0x02, 0x40, 0xC0, 0x81, 0x02, 0x40, 0xC0, 0x81, 0x02, 0x40, 0xC0, 0x40, 0xC0, 0x40,
+  0x00, 0x40, 0x80, 0xC0, 0x00, 0x80, 0xC1, 0x80, 0x00, 0xC0, 0xC0, 0x40, 0x03, 0x83, 0x03, 0xC0,
+  0x40, 0x00, 0xC0, 0x02, 0x40, 0x80, 0x01, 0x81, 0x01, 0xC0, 0x40, 0x01, 0x40, 0xC0, 0x00, 0x40,
+  0xC0, 0x03, 0xC0, 0x40, 0x81, 0x03, 0x81, 0xC0, 0x05, 0xC0, 0x80, 0x02, 0x81, 0x01, 0xC0, 0x40,
+  0x01, 0xC0, 0x40, 0x81, 0x01, 0xC0, 0x80, 0x01, 0xC0, 0x00, 0x40, 0xC0, 0x00, 0x40, 0x80, 0xC0,
+  0x00, 0x40, 0xC0, 0x01, 0xC0, 0x42, 0x80, 0x00, 0x40, 0x80, 0x01, 0xC0, 0x40, 0x80, 0x40, 0x80,
+  0x40, 0x81, 0x01, 0x81, 0xC0, 0x00, 0x40, 0x80, 0xC0, 0x40, 0x01, 0x40, 0x81, 0x01, 0x80, 0xC0,
+  0x02, 0x40, 0xC0, 0x80, 0x01, 0xC1, 0x01, 0x40, 0xC0, 0x02, 0x40, 0xC0, 0x01, 0x81, 0x01, 0xC0,
+  0x40, 0x02, 0xC0, 0x40, 0x81, 0x03, 0x40, 0xC1, 0x04, 0x40, 0xC1, 0x03, 0x40, 0xC0, 0x40, 0x81,
+  0x02, 0xC0, 0x40, 0x01, 0xC0, 0x40, 0x00, 0x81, 0x02, 0x40, 0xC0, 0x40, 0xC0, 0x40, 0x03, 0x83,
+  0x03, 0xC0, 0x40, 0x00, 0xC0, 0x40, 0x01, 0x40, 0x80, 0x01, 0x81, 0x01, 0x80, 0x40, 0x01, 0x40,
+  0xC0, 0x01, 0xC0, 0x03, 0x80, 0x40, 0x81, 0x03, 0x40, 0xC1, 0x05, 0x81, 0x05, 0x80, 0x40, 0x04,
+  0x81, 0x03, 0x80, 0xC0, 0x80, 0x04, 0x40, 0xC5, 0x40, 0x04, 0xC0, 0x80, 0x04, 0x81, 0x04, 0x80,
+  0xC0, 0x04, 0x40, 0xC0, 0x04, 0x40, 0xC0, 0x40, 0x03, 0x40, 0xC0, 0x40, 0x04, 0x80, 0xC5, 0x80,
+  0x01, 0x40, 0x80, 0xC1, 0x01, 0x81, 0x03, 0xC0, 0x40, 0x03, 0xC0, 0x40, 0x03, 0x80, 0x40, 0x02,
+  0x40, 0xC0, 0x40, 0x01, 0xC1, 0x40, 0x03, 0x40, 0xC0, 0x04, 0x80, 0x40, 0x03, 0x80, 0x40, 0x03,
+  0xC0, 0x40, 0x03, 0xC0, 0x40, 0x03, 0x81, 0x03, 0x40, 0x80, 0xC1, 0x80, 0x40, 0x80, 0x40, 0x80,
+  0x40, 0x80, 0x40, 0x80, 0x40, 0x80, 0x40, 0x80, 0x40, 0x80, 0x40, 0x80, 0x40, 0x80, 0x40, 0x80,
+  0x40, 0x80, 0x40, 0x80, 0x40, 0x80, 0x40, 0x80, 0x40, 0x80, 0x40, 0x40, 0xC1, 0x80, 0x05, 0xC0,
+  0x40, 0x04, 0x80, 0x40, 0x04, 0x80, 0x40, 0x04, 0x80, 0x40, 0x04, 0x81, 0x05, 0x80, 0xC0, 0x80,
+  0x02, 0x81, 0x04, 0x80, 0x40, 0x04, 0x80, 0x40, 0x04, 0x80, 0x40, 0x04, 0x80, 0x40, 0x04, 0xC0,
+  0x40, 0x01, 0x40, 0xC1, 0x80, 0x02, 0x00, 0x80, 0xC0, 0x80, 0x40, 0x00, 0x81, 0x40, 0x00, 0x40,
+  0xC1, 0x40,
+};
+
+static const Font_Glyph_t fontDefaultGlyphs[95] = {
+  {     0,  0,  0,   0,  0, 10 },  /* ' ' */
+  {     0,  3, 11,   3,  1, 10 },  /* '!' */
+  {    31,  6,  5,   2,  1, 10 },  /* '"' */
+  {    55,  8, 10,   1,  2, 10 },  /* '#' */
+  {   103,  7, 14,   1,  0, 10 },  /* '$' */
+  {   156,  9, 10,   0,  2, 10 },  /* '%' */
+  {   222,  9, 11,   0,  1, 10 },  /* '&' */
+  {   282,  2,  5,   4,  1, 10 },  /* '\'' */
+  {   291,  5, 15,   3,  0, 10 },  /* '(' */
+  {   329,  5, 15,   2,  0, 10 },  /* ')' */
+  {   372,  7,  7,   1,  3, 10 },  /* '*' */
+  {   406,  8,  7,   1,  3, 10 },  /* '+' */
+  {   429,  4,  6,   3, 10, 10 },  /* ',' */
+  {   448,  8,  1,   1,  6, 10 },  /* '-' */
+  {   451,  3,  3,   3,  9, 10 },  /* '.' */
+  {   459,  7, 14,   1,  1, 10 },  /* '/' */
+  {   499,  8, 10,   1,  2, 10 },  /* '0' */
+  {   558,  8, 10,   1,  2, 10 },  /* '1' */
+  {   584,  8, 10,   1,  2, 10 },  /* '2' */
+  {   614,  8, 10,   1,  2, 10 },  /* '3' */
+  {   656,  9, 10,   0,  2, 10 },  /* '4' */
+  {   693,  8, 10,   1,  2, 10 },  /* '5' */
+  {   726,  8, 10,   1,  2, 10 },  /* '6' */
+  {   774,  8, 10,   1,  2, 10 },  /* '7' */
+  {   801,  8, 10,   1,  2, 10 },  /* '8' */
+  {   855,  8, 10,   1,  2, 10 },  /* '9' */
+  {   913,  3,  9,   3,  3, 10 },  /* ':' */
+  {   930,  4, 13,   3,  3, 10 },  /* ';' */
+  {   960,  6,  9,   2,  2, 10 },  /* '<' */
+  {   987,  8,  5,   1,  4, 10 },  /* '=' */
+  {   994,  7,  9,   1,  2, 10 },  /* '>' */
+  {  1016,  6, 11,   2,  1, 10 },  /* '?' */
+  {  1053,  9, 12,   0,  2, 10 },  /* '@' */
+  {  1126,  9, 11,   0,  1, 10 },  /* 'A' */
+  {  1176,  8, 11,   1,  1, 10 },  /* 'B' */
+  {  1231,  8, 11,   1,  1, 10 },  /* 'C' */
+  {  1273,  8, 11,   1,  1, 10 },  /* 'D' */
+  {  1317,  7, 11,   2,  1, 10 },  /* 'E' */
+  {  1348,  7, 11,   2,  1, 10 },  /* 'F' */
+  {  1380,  8, 11,   1,  1, 10 },  /* 'G' */
+  {  1429,  8, 11,   1,  1, 10 },  /* 'H' */
+  {  1472,  7, 11,   1,  1, 10 },  /* 'I' */
+  {  1504,  7, 11,   1,  1, 10 },  /* 'J' */
+  {  1541,  8, 11,   1,  1, 10 },  /* 'K' */
+  {  1602,  7, 11,   2,  1, 10 },  /* 'L' */
+  {  1634,  8, 11,   1,  1, 10 },  /* 'M' */
+  {  1702,  8, 11,   1,  1, 10 },  /* 'N' */
+  {  1764,  9, 11,   0,  1, 10 },  /* 'O' */
+  {  1820,  8, 11,   1,  1, 10 },  /* 'P' */
+  {  1865,  9, 14,   0,  1, 10 },  /* 'Q' */
+  {  1935,  8, 11,   1,  1, 10 },  /* 'R' */
+  {  1993,  8, 11,   1,  1, 10 },  /* 'S' */
+  {  2042,  9, 11,   0,  1, 10 },  /* 'T' */
+  {  2075,  8, 11,   1,  1, 10 },  /* 'U' */
+  {  2123,  8, 11,   1,  1, 10 },  /* 'V' */
+  {  2175, 10, 11,   0,  1, 10 },  /* 'W' */
+  {  2249,  8, 11,   1,  1, 10 },  /* 'X' */
+  {  2300,  8, 11,   1,  1, 10 },  /* 'Y' */
+  {  2342,  8, 11,   1,  1, 10 },  /* 'Z' */
+  {  2374,  5, 14,   3,  1, 10 },  /* '[' */
+  {  2414,  7, 14,   1,  1, 10 },  /* '\\' */
+  {  2452,  5, 14,   1,  1, 10 },  /* ']' */
+  {  2480,  6,  6,   2,  1, 10 },  /* '^' */
+  {  2506,  8,  1,   1, 13, 10 },  /* '_' */
+  {  2508,  3,  2,   3,  1, 10 },  /* '`' */
+  {  2512,  8,  8,   1,  4, 10 },  /* 'a' */
+  {  2554,  8, 11,   1,  1, 10 },  /* 'b' */
+  {  2596,  8,  8,   1,  4, 10 },  /* 'c' */
+  {  2627,  7, 11,   1,  1, 10 },  /* 'd' */
+  {  2679,  8,  8,   1,  4, 10 },  /* 'e' */
+  {  2715,  8, 11,   1,  1, 10 },  /* 'f' */
+  {  2754,  8, 11,   1,  4, 10 },  /* 'g' */
+  {  2805,  8, 11,   1,  1, 10 },  /* 'h' */
+  {  2850,  6, 12,   1,  0, 10 },  /* 'i' */
+  {  2883,  6, 15,   1,  0, 10 },  /* 'j' */
+  {  2928,  8, 11,   1,  1, 10 },  /* 'k' */
+  {  2984,  8, 11,   1,  1, 10 },  /* 'l' */
+  {  3018,  8,  8,   1,  4, 10 },  /* 'm' */
+  {  3074,  8,  8,   1,  4, 10 },  /* 'n' */
+  {  3113,  8,  8,   1,  4, 10 },  /* 'o' */
+  {  3150,  8, 11,   1,  4, 10 },  /* 'p' */
+  {  3192,  7, 11,   1,  4, 10 },  /* 'q' */
+  {  3244,  7,  8,   2,  4, 10 },  /* 'r' */
+  {  3266,  8,  8,   1,  4, 10 },  /* 's' */
+  {  3308,  8, 10,   1,  2, 10 },  /* 't' */
+  {  3333,  7,  8,   1,  4, 10 },  /* 'u' */
+  {  3370,  8,  8,   1,  4, 10 },  /* 'v' */
+  {  3404, 10,  8,   0,  4, 10 },  /* 'w' */
+  {  3463,  8,  8,   1,  4, 10 },  /* 'x' */
+  {  3500,  8, 11,   1,  4, 10 },  /* 'y' */
+  {  3542,  8,  8,   1,  4, 10 },  /* 'z' */
+  {  3568,  6, 14,   2,  1, 10 },  /* '{' */
+  {  3611,  2, 16,   4,  0, 10 },  /* '|' */
+  {  3643,  7, 14,   1,  1, 10 },  /* '}' */
+  {  3686,  7,  2,   1,  6, 10 },  /* '~' */
+};
+
+/* Exported variables --------------------------------------------------------*/
+const Font_t fontDefault = {
+  .height = 16,
+  .firstChar = 0x20,
+  .glyphCount = 95,
+  .glyphs = fontDefaultGlyphs,
+  .data = fontDefaultData,
+};
@@ -8,6 +8,7 @@
 /* Includes ------------------------------------------------------------------*/
 #include "input_manager.h"
 #include "main.h"
+#include "data_logger.h"
 #include <stdint.h>
 #include <string.h>
 #include <stdio.h>
@@ -409,6 +410,9 @@ static void Input_Manager_AddEvent(Input_Event_Type_t eventType, uint8_t deviceI
   inputEventQueue[queueTail].value = value;
   inputEventQueue[queueTail].timestamp = HAL_GetTick();
   
+  Data_Logger_Record(DATA_LOGGER_SOURCE_INPUT, DATA_LOGGER_INPUT_ID(eventType, deviceIndex, inputId),
+                     (const uint8_t*)&value, sizeof(value));
+  
   /* Update queue tail */
   queueTail = (queueTail + 1) % MAX_INPUT_QUEUE_SIZE;
   eventCount++;
@@ -0,0 +1,405 @@
+/**
+ * @file isotp.c
+ * @brief ISO 15765-2 CAN transport implementation for STM32F407 HID to Serial/CAN project
+ * @author Manus AI
+ * @date 2025-03-28
+ *
+ * Carries messages of up to 4095 bytes over classic CAN with normal 11-bit
+ * addressing. A message of up to 7 bytes goes in a single frame, a longer one
+ * in a first frame followed by consecutive frames of 7 bytes. The receiver
+ * paces the sender with flow control frames: the block size is the number of
+ * consecutive frames between flow controls, STmin the gap between them.
+ *
+ * Frames come from the CAN receive callbacks and go out through the output
+ * manager's transmit queue, so everything here runs in the main loop.
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "isotp.h"
+#include "output_manager.h"
+#include "boot_monitor.h"
+#include <string.h>
+
+/* Private define ------------------------------------------------------------*/
+#define ISOTP_FRAME_SIZE          8
+#define ISOTP_SF_MAX              7     /* Single frame payload */
+#define ISOTP_FF_DATA             6     /* Payload bytes in a first frame */
+#define ISOTP_CF_DATA             7     /* Payload bytes in a consecutive frame */
+
+/* Protocol control information, high nibble of the first byte */
+#define ISOTP_PCI_SINGLE          0x0
+#define ISOTP_PCI_FIRST           0x1
+#define ISOTP_PCI_CONSECUTIVE     0x2
+#define ISOTP_PCI_FLOW_CONTROL    0x3
+
+/* Flow status, low nibble of a flow control frame */
+#define ISOTP_FS_CONTINUE         0x0
+#define ISOTP_FS_WAIT             0x1
+#define ISOTP_FS_OVERFLOW         0x2
+
+/* Private macro -------------------------------------------------------------*/
+#define ISOTP_MIN(a, b)           ((a) < (b) ? (a) : (b))
+
+/* Private function prototypes -----------------------------------------------*/
+static uint8_t IsoTp_SendFrame(IsoTp_Link_t* link, uint8_t* frame, uint8_t length);
+static uint8_t IsoTp_SendFlowControl(IsoTp_Link_t* link, uint8_t status);
+static uint8_t IsoTp_SendConsecutive(IsoTp_Link_t* link);
+static uint32_t IsoTp_DecodeSeparation(uint8_t stMin);
+
+/**
+  * @brief  Initialize a link
+  * @note   The link asks for frames back to back and without further flow
+  *         control, which is what a main loop that drains the CAN receive
+  *         queue every pass can take.
+  * @param  link: Link to initialize
+  * @param  rxId: CAN identifier of frames from the peer
+  * @param  txId: CAN identifier of frames to the peer
+  * @param  buffer: Holds the received message, then the response
+  * @param  bufferSize: Longest message in either direction
+  * @retval None
+  */
+void IsoTp_Init(IsoTp_Link_t* link, uint32_t rxId, uint32_t txId, uint8_t* buffer, uint16_t bufferSize)
+{
+  memset(link, 0, sizeof(IsoTp_Link_t));
+  
+  link->rxId = rxId;
+  link->txId = txId;
+  link->buffer = buffer;
+  link->bufferSize = ISOTP_MIN(bufferSize, ISOTP_MAX_MESSAGE);
+  link->state = ISOTP_STATE_IDLE;
+}
+
+/**
+  * @brief  Set the flow control the link sends as receiver
+  * @param  link: Link
+  * @param  blockSize: Consecutive frames per flow control, 0 for one flow control per message
+  * @param  stMin: Minimum gap between consecutive frames, 0x00-0x7F ms or 0xF1-0xF9 for 100-900 us
+  * @retval None
+  */
+void IsoTp_SetFlowControl(IsoTp_Link_t* link, uint8_t blockSize, uint8_t stMin)
+{
+  link->blockSize = blockSize;
+  link->stMin = stMin;
+}
+
+/**
+  * @brief  Handle a frame received on the link's receive identifier
+  * @note   A single or first frame always starts a new message; the peer
+  *         has given up on whatever was in progress.
+  * @param  link: Link
+  * @param  data: Frame data
+  * @param  length: Frame length
+  * @retval None
+  */
+void IsoTp_Receive(IsoTp_Link_t* link, const uint8_t* data, uint8_t length)
+{
+  if (length == 0) {
+    return;
+  }
+  
+  switch (data[0] >> 4) {
+    case ISOTP_PCI_SINGLE: {
+      uint8_t size = data[0] & 0x0F;
+      
+      if (size == 0 || size > ISOTP_SF_MAX || size > length - 1 || size > link->bufferSize) {
+        link->errors++;
+        return;
+      }
+      
+      memcpy(link->buffer, &data[1], size);
+      link->length = size;
+      link->state = ISOTP_STATE_RECEIVED;
+      link->rxMessages++;
+      break;
+    }
+    
+    case ISOTP_PCI_FIRST: {
+      uint16_t size = ((data[0] & 0x0F) << 8) | data[1];
+      
+      if (length < ISOTP_FRAME_SIZE || size <= ISOTP_SF_MAX) {
+        link->errors++;
+        return;
+      }
+      
+      if (size > link->bufferSize) {
+        link->errors++;
+        link->state = ISOTP_STATE_IDLE;
+        IsoTp_SendFlowControl(link, ISOTP_FS_OVERFLOW);
+        return;
+      }
+      
+      memcpy(link->buffer, &data[2], ISOTP_FF_DATA);
+      link->length = size;
+      link->offset = ISOTP_FF_DATA;
+      link->sequence = 1;
+      link->blockCount = link->blockSize;
+      link->state = ISOTP_STATE_RECEIVING;
+      link->tick = HAL_GetTick();
+      
+      if (!IsoTp_SendFlowControl(link, ISOTP_FS_CONTINUE)) {
+        link->errors++;
+        link->state = ISOTP_STATE_IDLE;
+      }
+      break;
+    }
+    
+    case ISOTP_PCI_CONSECUTIVE: {
+      if (link->state != ISOTP_STATE_RECEIVING) {
+        return;
+      }
+      
+      /* A lost frame cannot be asked for again, drop the message */
+      if ((data[0] & 0x0F) != link->sequence) {
+        link->errors++;
+        link->state = ISOTP_STATE_IDLE;
+        return;
+      }
+      
+      uint16_t count = ISOTP_MIN(ISOTP_MIN(length - 1, ISOTP_CF_DATA), link->length - link->offset);
+      
+      memcpy(&link->buffer[link->offset], &data[1], count);
+      link->offset += count;
+      link->sequence = (link->sequence + 1) & 0x0F;
+      link->tick = HAL_GetTick();
+      
+      if (link->offset >= link->length) {
+        link->state = ISOTP_STATE_RECEIVED;
+        link->rxMessages++;
+      } else if (link->blockSize > 0 && --link->blockCount == 0) {
+        link->blockCount = link->blockSize;
+        IsoTp_SendFlowControl(link, ISOTP_FS_CONTINUE);
+      }
+      break;
+    }
+    
+    case ISOTP_PCI_FLOW_CONTROL: {
+      if (link->state != ISOTP_STATE_WAIT_FC || length < 3) {
+        return;
+      }
+      
+      switch (data[0] & 0x0F) {
+        case ISOTP_FS_CONTINUE:
+          link->blockCount = data[1];
+          link->separation = IsoTp_DecodeSeparation(data[2]);
+          link->lastMicros = Boot_Monitor_GetMicros() - link->separation;
+          link->state = ISOTP_STATE_SENDING;
+          link->tick = HAL_GetTick();
+          break;
+        
+        case ISOTP_FS_WAIT:
+          link->tick = HAL_GetTick();
+          break;
+        
+        default:
+          link->errors++;
+          link->state = ISOTP_STATE_IDLE;
+          break;
+      }
+      break;
+    }
+    
+    default:
+      break;
+  }
+}
+
+/**
+  * @brief  Link process function, should be called every main loop pass
+  * @note   Queues up to one consecutive frame per CAN mailbox per pass when
+  *         the receiver allows back to back frames, or one frame per STmin,
+  *         and ends transfers whose peer went quiet or whose frames could
+  *         not be queued, for instance because CAN output was disabled.
+  * @param  link: Link
+  * @retval None
+  */
+void IsoTp_Process(IsoTp_Link_t* link)
+{
+  switch (link->state) {
+    case ISOTP_STATE_RECEIVING:
+    case ISOTP_STATE_WAIT_FC:
+      if (HAL_GetTick() - link->tick > ISOTP_TIMEOUT_MS) {
+        link->errors++;
+        link->state = ISOTP_STATE_IDLE;
+      }
+      break;
+    
+    case ISOTP_STATE_SENDING:
+      for (uint8_t burst = 0; burst < ISOTP_TX_BURST && link->state == ISOTP_STATE_SENDING; burst++) {
+        uint32_t now = Boot_Monitor_GetMicros();
+      
+        if (link->separation > 0 && now - link->lastMicros < link->separation) {
+          break;
+        }
+      
+        /* Transmit queue full, try again next pass */
+        if (!IsoTp_SendConsecutive(link)) {
+          break;
+        }
+      
+        link->lastMicros = now;
+      
+        if (link->separation > 0) {
+          break;
+        }
+      }
+      
+      if (link->state == ISOTP_STATE_SENDING && HAL_GetTick() - link->tick > ISOTP_TIMEOUT_MS) {
+        link->errors++;
+        link->state = ISOTP_STATE_IDLE;
+      }
+      break;
+    
+    default:
+      break;
+  }
+}
+
+/**
+  * @brief  Take a received message
+  * @note   The message stays in the link buffer until the next IsoTp_Send
+  *         or a new message from the peer.
+  * @param  link: Link
+  * @retval uint16_t: Message length, 0 if no message is complete
+  */
+uint16_t IsoTp_Take(IsoTp_Link_t* link)
+{
+  if (link->state != ISOTP_STATE_RECEIVED) {
+    return 0;
+  }
+  
+  link->state = ISOTP_STATE_IDLE;
+  
+  return link->length;
+}
+
+/**
+  * @brief  Start sending the message in the link buffer
+  * @param  link: Link
+  * @param  length: Message length
+  * @retval uint8_t: 1 if the transfer started, 0 if the link is busy or the length is invalid
+  */
+uint8_t IsoTp_Send(IsoTp_Link_t* link, uint16_t length)
+{
+  uint8_t frame[ISOTP_FRAME_SIZE];
+  
+  if (link->state == ISOTP_STATE_RECEIVING || link->state == ISOTP_STATE_SENDING ||
+      link->state == ISOTP_STATE_WAIT_FC || length == 0 || length > link->bufferSize) {
+    return 0;
+  }
+  
+  if (length <= ISOTP_SF_MAX) {
+    frame[0] = (ISOTP_PCI_SINGLE << 4) | length;
+    memcpy(&frame[1], link->buffer, length);
+    
+    if (!IsoTp_SendFrame(link, frame, length + 1)) {
+      return 0;
+    }
+    
+    link->state = ISOTP_STATE_IDLE;
+    link->txMessages++;
+    return 1;
+  }
+  
+  frame[0] = (ISOTP_PCI_FIRST << 4) | (length >> 8);
+  frame[1] = (uint8_t)length;
+  memcpy(&frame[2], link->buffer, ISOTP_FF_DATA);
+  
+  if (!IsoTp_SendFrame(link, frame, ISOTP_FRAME_SIZE)) {
+    return 0;
+  }
+  
+  link->length = length;
+  link->offset = ISOTP_FF_DATA;
+  link->sequence = 1;
+  link->state = ISOTP_STATE_WAIT_FC;
+  link->tick = HAL_GetTick();
+  
+  return 1;
+}
+
+/**
+  * @brief  Check whether the link is free for a new message
+  * @param  link: Link
+  * @retval uint8_t: 1 if nothing is being sent or received, 0 otherwise
+  */
+uint8_t IsoTp_IsIdle(const IsoTp_Link_t* link)
+{
+  return link->state == ISOTP_STATE_IDLE;
+}
+
+/**
+  * @brief  Queue a frame, padded to 8 bytes
+  * @param  link: Link
+  * @param  frame: Frame buffer of 8 bytes
+  * @param  length: Bytes used, the rest is padded
+  * @retval uint8_t: 1 if queued, 0 if the transmit queue is full
+  */
+static uint8_t IsoTp_SendFrame(IsoTp_Link_t* link, uint8_t* frame, uint8_t length)
+{
+  memset(&frame[length], ISOTP_PADDING, ISOTP_FRAME_SIZE - length);
+  
+  return Output_Manager_SendCAN(link->txId, frame, ISOTP_FRAME_SIZE);
+}
+
+/**
+  * @brief  Send a flow control frame with the link's block size and STmin
+  * @param  link: Link
+  * @param  status: Flow status
+  * @retval uint8_t: 1 if queued, 0 if the transmit queue is full
+  */
+static uint8_t IsoTp_SendFlowControl(IsoTp_Link_t* link, uint8_t status)
+{
+  uint8_t frame[ISOTP_FRAME_SIZE] = {(ISOTP_PCI_FLOW_CONTROL << 4) | status, link->blockSize, link->stMin};
+  
+  return IsoTp_SendFrame(link, frame, 3);
+}
+
+/**
+  * @brief  Send the next consecutive frame
+  * @param  link: Link in the sending state
+  * @retval uint8_t: 1 if queued, 0 if the transmit queue is full
+  */
+static uint8_t IsoTp_SendConsecutive(IsoTp_Link_t* link)
+{
+  uint8_t frame[ISOTP_FRAME_SIZE];
+  uint16_t count = ISOTP_MIN(link->length - link->offset, ISOTP_CF_DATA);
+  
+  frame[0] = (ISOTP_PCI_CONSECUTIVE << 4) | link->sequence;
+  memcpy(&frame[1], &link->buffer[link->offset], count);
+  
+  if (!IsoTp_SendFrame(link, frame, count + 1)) {
+    return 0;
+  }
+  
+  link->offset += count;
+  link->sequence = (link->sequence + 1) & 0x0F;
+  link->tick = HAL_GetTick();
+  
+  if (link->offset >= link->length) {
+    link->state = ISOTP_STATE_IDLE;
+    link->txMessages++;
+  } else if (link->blockCount > 0 && --link->blockCount == 0) {
+    link->state = ISOTP_STATE_WAIT_FC;
+    link->tick = HAL_GetTick();
+  }
+  
+  return 1;
+}
+
+/**
+  * @brief  Convert an STmin byte into microseconds
+  * @param  stMin: STmin from a flow control frame
+  * @retval uint32_t: Separation time in us, reserved values mean the longest
+  */
+static uint32_t IsoTp_DecodeSeparation(uint8_t stMin)
+{
+  if (stMin <= 0x7F) {
+    return stMin * 1000UL;
+  }
+  
+  if (stMin >= 0xF1 && stMin <= 0xF9) {
+    return (stMin - 0xF0) * 100UL;
+  }
+  
+  return 0x7F * 1000UL;
+}
@@ -15,14 +15,25 @@
 #include "input_manager.h"
 #include "mapping_engine.h"
 #include "output_manager.h"
+#include "timer_wheel.h"
+#include "config_store.h"
+#include "display_manager.h"
+#include "web_server.h"
+#include "boot_monitor.h"
+#include "rx_cache.h"
+#include "data_logger.h"
+#include "tunerstudio.h"
+#include "uds_server.h"
 
 /* Private typedef -----------------------------------------------------------*/
 /* Private define ------------------------------------------------------------*/
+#define CONFIG_ERASE_QUIET_MS     2000  /* TunerStudio and UDS links quiet this long before an erase */
 /* Private macro -------------------------------------------------------------*/
 /* Private variables ---------------------------------------------------------*/
 /* Private function prototypes -----------------------------------------------*/
 static void SystemClock_Config(void);
 static void GPIO_Init(void);
+static uint8_t Config_EraseAllowed(void);
 static void Error_Handler(void);
 
 /* External variables --------------------------------------------------------*/
@@ -37,22 +48,43 @@ int main(void)
 
   /* Reset of all peripherals, Initializes the Flash interface and the Systick. */
   HAL_Init();
+  Boot_Monitor_Init();
 
   /* Configure the system clock */
   SystemClock_Config();
+  Boot_Monitor_Mark(BOOT_PHASE_CLOCK);
 
   /* Initialize all configured peripherals */
   GPIO_Init();
 
-  /* Initialize modules */
+  /* Initialize modules, the config store first as the others load from it */
+  Config_Store_Init();
+  Boot_Monitor_Mark(BOOT_PHASE_CONFIG);
+  Timer_Wheel_Init();
+
+  /* CAN output goes live before anything slower is started, the receive
+     interrupts it enables write to the value cache and the data logger */
+  Rx_Cache_Init();
+  Data_Logger_Init();
+  Output_Manager_Init();
+  Boot_Monitor_Mark(BOOT_PHASE_CAN_READY);
+
+  /* None of these wait, USB enumeration, the display power-up and network
+     bring-up continue from the main loop */
   Input_Manager_Init();
   Mapping_Engine_Init();
-  Output_Manager_Init();
+  Display_Manager_Init();
+  Web_Server_Init();
+  TS_Init();
+  Uds_Server_Init();
 
   /* Turn on LED to indicate successful initialization */
   HAL_GPIO_WritePin(LED_GPIO_PORT, LED_PIN, GPIO_PIN_SET);
+  Boot_Monitor_Mark(BOOT_PHASE_LOOP);
 
   /* Infinite loop */
+  uint32_t ledTick = HAL_GetTick();
+
   while (1)
   {
     /* Process input manager */
@@ -61,14 +93,33 @@ int main(void)
     /* Process mapping engine */
     Mapping_Engine_Process();
     
+    /* Run expired combo and macro timers */
+    Timer_Wheel_Process();
+    
     /* Process output manager */
     Output_Manager_Process();
     
-    /* Toggle LED to indicate system is running */
-    HAL_GPIO_TogglePin(LED_GPIO_PORT, LED_PIN);
+    /* Process display and web server */
+    Display_Manager_Process();
+    Web_Server_Process();
+    
+    /* Answer TunerStudio requests received since the last pass */
+    TS_Process();
+    
+    /* Answer diagnostic requests from scan tools */
+    Uds_Server_Process();
+    
+    /* Erase the spare config sector after a compaction */
+    Config_Store_Process(Config_EraseAllowed());
     
-    /* Small delay */
-    HAL_Delay(100);
+    /* Send boot phase timestamps as they become available */
+    Boot_Monitor_Process();
+    
+    /* Toggle LED to indicate system is running, the loop itself never waits */
+    if (HAL_GetTick() - ledTick >= 100) {
+      ledTick = HAL_GetTick();
+      HAL_GPIO_TogglePin(LED_GPIO_PORT, LED_PIN);
+    }
   }
 }
 
@@ -136,6 +187,29 @@ static void GPIO_Init(void)
   HAL_GPIO_Init(LED_GPIO_PORT, &GPIO_InitStruct);
 }
 
+/**
+  * @brief  Check whether a config sector erase would go unnoticed now
+  * @note   The CAN receive FIFO overflows after three frames of a 1-2 s
+  *         erase. It is only started with the CAN queues and the serial
+  *         output empty and with the TunerStudio and UDS links quiet for
+  *         CONFIG_ERASE_QUIET_MS, which also keeps it out of the first
+  *         seconds after boot.
+  * @param  None
+  * @retval uint8_t: 1 if the spare sector may be erased, 0 otherwise
+  */
+static uint8_t Config_EraseAllowed(void)
+{
+  Output_Manager_Stats_t outputStats;
+  
+  Output_Manager_GetStats(&outputStats);
+  
+  if (outputStats.canRxQueued != 0 || outputStats.canTxQueued != 0 || outputStats.serialTxQueued != 0) {
+    return 0;
+  }
+  
+  return TS_IsIdle(CONFIG_ERASE_QUIET_MS) && Uds_Server_IsIdle(CONFIG_ERASE_QUIET_MS);
+}
+
 /**
   * @brief  This function is executed in case of error occurrence.
   * @retval None
@@ -0,0 +1,397 @@
+/**
+ * @file mapping_combo.c
+ * @brief Chord, tap/hold, double-tap and macro handling for the Mapping Engine of STM32F407 HID to Serial/CAN project
+ * @author Manus AI
+ * @date 2025-03-28
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "mapping_combo.h"
+#include "main.h"
+#include <stdint.h>
+#include <string.h>
+
+/* Private typedef -----------------------------------------------------------*/
+typedef enum {
+  COMBO_STATE_IDLE = 0,
+  COMBO_STATE_PRESSED,    /* Tap/hold: waiting for release or hold timeout */
+  COMBO_STATE_HELD,       /* Tap/hold: hold action sent, waiting for release */
+  COMBO_STATE_ARMED,      /* Double-tap: first tap seen, waiting for the second */
+  COMBO_STATE_FIRED,      /* Chord: action sent, waiting for all keys to be released */
+  COMBO_STATE_EXPIRED     /* Chord: window missed, waiting for all keys to be released */
+} Combo_State_t;
+
+typedef struct {
+  Combo_State_t state;
+  uint8_t keysDown;       /* One bit per entry in keys[] */
+  Timer_Wheel_Timer_t timer;
+} Combo_Runtime_t;
+
+typedef struct {
+  uint8_t macroIndex;     /* 0xFF when the player is free */
+  uint8_t step;
+  Timer_Wheel_Timer_t timer;
+} Macro_Player_t;
+
+/* Private define ------------------------------------------------------------*/
+#define MACRO_PLAYER_FREE         0xFF
+
+/* Private macro -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+static Mapping_Combo_t combos[MAPPING_COMBO_MAX_COMBOS];
+static Combo_Runtime_t comboRuntime[MAPPING_COMBO_MAX_COMBOS];
+static Mapping_Macro_t macros[MAPPING_MACRO_MAX_MACROS];
+static Macro_Player_t macroPlayers[MAPPING_MACRO_MAX_PLAYERS];
+
+/* Private function prototypes -----------------------------------------------*/
+static void Mapping_Combo_HandleKey(uint8_t comboIndex, uint8_t keyIndex, uint8_t pressed);
+static void Mapping_Combo_TimerCallback(void* context);
+static void Mapping_Combo_MacroTimerCallback(void* context);
+static void Mapping_Combo_RunMacro(Macro_Player_t* player);
+static void Mapping_Combo_SendAction(const Mapping_Combo_Action_t* action);
+
+/**
+  * @brief  Combo engine initialization function
+  * @param  None
+  * @retval None
+  */
+void Mapping_Combo_Init(void)
+{
+  for (uint8_t i = 0; i < MAPPING_COMBO_MAX_COMBOS; i++) {
+    Timer_Wheel_Stop(&comboRuntime[i].timer);
+  }
+  
+  Mapping_Combo_StopMacros();
+  
+  memset(combos, 0, sizeof(combos));
+  memset(comboRuntime, 0, sizeof(comboRuntime));
+  memset(macros, 0, sizeof(macros));
+}
+
+/**
+  * @brief  Feed an input event into the combo state machines
+  * @param  inputEvent: Pointer to input event structure
+  * @retval None
+  */
+void Mapping_Combo_ProcessEvent(Input_Event_t* inputEvent)
+{
+  if (inputEvent == NULL) {
+    return;
+  }
+  
+  /* Releases are matched against the press event type of the key */
+  Input_Event_Type_t eventType = inputEvent->eventType;
+  uint8_t pressed = 1;
+  if (eventType == INPUT_EVENT_KEY_RELEASE) {
+    eventType = INPUT_EVENT_KEY_PRESS;
+    pressed = 0;
+  } else if (eventType == INPUT_EVENT_BUTTON_RELEASE) {
+    eventType = INPUT_EVENT_BUTTON_PRESS;
+    pressed = 0;
+  } else if (eventType != INPUT_EVENT_KEY_PRESS && eventType != INPUT_EVENT_BUTTON_PRESS) {
+    return;
+  }
+  
+  for (uint8_t i = 0; i < MAPPING_COMBO_MAX_COMBOS; i++) {
+    if (!combos[i].enabled) {
+      continue;
+    }
+    
+    for (uint8_t k = 0; k < combos[i].keyCount; k++) {
+      const Mapping_Combo_Key_t* key = &combos[i].keys[k];
+      
+      if (key->deviceIndex == inputEvent->deviceIndex &&
+          key->eventType == eventType &&
+          key->inputId == inputEvent->inputId) {
+        Mapping_Combo_HandleKey(i, k, pressed);
+        break;
+      }
+    }
+  }
+}
+
+/**
+  * @brief  Add a combo
+  * @param  combo: Pointer to combo structure
+  * @retval uint8_t: Index of the new combo, 0xFF if failed
+  */
+uint8_t Mapping_Combo_Add(const Mapping_Combo_t* combo)
+{
+  if (combo == NULL || combo->type == COMBO_TYPE_NONE ||
+      combo->keyCount == 0 || combo->keyCount > MAPPING_COMBO_MAX_KEYS) {
+    return 0xFF;
+  }
+  
+  /* Tap/hold and double-tap work on a single key and need a time limit */
+  if (combo->type != COMBO_TYPE_CHORD && (combo->keyCount != 1 || combo->timeoutMs == 0)) {
+    return 0xFF;
+  }
+  
+  /* Find an empty slot */
+  for (uint8_t i = 0; i < MAPPING_COMBO_MAX_COMBOS; i++) {
+    if (!combos[i].enabled) {
+      memcpy(&combos[i], combo, sizeof(Mapping_Combo_t));
+      combos[i].enabled = 1;
+      
+      Timer_Wheel_Stop(&comboRuntime[i].timer);
+      comboRuntime[i].state = COMBO_STATE_IDLE;
+      comboRuntime[i].keysDown = 0;
+      
+      return i;
+    }
+  }
+  
+  /* No empty slot found */
+  return 0xFF;
+}
+
+/**
+  * @brief  Remove a combo
+  * @param  comboIndex: Index of the combo to remove
+  * @retval uint8_t: 1 if successful, 0 if failed
+  */
+uint8_t Mapping_Combo_Remove(uint8_t comboIndex)
+{
+  if (comboIndex >= MAPPING_COMBO_MAX_COMBOS || !combos[comboIndex].enabled) {
+    return 0;
+  }
+  
+  Timer_Wheel_Stop(&comboRuntime[comboIndex].timer);
+  combos[comboIndex].enabled = 0;
+  
+  return 1;
+}
+
+/**
+  * @brief  Get a combo
+  * @param  comboIndex: Index of the combo
+  * @retval Mapping_Combo_t*: Pointer to the combo, NULL if not found
+  */
+Mapping_Combo_t* Mapping_Combo_Get(uint8_t comboIndex)
+{
+  if (comboIndex >= MAPPING_COMBO_MAX_COMBOS || !combos[comboIndex].enabled) {
+    return NULL;
+  }
+  
+  return &combos[comboIndex];
+}
+
+/**
+  * @brief  Store a macro
+  * @note   Running instances of the macro are stopped first.
+  * @param  macroIndex: Index of the macro
+  * @param  macro: Pointer to macro structure, NULL to clear the macro
+  * @retval uint8_t: 1 if successful, 0 if failed
+  */
+uint8_t Mapping_Combo_SetMacro(uint8_t macroIndex, const Mapping_Macro_t* macro)
+{
+  if (macroIndex >= MAPPING_MACRO_MAX_MACROS ||
+      (macro != NULL && macro->stepCount > MAPPING_MACRO_MAX_STEPS)) {
+    return 0;
+  }
+  
+  for (uint8_t i = 0; i < MAPPING_MACRO_MAX_PLAYERS; i++) {
+    if (macroPlayers[i].macroIndex == macroIndex) {
+      Timer_Wheel_Stop(&macroPlayers[i].timer);
+      macroPlayers[i].macroIndex = MACRO_PLAYER_FREE;
+    }
+  }
+  
+  if (macro == NULL) {
+    memset(&macros[macroIndex], 0, sizeof(Mapping_Macro_t));
+  } else {
+    memcpy(&macros[macroIndex], macro, sizeof(Mapping_Macro_t));
+  }
+  
+  return 1;
+}
+
+/**
+  * @brief  Start playing a macro
+  * @note   Steps without delay are sent immediately, the rest are scheduled on
+  *         the timer wheel so the caller never waits for the macro to finish.
+  * @param  macroIndex: Index of the macro
+  * @retval uint8_t: 1 if successful, 0 if failed
+  */
+uint8_t Mapping_Combo_StartMacro(uint8_t macroIndex)
+{
+  if (macroIndex >= MAPPING_MACRO_MAX_MACROS || macros[macroIndex].stepCount == 0) {
+    return 0;
+  }
+  
+  for (uint8_t i = 0; i < MAPPING_MACRO_MAX_PLAYERS; i++) {
+    if (macroPlayers[i].macroIndex == MACRO_PLAYER_FREE) {
+      macroPlayers[i].macroIndex = macroIndex;
+      macroPlayers[i].step = 0;
+      Mapping_Combo_RunMacro(&macroPlayers[i]);
+      return 1;
+    }
+  }
+  
+  /* All players busy */
+  return 0;
+}
+
+/**
+  * @brief  Stop all running macros
+  * @param  None
+  * @retval None
+  */
+void Mapping_Combo_StopMacros(void)
+{
+  for (uint8_t i = 0; i < MAPPING_MACRO_MAX_PLAYERS; i++) {
+    Timer_Wheel_Stop(&macroPlayers[i].timer);
+    macroPlayers[i].macroIndex = MACRO_PLAYER_FREE;
+  }
+}
+
+/**
+  * @brief  Advance the state machine of a combo for a key press or release
+  * @param  comboIndex: Index of the combo
+  * @param  keyIndex: Index of the key within the combo
+  * @param  pressed: 1 for press, 0 for release
+  * @retval None
+  */
+static void Mapping_Combo_HandleKey(uint8_t comboIndex, uint8_t keyIndex, uint8_t pressed)
+{
+  const Mapping_Combo_t* combo = &combos[comboIndex];
+  Combo_Runtime_t* runtime = &comboRuntime[comboIndex];
+  uint8_t allKeys = (uint8_t)((1U << combo->keyCount) - 1);
+  
+  if (pressed) {
+    runtime->keysDown |= (uint8_t)(1U << keyIndex);
+  } else {
+    runtime->keysDown &= (uint8_t)~(1U << keyIndex);
+  }
+  
+  switch (combo->type) {
+    case COMBO_TYPE_CHORD:
+      if (runtime->keysDown == 0) {
+        Timer_Wheel_Stop(&runtime->timer);
+        runtime->state = COMBO_STATE_IDLE;
+      } else if (pressed && runtime->state == COMBO_STATE_IDLE) {
+        if (runtime->keysDown == allKeys) {
+          Timer_Wheel_Stop(&runtime->timer);
+          runtime->state = COMBO_STATE_FIRED;
+          Mapping_Combo_SendAction(&combo->actions[0]);
+        } else if (combo->timeoutMs != 0 && !Timer_Wheel_IsActive(&runtime->timer)) {
+          /* Window starts with the first key of the chord */
+          Timer_Wheel_Start(&runtime->timer, combo->timeoutMs, Mapping_Combo_TimerCallback, runtime);
+        }
+      }
+      break;
+    
+    case COMBO_TYPE_TAP_HOLD:
+      if (pressed && runtime->state == COMBO_STATE_IDLE) {
+        runtime->state = COMBO_STATE_PRESSED;
+        Timer_Wheel_Start(&runtime->timer, combo->timeoutMs, Mapping_Combo_TimerCallback, runtime);
+      } else if (!pressed) {
+        if (runtime->state == COMBO_STATE_PRESSED) {
+          Timer_Wheel_Stop(&runtime->timer);
+          Mapping_Combo_SendAction(&combo->actions[0]);
+        }
+        runtime->state = COMBO_STATE_IDLE;
+      }
+      break;
+    
+    case COMBO_TYPE_DOUBLE_TAP:
+      if (pressed) {
+        if (runtime->state == COMBO_STATE_ARMED) {
+          Timer_Wheel_Stop(&runtime->timer);
+          runtime->state = COMBO_STATE_IDLE;
+          Mapping_Combo_SendAction(&combo->actions[1]);
+        } else {
+          runtime->state = COMBO_STATE_ARMED;
+          Timer_Wheel_Start(&runtime->timer, combo->timeoutMs, Mapping_Combo_TimerCallback, runtime);
+        }
+      }
+      break;
+    
+    default:
+      break;
+  }
+}
+
+/**
+  * @brief  Timer expiry for a combo
+  * @param  context: Pointer to the combo runtime state
+  * @retval None
+  */
+static void Mapping_Combo_TimerCallback(void* context)
+{
+  Combo_Runtime_t* runtime = (Combo_Runtime_t*)context;
+  const Mapping_Combo_t* combo = &combos[runtime - comboRuntime];
+  
+  switch (runtime->state) {
+    case COMBO_STATE_IDLE:
+      /* Chord window missed, ignore the chord until all keys are released */
+      if (combo->type == COMBO_TYPE_CHORD) {
+        runtime->state = COMBO_STATE_EXPIRED;
+      }
+      break;
+    
+    case COMBO_STATE_PRESSED:
+      runtime->state = COMBO_STATE_HELD;
+      Mapping_Combo_SendAction(&combo->actions[1]);
+      break;
+    
+    case COMBO_STATE_ARMED:
+      runtime->state = COMBO_STATE_IDLE;
+      Mapping_Combo_SendAction(&combo->actions[0]);
+      break;
+    
+    default:
+      break;
+  }
+}
+
+/**
+  * @brief  Timer expiry for a macro player
+  * @param  context: Pointer to the macro player
+  * @retval None
+  */
+static void Mapping_Combo_MacroTimerCallback(void* context)
+{
+  Mapping_Combo_RunMacro((Macro_Player_t*)context);
+}
+
+/**
+  * @brief  Send macro steps until one asks for a delay or the macro ends
+  * @param  player: Pointer to the macro player
+  * @retval None
+  */
+static void Mapping_Combo_RunMacro(Macro_Player_t* player)
+{
+  const Mapping_Macro_t* macro = &macros[player->macroIndex];
+  
+  while (player->step < macro->stepCount) {
+    const Mapping_Macro_Step_t* step = &macro->steps[player->step++];
+    
+    Mapping_Combo_SendAction(&step->action);
+    
+    /* A macro step may have stopped this player */
+    if (player->macroIndex == MACRO_PLAYER_FREE) {
+      return;
+    }
+    
+    if (step->delayMs != 0 && player->step < macro->stepCount) {
+      Timer_Wheel_Start(&player->timer, step->delayMs, Mapping_Combo_MacroTimerCallback, player);
+      return;
+    }
+  }
+  
+  /* Macro finished */
+  player->macroIndex = MACRO_PLAYER_FREE;
+}
+
+/**
+  * @brief  Send the output of a combo or macro action
+  * @param  action: Pointer to action
+  * @retval None
+  */
+static void Mapping_Combo_SendAction(const Mapping_Combo_Action_t* action)
+{
+  if (action->outputType != OUTPUT_TYPE_NONE) {
+    Mapping_Engine_SendOutput(action->outputType, &action->output, action->value);
+  }
+}
@@ -13,26 +13,76 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include "input_manager.h"
+#include "mapping_expr.h"
+#include "mapping_combo.h"
+#include "output_manager.h"
+#include "config_store.h"
+#include "data_logger.h"
 
 /* Private typedef -----------------------------------------------------------*/
+/* Stored form of a profile header, the entries follow as separate records */
+typedef struct {
+  char name[MAPPING_PROFILE_NAME_SIZE];
+  uint8_t count;
+} Mapping_Stored_Profile_t;
+
+/* Stored form of one profile entry, one record per mapping so that changing
+   a mapping only rewrites that mapping */
+typedef struct {
+  uint32_t key;
+  int16_t minValue;
+  int16_t maxValue;
+  uint8_t outputType;
+  Mapping_Output_Config_t output;
+} Mapping_Stored_Entry_t;
+
 /* Private define ------------------------------------------------------------*/
-#define MAPPING_CONFIG_ADDR       0x08060000  /* Flash sector for configuration storage */
-#define MAPPING_CONFIG_SIZE       (sizeof(Input_Mapping_t) * MAX_MAPPINGS + 8)
+/* Storage of one profile entry across the key and payload arrays */
+#define MAPPING_PROFILE_ENTRY_SIZE  (sizeof(((Mapping_Profile_t*)0)->keys[0]) + \
+                                     sizeof(((Mapping_Profile_t*)0)->minValues[0]) + \
+                                     sizeof(((Mapping_Profile_t*)0)->maxValues[0]) + \
+                                     sizeof(((Mapping_Profile_t*)0)->outputTypes[0]) + \
+                                     sizeof(((Mapping_Profile_t*)0)->outputs[0]))
 
 /* Private macro -------------------------------------------------------------*/
+#ifdef MAPPING_STATIC_TABLE
+#define MAPPING_PROFILE_SLOT(index)  (&mappingTableProfiles[index])
+#else
+#define MAPPING_PROFILE_SLOT(index)  (profileSlots[index])
+#endif
+
 /* Private variables ---------------------------------------------------------*/
-Input_Mapping_t mappings[MAX_MAPPINGS];
-uint8_t mappingCount = 0;
+#ifndef MAPPING_STATIC_TABLE
+/* One buffer per profile plus a spare. The spare is the staging buffer that
+   edits are made in; committing swaps it with the profile slot it replaces. */
+static Mapping_Profile_t profileStore[MAX_MAPPING_PROFILES + 1];
+static Mapping_Profile_t* profileSlots[MAX_MAPPING_PROFILES];
+static Mapping_Profile_t* stagingProfile;
+static uint8_t stagingIndex = MAPPING_PROFILE_NONE;
+#endif
+
+/* Profile used for dispatch. Only written by Mapping_Engine_ApplyProfileSwitch
+   and Mapping_Engine_CommitProfile, both from main loop context. */
+static const Mapping_Profile_t* activeProfile;
+static uint8_t activeIndex = 0;
+
+/* Pending switch request, may be written from interrupt context */
+static volatile uint8_t requestedProfile = MAPPING_PROFILE_NONE;
+
+/* Dispatch cost, measured with the DWT cycle counter */
+static Mapping_Engine_Stats_t dispatchStats;
 
 /* Private function prototypes -----------------------------------------------*/
 static void Mapping_Engine_InputCallback(Input_Event_t* inputEvent);
-static void Mapping_Engine_ProcessMapping(Input_Mapping_t* mapping, Input_Event_t* inputEvent);
-static uint8_t Mapping_Engine_SendSerialOutput(Input_Mapping_t* mapping, int16_t value);
-static uint8_t Mapping_Engine_SendCANOutput(Input_Mapping_t* mapping, int16_t value);
-
-/* External variables --------------------------------------------------------*/
-extern void Output_Manager_SendSerial(uint8_t* data, uint8_t length);
-extern void Output_Manager_SendCAN(uint32_t canId, uint8_t* data, uint8_t length);
+static void Mapping_Engine_CANRxCallback(uint32_t canId, uint8_t* data, uint8_t length);
+static void Mapping_Engine_ApplyProfileSwitch(void);
+static void Mapping_Engine_DispatchEvent(const Mapping_Profile_t* profile, Input_Event_t* inputEvent);
+static uint8_t Mapping_Engine_LowerBound(const Mapping_Profile_t* profile, uint32_t key);
+#ifndef MAPPING_STATIC_TABLE
+static void Mapping_Engine_ClearProfile(Mapping_Profile_t* profile);
+#endif
+static uint8_t Mapping_Engine_SendSerialOutput(const Mapping_Output_Config_t* output, int16_t value);
+static uint8_t Mapping_Engine_SendCANOutput(const Mapping_Output_Config_t* output, int16_t value);
 
 /**
   * @brief  Mapping Engine initialization function
@@ -41,16 +91,40 @@ extern void Output_Manager_SendCAN(uint32_t canId, uint8_t* data, uint8_t length
   */
 void Mapping_Engine_Init(void)
 {
-  /* Initialize mappings array */
-  for (uint8_t i = 0; i < MAX_MAPPINGS; i++) {
-    mappings[i].enabled = 0;
+#ifndef MAPPING_STATIC_TABLE
+  /* Initialize profile buffers, the last one starts out as staging buffer */
+  for (uint8_t i = 0; i < MAX_MAPPING_PROFILES; i++) {
+    Mapping_Engine_ClearProfile(&profileStore[i]);
+    profileSlots[i] = &profileStore[i];
   }
   
-  mappingCount = 0;
+  stagingProfile = &profileStore[MAX_MAPPING_PROFILES];
+  Mapping_Engine_ClearProfile(stagingProfile);
+  stagingIndex = MAPPING_PROFILE_NONE;
+#endif
+  
+  /* Generated tables are used in place, there is nothing to load */
+  activeIndex = 0;
+  activeProfile = MAPPING_PROFILE_SLOT(0);
+  requestedProfile = MAPPING_PROFILE_NONE;
+  
+  /* Enable the cycle counter for dispatch statistics */
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+  Mapping_Engine_ResetStats();
+  
+  /* Initialize derived signal expressions */
+  Mapping_Expr_Init();
+  
+  /* Initialize chords, tap/hold, double-tap and macros */
+  Mapping_Combo_Init();
   
   /* Register callback for input events */
   Input_Manager_RegisterCallback(Mapping_Engine_InputCallback);
   
+  /* Register callback for profile switch commands on the CAN bus */
+  Output_Manager_RegisterCANRxCallback(Mapping_Engine_CANRxCallback);
+  
   /* Load configuration from flash */
   Mapping_Engine_LoadConfig();
 }
@@ -64,80 +138,145 @@ void Mapping_Engine_Process(void)
 {
   /* Process input events */
   while (Input_Manager_GetEventCount() > 0) {
+    /* Profile switches only take effect between events */
+    Mapping_Engine_ApplyProfileSwitch();
+    
     Input_Event_t* event = Input_Manager_GetNextEvent();
     
     if (event != NULL) {
-      /* Check all mappings for this event */
-      for (uint8_t i = 0; i < MAX_MAPPINGS; i++) {
-        if (mappings[i].enabled) {
-          Mapping_Engine_ProcessMapping(&mappings[i], event);
-        }
-      }
+      /* Run the mappings of the active profile for this event */
+      Mapping_Engine_DispatchEvent(activeProfile, event);
+      
+      /* Advance the combo state machines */
+      Mapping_Combo_ProcessEvent(event);
+      
+      /* Feed the event into the derived signal table */
+      Mapping_Expr_UpdateSignal(event);
     }
   }
+  
+  /* Pick up requests made while no events were pending */
+  Mapping_Engine_ApplyProfileSwitch();
+  
+  /* Re-evaluate expressions whose input signals changed during this pass */
+  Mapping_Expr_Process();
 }
 
 /**
-  * @brief  Add a new mapping
+  * @brief  Add a new mapping to the profile being edited
+  * @note   Opens an edit of the active profile if no edit is in progress.
+  *         Entries are kept in dispatch order, so indices of the entries
+  *         after the new one move up by one. The mapping takes effect on
+  *         Mapping_Engine_CommitProfile.
   * @param  mapping: Pointer to mapping structure
   * @retval uint8_t: Index of the new mapping, 0xFF if failed
   */
 uint8_t Mapping_Engine_AddMapping(Input_Mapping_t* mapping)
 {
+#ifdef MAPPING_STATIC_TABLE
+  /* Profiles are linked into flash and cannot be edited */
+  return 0xFF;
+#else
   if (mapping == NULL) {
     return 0xFF;
   }
   
-  /* Find an empty slot */
-  for (uint8_t i = 0; i < MAX_MAPPINGS; i++) {
-    if (!mappings[i].enabled) {
-      /* Copy mapping to the slot */
-      memcpy(&mappings[i], mapping, sizeof(Input_Mapping_t));
-      mappings[i].enabled = 1;
-      
-      /* Update mapping count */
-      mappingCount++;
-      
-      return i;
-    }
+  if (stagingIndex == MAPPING_PROFILE_NONE && !Mapping_Engine_EditProfile(activeIndex, 1)) {
+    return 0xFF;
   }
   
-  /* No empty slot found */
-  return 0xFF;
+  Mapping_Profile_t* profile = stagingProfile;
+  
+  if (profile->count >= MAX_MAPPINGS) {
+    return 0xFF;
+  }
+  
+  /* Insert after existing entries with the same key */
+  uint32_t key = MAPPING_KEY(mapping->deviceIndex, mapping->eventType, mapping->inputId);
+  uint8_t index = Mapping_Engine_LowerBound(profile, key + 1);
+  uint8_t tail = profile->count - index;
+  
+  memmove(&profile->keys[index + 1], &profile->keys[index], tail * sizeof(profile->keys[0]));
+  memmove(&profile->minValues[index + 1], &profile->minValues[index], tail * sizeof(profile->minValues[0]));
+  memmove(&profile->maxValues[index + 1], &profile->maxValues[index], tail * sizeof(profile->maxValues[0]));
+  memmove(&profile->outputTypes[index + 1], &profile->outputTypes[index], tail * sizeof(profile->outputTypes[0]));
+  memmove(&profile->outputs[index + 1], &profile->outputs[index], tail * sizeof(profile->outputs[0]));
+  
+  profile->keys[index] = key;
+  profile->minValues[index] = mapping->minValue;
+  profile->maxValues[index] = mapping->maxValue;
+  profile->outputTypes[index] = (uint8_t)mapping->outputType;
+  profile->outputs[index] = mapping->output;
+  profile->count++;
+  
+  return index;
+#endif
 }
 
 /**
-  * @brief  Remove a mapping
+  * @brief  Remove a mapping from the profile being edited
+  * @note   Opens an edit of the active profile if no edit is in progress.
+  *         Indices of the entries after the removed one move down by one.
+  *         The removal takes effect on Mapping_Engine_CommitProfile.
   * @param  mappingIndex: Index of the mapping to remove
   * @retval uint8_t: 1 if successful, 0 if failed
   */
 uint8_t Mapping_Engine_RemoveMapping(uint8_t mappingIndex)
 {
-  if (mappingIndex >= MAX_MAPPINGS || !mappings[mappingIndex].enabled) {
+#ifdef MAPPING_STATIC_TABLE
+  /* Profiles are linked into flash and cannot be edited */
+  return 0;
+#else
+  if (stagingIndex == MAPPING_PROFILE_NONE && !Mapping_Engine_EditProfile(activeIndex, 1)) {
+    return 0;
+  }
+  
+  Mapping_Profile_t* profile = stagingProfile;
+  
+  if (mappingIndex >= profile->count) {
     return 0;
   }
   
-  /* Disable the mapping */
-  mappings[mappingIndex].enabled = 0;
+  uint8_t tail = profile->count - mappingIndex - 1;
   
-  /* Update mapping count */
-  mappingCount--;
+  memmove(&profile->keys[mappingIndex], &profile->keys[mappingIndex + 1], tail * sizeof(profile->keys[0]));
+  memmove(&profile->minValues[mappingIndex], &profile->minValues[mappingIndex + 1], tail * sizeof(profile->minValues[0]));
+  memmove(&profile->maxValues[mappingIndex], &profile->maxValues[mappingIndex + 1], tail * sizeof(profile->maxValues[0]));
+  memmove(&profile->outputTypes[mappingIndex], &profile->outputTypes[mappingIndex + 1], tail * sizeof(profile->outputTypes[0]));
+  memmove(&profile->outputs[mappingIndex], &profile->outputs[mappingIndex + 1], tail * sizeof(profile->outputs[0]));
+  
+  profile->count--;
   
   return 1;
+#endif
 }
 
 /**
-  * @brief  Get a mapping
-  * @param  mappingIndex: Index of the mapping
-  * @retval Input_Mapping_t*: Pointer to the mapping, NULL if not found
+  * @brief  Get a mapping of the active profile
+  * @param  mappingIndex: Index of the mapping, 0 to Mapping_Engine_GetMappingCount() - 1
+  * @param  mapping: Pointer to structure receiving a copy of the mapping
+  * @retval uint8_t: 1 if successful, 0 if not found
   */
-Input_Mapping_t* Mapping_Engine_GetMapping(uint8_t mappingIndex)
+uint8_t Mapping_Engine_GetMapping(uint8_t mappingIndex, Input_Mapping_t* mapping)
 {
-  if (mappingIndex >= MAX_MAPPINGS || !mappings[mappingIndex].enabled) {
-    return NULL;
+  const Mapping_Profile_t* profile = activeProfile;
+  
+  if (mapping == NULL || mappingIndex >= profile->count) {
+    return 0;
   }
   
-  return &mappings[mappingIndex];
+  uint32_t key = profile->keys[mappingIndex];
+  
+  mapping->enabled = 1;
+  mapping->deviceIndex = MAPPING_KEY_DEVICE(key);
+  mapping->eventType = MAPPING_KEY_EVENT(key);
+  mapping->inputId = MAPPING_KEY_INPUT(key);
+  mapping->minValue = profile->minValues[mappingIndex];
+  mapping->maxValue = profile->maxValues[mappingIndex];
+  mapping->outputType = (Output_Type_t)profile->outputTypes[mappingIndex];
+  mapping->output = profile->outputs[mappingIndex];
+  
+  return 1;
 }
 
 /**
@@ -147,7 +286,183 @@ Input_Mapping_t* Mapping_Engine_GetMapping(uint8_t mappingIndex)
   */
 uint8_t Mapping_Engine_GetMappingCount(void)
 {
-  return mappingCount;
+  return activeProfile->count;
+}
+
+/**
+  * @brief  Start editing a profile in the staging buffer
+  * @note   Any edit already in progress is discarded.
+  * @param  profileIndex: Index of the profile to edit
+  * @param  copyExisting: 1 to start from the current contents, 0 to start empty
+  * @retval uint8_t: 1 if successful, 0 if failed
+  */
+uint8_t Mapping_Engine_EditProfile(uint8_t profileIndex, uint8_t copyExisting)
+{
+#ifdef MAPPING_STATIC_TABLE
+  /* Profiles are linked into flash and cannot be edited */
+  return 0;
+#else
+  if (profileIndex >= MAX_MAPPING_PROFILES) {
+    return 0;
+  }
+  
+  if (copyExisting) {
+    memcpy(stagingProfile, profileSlots[profileIndex], sizeof(Mapping_Profile_t));
+  } else {
+    Mapping_Engine_ClearProfile(stagingProfile);
+  }
+  
+  stagingIndex = profileIndex;
+  
+  return 1;
+#endif
+}
+
+/**
+  * @brief  Set the name of the profile being edited
+  * @param  name: Profile name, truncated to MAPPING_PROFILE_NAME_SIZE - 1 characters
+  * @retval uint8_t: 1 if successful, 0 if failed
+  */
+uint8_t Mapping_Engine_SetProfileName(const char* name)
+{
+#ifdef MAPPING_STATIC_TABLE
+  /* Profiles are linked into flash and cannot be edited */
+  return 0;
+#else
+  if (name == NULL || stagingIndex == MAPPING_PROFILE_NONE) {
+    return 0;
+  }
+  
+  strncpy(stagingProfile->name, name, MAPPING_PROFILE_NAME_SIZE - 1);
+  stagingProfile->name[MAPPING_PROFILE_NAME_SIZE - 1] = '\0';
+  
+  return 1;
+#endif
+}
+
+/**
+  * @brief  Publish the profile being edited
+  * @note   Must be called from main loop context. The finished buffer replaces
+  *         the profile slot and the buffer it replaces becomes the new staging
+  *         buffer, so the dispatcher never sees a partially built table.
+  * @param  None
+  * @retval uint8_t: 1 if successful, 0 if failed
+  */
+uint8_t Mapping_Engine_CommitProfile(void)
+{
+#ifdef MAPPING_STATIC_TABLE
+  /* Profiles are linked into flash and cannot be edited */
+  return 0;
+#else
+  if (stagingIndex == MAPPING_PROFILE_NONE) {
+    return 0;
+  }
+  
+  /* Swap the finished buffer in, it is kept in dispatch order while editing */
+  Mapping_Profile_t* previous = profileSlots[stagingIndex];
+  profileSlots[stagingIndex] = stagingProfile;
+  
+  if (stagingIndex == activeIndex) {
+    activeProfile = stagingProfile;
+  }
+  
+  stagingProfile = previous;
+  stagingIndex = MAPPING_PROFILE_NONE;
+  
+  return 1;
+#endif
+}
+
+/**
+  * @brief  Request a switch to another profile
+  * @note   Safe to call from interrupt context. The switch is applied by
+  *         Mapping_Engine_Process before the next input event is handled.
+  * @param  profileIndex: Index of the profile to activate
+  * @retval None
+  */
+void Mapping_Engine_SelectProfile(uint8_t profileIndex)
+{
+  if (profileIndex < MAX_MAPPING_PROFILES) {
+    requestedProfile = profileIndex;
+  }
+}
+
+/**
+  * @brief  Get the index of the active profile
+  * @param  None
+  * @retval uint8_t: Index of the active profile
+  */
+uint8_t Mapping_Engine_GetActiveProfile(void)
+{
+  return activeIndex;
+}
+
+/**
+  * @brief  Get the name of a profile
+  * @param  profileIndex: Index of the profile
+  * @retval const char*: Profile name, NULL if the index is invalid
+  */
+const char* Mapping_Engine_GetProfileName(uint8_t profileIndex)
+{
+  if (profileIndex >= MAX_MAPPING_PROFILES) {
+    return NULL;
+  }
+  
+  return MAPPING_PROFILE_SLOT(profileIndex)->name;
+}
+
+/**
+  * @brief  Get dispatch statistics
+  * @param  stats: Pointer to structure receiving the statistics
+  * @retval None
+  */
+void Mapping_Engine_GetStats(Mapping_Engine_Stats_t* stats)
+{
+  if (stats != NULL) {
+    *stats = dispatchStats;
+  }
+}
+
+/**
+  * @brief  Reset dispatch statistics
+  * @param  None
+  * @retval None
+  */
+void Mapping_Engine_ResetStats(void)
+{
+  memset(&dispatchStats, 0, sizeof(dispatchStats));
+  dispatchStats.bytesPerMapping = (uint16_t)MAPPING_PROFILE_ENTRY_SIZE;
+}
+
+/**
+  * @brief  Get a percentile of the key lookup cycles of dispatched events
+  * @note   Covers the lookup only, output sends are not included.
+  *         Resolved to the histogram buckets, so the result is the upper bound
+  *         of the bucket holding the percentile, at most twice the true value.
+  * @param  percent: Percentile, 1 to 100
+  * @retval uint32_t: Cycles, 0 if no event has been dispatched
+  */
+uint32_t Mapping_Engine_GetLatencyPercentile(uint8_t percent)
+{
+  uint32_t events = dispatchStats.events;
+  uint32_t seen = 0;
+  
+  if (events == 0 || percent == 0) {
+    return 0;
+  }
+  
+  /* Rank of the percentile, rounded up */
+  uint32_t rank = (uint32_t)(((uint64_t)events * percent + 99) / 100);
+  
+  for (uint8_t i = 0; i < MAPPING_STATS_BUCKETS - 1; i++) {
+    seen += dispatchStats.histogram[i];
+    
+    if (seen >= rank) {
+      return (1UL << i) - 1;
+    }
+  }
+  
+  return dispatchStats.maxCycles;
 }
 
 /**
@@ -157,10 +472,49 @@ uint8_t Mapping_Engine_GetMappingCount(void)
   */
 uint8_t Mapping_Engine_SaveConfig(void)
 {
-  /* In a real implementation, this would save the configuration to flash memory
-     using the STM32 HAL flash functions. For this example, we'll just return success. */
+#ifdef MAPPING_STATIC_TABLE
+  /* Profiles are linked into flash, there is nothing to save */
+  return 1;
+#else
+  Mapping_Stored_Profile_t header;
+  Mapping_Stored_Entry_t entry;
+  
+  for (uint8_t p = 0; p < MAX_MAPPING_PROFILES; p++) {
+    const Mapping_Profile_t* profile = profileSlots[p];
+    
+    /* Unchanged entries are skipped by the store */
+    for (uint8_t i = 0; i < profile->count; i++) {
+      memset(&entry, 0, sizeof(entry));
+      entry.key = profile->keys[i];
+      entry.minValue = profile->minValues[i];
+      entry.maxValue = profile->maxValues[i];
+      entry.outputType = profile->outputTypes[i];
+      entry.output = profile->outputs[i];
+      
+      if (!Config_Store_Write(CONFIG_KEY_MAPPING_ENTRY(p, i), &entry, sizeof(entry))) {
+        return 0;
+      }
+    }
+    
+    /* Drop entries left over from a longer profile */
+    for (uint8_t i = profile->count; i < MAX_MAPPINGS; i++) {
+      if (!Config_Store_Delete(CONFIG_KEY_MAPPING_ENTRY(p, i))) {
+        return 0;
+      }
+    }
+    
+    /* Header last, it is what makes the entries count on the next boot */
+    memset(&header, 0, sizeof(header));
+    memcpy(header.name, profile->name, MAPPING_PROFILE_NAME_SIZE);
+    header.count = profile->count;
+    
+    if (!Config_Store_Write(CONFIG_KEY_MAPPING_PROFILE(p), &header, sizeof(header))) {
+      return 0;
+    }
+  }
   
   return 1;
+#endif
 }
 
 /**
@@ -170,10 +524,51 @@ uint8_t Mapping_Engine_SaveConfig(void)
   */
 uint8_t Mapping_Engine_LoadConfig(void)
 {
-  /* In a real implementation, this would load the configuration from flash memory
-     using the STM32 HAL flash functions. For this example, we'll just return success. */
+  /* Start from defaults so a missing profile keeps the default contents */
+  Mapping_Engine_ResetConfig();
+  
+#ifndef MAPPING_STATIC_TABLE
+  Mapping_Stored_Profile_t header;
+  Mapping_Stored_Entry_t entry;
+  uint8_t result = 1;
+  
+  for (uint8_t p = 0; p < MAX_MAPPING_PROFILES; p++) {
+    if (!Config_Store_Read(CONFIG_KEY_MAPPING_PROFILE(p), &header, sizeof(header)) ||
+        header.count > MAX_MAPPINGS) {
+      continue;
+    }
+    
+    /* Entries were saved in dispatch order, fill the staging buffer directly */
+    Mapping_Engine_EditProfile(p, 0);
+    memcpy(stagingProfile->name, header.name, MAPPING_PROFILE_NAME_SIZE);
+    stagingProfile->name[MAPPING_PROFILE_NAME_SIZE - 1] = '\0';
+    
+    for (uint8_t i = 0; i < header.count; i++) {
+      if (!Config_Store_Read(CONFIG_KEY_MAPPING_ENTRY(p, i), &entry, sizeof(entry))) {
+        break;
+      }
+      
+      stagingProfile->keys[i] = entry.key;
+      stagingProfile->minValues[i] = entry.minValue;
+      stagingProfile->maxValues[i] = entry.maxValue;
+      stagingProfile->outputTypes[i] = entry.outputType;
+      stagingProfile->outputs[i] = entry.output;
+      stagingProfile->count++;
+    }
+    
+    /* A profile with missing entries is discarded and keeps its defaults */
+    if (stagingProfile->count == header.count) {
+      Mapping_Engine_CommitProfile();
+    } else {
+      stagingIndex = MAPPING_PROFILE_NONE;
+      result = 0;
+    }
+  }
   
+  return result;
+#else
   return 1;
+#endif
 }
 
 /**
@@ -183,12 +578,22 @@ uint8_t Mapping_Engine_LoadConfig(void)
   */
 void Mapping_Engine_ResetConfig(void)
 {
-  /* Clear all mappings */
-  for (uint8_t i = 0; i < MAX_MAPPINGS; i++) {
-    mappings[i].enabled = 0;
+#ifndef MAPPING_STATIC_TABLE
+  /* Clear all profiles */
+  for (uint8_t i = 0; i < MAX_MAPPING_PROFILES; i++) {
+    Mapping_Engine_EditProfile(i, 0);
+    Mapping_Engine_CommitProfile();
   }
+#endif
+  
+  /* Clear derived signal expressions, combos and macros */
+  Mapping_Expr_Init();
+  Mapping_Combo_Init();
   
-  mappingCount = 0;
+#ifndef MAPPING_STATIC_TABLE
+  /* Build the default profile */
+  Mapping_Engine_EditProfile(0, 0);
+  Mapping_Engine_SetProfileName("Default");
   
   /* Add default mappings if needed */
   /* For example, map keyboard keys to serial output */
@@ -220,6 +625,50 @@ void Mapping_Engine_ResetConfig(void)
   defaultMapping.output.can.dataIndex = 0;
   
   Mapping_Engine_AddMapping(&defaultMapping);
+  
+  Mapping_Engine_CommitProfile();
+#endif
+  Mapping_Engine_SelectProfile(0);
+  
+  /* Example: Combined trigger, the larger of two gamepad axes to CAN output */
+  Mapping_Expr_t defaultExpr;
+  uint8_t leftTrigger = Mapping_Expr_RegisterSignal(2, INPUT_EVENT_AXIS_CHANGE, 4);
+  uint8_t rightTrigger = Mapping_Expr_RegisterSignal(2, INPUT_EVENT_AXIS_CHANGE, 5);
+  
+  memset(&defaultExpr, 0, sizeof(defaultExpr));
+  defaultExpr.code[0] = EXPR_OP_PUSH_SIGNAL;
+  defaultExpr.code[1] = leftTrigger;
+  defaultExpr.code[2] = EXPR_OP_PUSH_SIGNAL;
+  defaultExpr.code[3] = rightTrigger;
+  defaultExpr.code[4] = EXPR_OP_MAX;
+  defaultExpr.code[5] = EXPR_OP_END;
+  defaultExpr.codeLength = 6;
+  defaultExpr.outputType = OUTPUT_TYPE_CAN;
+  defaultExpr.output.can.canId = 0x101;
+  defaultExpr.output.can.dlc = 2;
+  defaultExpr.output.can.dataIndex = 0;
+  
+  Mapping_Expr_Add(&defaultExpr);
+  
+  /* Example: Left Ctrl + F1 chord sends a CAN command */
+  Mapping_Combo_t defaultCombo;
+  
+  memset(&defaultCombo, 0, sizeof(defaultCombo));
+  defaultCombo.type = COMBO_TYPE_CHORD;
+  defaultCombo.keyCount = 2;
+  defaultCombo.keys[0].deviceIndex = 0;
+  defaultCombo.keys[0].eventType = INPUT_EVENT_KEY_PRESS;
+  defaultCombo.keys[0].inputId = 0;     /* Left Ctrl modifier bit */
+  defaultCombo.keys[1].deviceIndex = 0;
+  defaultCombo.keys[1].eventType = INPUT_EVENT_KEY_PRESS;
+  defaultCombo.keys[1].inputId = 0x3A;  /* F1 key in HID usage table */
+  defaultCombo.actions[0].outputType = OUTPUT_TYPE_CAN;
+  defaultCombo.actions[0].output.can.canId = 0x102;
+  defaultCombo.actions[0].output.can.dlc = 1;
+  defaultCombo.actions[0].output.can.dataIndex = 0;
+  defaultCombo.actions[0].value = 1;
+  
+  Mapping_Combo_Add(&defaultCombo);
 }
 
 /**
@@ -234,51 +683,167 @@ static void Mapping_Engine_InputCallback(Input_Event_t* inputEvent)
 }
 
 /**
-  * @brief  Process a mapping for an input event
-  * @param  mapping: Pointer to mapping structure
+  * @brief  Callback function for received CAN frames
+  * @param  canId: CAN identifier
+  * @param  data: Pointer to frame data
+  * @param  length: Frame data length
+  * @retval None
+  */
+static void Mapping_Engine_CANRxCallback(uint32_t canId, uint8_t* data, uint8_t length)
+{
+  if (canId == MAPPING_PROFILE_CAN_ID && length >= 1) {
+    Mapping_Engine_SelectProfile(data[0]);
+  }
+}
+
+/**
+  * @brief  Apply a pending profile switch request
+  * @note   A single pointer store, independent of the profile size.
+  * @param  None
+  * @retval None
+  */
+static void Mapping_Engine_ApplyProfileSwitch(void)
+{
+  uint8_t request = requestedProfile;
+  
+  if (request == MAPPING_PROFILE_NONE) {
+    return;
+  }
+  
+  requestedProfile = MAPPING_PROFILE_NONE;
+  activeIndex = request;
+  activeProfile = MAPPING_PROFILE_SLOT(request);
+}
+
+/**
+  * @brief  Run all mappings of a profile that match an input event
+  * @param  profile: Pointer to profile
   * @param  inputEvent: Pointer to input event structure
   * @retval None
   */
-static void Mapping_Engine_ProcessMapping(Input_Mapping_t* mapping, Input_Event_t* inputEvent)
+static void Mapping_Engine_DispatchEvent(const Mapping_Profile_t* profile, Input_Event_t* inputEvent)
 {
-  /* Check if this mapping applies to this event */
-  if (mapping->deviceIndex == inputEvent->deviceIndex &&
-      mapping->eventType == inputEvent->eventType &&
-      mapping->inputId == inputEvent->inputId) {
-    
+  uint32_t start = DWT->CYCCNT;
+  uint32_t key = MAPPING_KEY(inputEvent->deviceIndex, inputEvent->eventType, inputEvent->inputId);
+  int16_t value = inputEvent->value;
+  
+  /* Several mappings may share the same input */
+  uint8_t first = Mapping_Engine_LowerBound(profile, key);
+  uint8_t last = first;
+  while (last < profile->count && profile->keys[last] == key) {
+    last++;
+  }
+  
+  /* Statistics cover the lookup only, output sends are not included */
+  uint32_t cycles = DWT->CYCCNT - start;
+  dispatchStats.events++;
+  dispatchStats.totalCycles += cycles;
+  if (cycles > dispatchStats.maxCycles) {
+    dispatchStats.maxCycles = cycles;
+  }
+  
+  uint32_t bucket = 32 - __CLZ(cycles);
+  dispatchStats.histogram[bucket < MAPPING_STATS_BUCKETS ? bucket : MAPPING_STATS_BUCKETS - 1]++;
+  
+  for (uint8_t i = first; i < last; i++) {
     /* Check if value is within range */
-    if (inputEvent->value >= mapping->minValue && inputEvent->value <= mapping->maxValue) {
-      /* Process based on output type */
-      switch (mapping->outputType) {
-        case OUTPUT_TYPE_SERIAL:
-          Mapping_Engine_SendSerialOutput(mapping, inputEvent->value);
-          break;
-        
-        case OUTPUT_TYPE_CAN:
-          Mapping_Engine_SendCANOutput(mapping, inputEvent->value);
-          break;
-        
-        default:
-          break;
-      }
+    if (value >= profile->minValues[i] && value <= profile->maxValues[i]) {
+      Mapping_Engine_SendOutput((Output_Type_t)profile->outputTypes[i], &profile->outputs[i], value);
     }
   }
 }
 
+/**
+  * @brief  Find the first entry of a profile whose key is not less than a key
+  * @param  profile: Pointer to profile
+  * @param  key: Dispatch key
+  * @retval uint8_t: Entry index, profile->count if all keys are smaller
+  */
+static uint8_t Mapping_Engine_LowerBound(const Mapping_Profile_t* profile, uint32_t key)
+{
+  const uint32_t* keys = profile->keys;
+  uint8_t low = 0;
+  uint8_t high = profile->count;
+  
+  while (low < high) {
+    uint8_t mid = (uint8_t)((low + high) / 2);
+    
+    if (keys[mid] < key) {
+      low = mid + 1;
+    } else {
+      high = mid;
+    }
+  }
+  
+  return low;
+}
+
+#ifndef MAPPING_STATIC_TABLE
+/**
+  * @brief  Clear a profile buffer
+  * @param  profile: Pointer to profile
+  * @retval None
+  */
+static void Mapping_Engine_ClearProfile(Mapping_Profile_t* profile)
+{
+  memset(profile, 0, sizeof(Mapping_Profile_t));
+}
+#endif
+
+/**
+  * @brief  Send a value to the output described by an output configuration
+  * @param  outputType: Output type
+  * @param  output: Pointer to output configuration
+  * @param  value: Value to send
+  * @retval uint8_t: 1 if successful, 0 if failed
+  */
+uint8_t Mapping_Engine_SendOutput(Output_Type_t outputType, const Mapping_Output_Config_t* output, int16_t value)
+{
+  if (output == NULL) {
+    return 0;
+  }
+  
+  /* CAN outputs are told apart by their ID in the log, the others by type */
+  uint32_t target = (outputType == OUTPUT_TYPE_CAN) ? output->can.canId : 0;
+  Data_Logger_Record(DATA_LOGGER_SOURCE_OUTPUT, DATA_LOGGER_OUTPUT_ID(outputType, target),
+                     (const uint8_t*)&value, sizeof(value));
+  
+  /* Process based on output type */
+  switch (outputType) {
+    case OUTPUT_TYPE_SERIAL:
+      return Mapping_Engine_SendSerialOutput(output, value);
+    
+    case OUTPUT_TYPE_CAN:
+      return Mapping_Engine_SendCANOutput(output, value);
+    
+    case OUTPUT_TYPE_PROFILE:
+      /* Applied before the next event is processed */
+      Mapping_Engine_SelectProfile(output->profile.profileIndex);
+      return 1;
+    
+    case OUTPUT_TYPE_MACRO:
+      /* Played back from the timer wheel */
+      return Mapping_Combo_StartMacro(output->macro.macroIndex);
+    
+    default:
+      return 0;
+  }
+}
+
 /**
   * @brief  Send serial output for a mapping
-  * @param  mapping: Pointer to mapping structure
+  * @param  output: Pointer to output configuration
   * @param  value: Input value
   * @retval uint8_t: 1 if successful, 0 if failed
   */
-static uint8_t Mapping_Engine_SendSerialOutput(Input_Mapping_t* mapping, int16_t value)
+static uint8_t Mapping_Engine_SendSerialOutput(const Mapping_Output_Config_t* output, int16_t value)
 {
   /* Prepare data for serial output */
   uint8_t data[8] = {0};
-  uint8_t length = mapping->output.serial.dataLength;
+  uint8_t length = output->serial.dataLength;
   
   /* Format data based on data format */
-  switch (mapping->output.serial.dataFormat) {
+  switch (output->serial.dataFormat) {
     case 0:  /* Raw value */
       data[0] = (uint8_t)value;
       break;
@@ -310,16 +875,16 @@ static uint8_t Mapping_Engine_SendSerialOutput(Input_Mapping_t* mapping, int16_t
 
 /**
   * @brief  Send CAN output for a mapping
-  * @param  mapping: Pointer to mapping structure
+  * @param  output: Pointer to output configuration
   * @param  value: Input value
   * @retval uint8_t: 1 if successful, 0 if failed
   */
-static uint8_t Mapping_Engine_SendCANOutput(Input_Mapping_t* mapping, int16_t value)
+static uint8_t Mapping_Engine_SendCANOutput(const Mapping_Output_Config_t* output, int16_t value)
 {
   /* Prepare data for CAN output */
   uint8_t data[8] = {0};
-  uint8_t length = mapping->output.can.dlc;
-  uint8_t dataIndex = mapping->output.can.dataIndex;
+  uint8_t length = output->can.dlc;
+  uint8_t dataIndex = output->can.dataIndex;
   
   /* Ensure data index is valid */
   if (dataIndex >= length) {
@@ -337,7 +902,7 @@ static uint8_t Mapping_Engine_SendCANOutput(Input_Mapping_t* mapping, int16_t va
   }
   
   /* Send data to Output Manager */
-  Output_Manager_SendCAN(mapping->output.can.canId, data, length);
+  Output_Manager_SendCAN(output->can.canId, data, length);
   
   return 1;
 }
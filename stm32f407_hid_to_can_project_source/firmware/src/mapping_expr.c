@@ -0,0 +1,422 @@
+/**
+ * @file mapping_expr.c
+ * @brief Derived signal expressions for the Mapping Engine of STM32F407 HID to Serial/CAN project
+ * @author Manus AI
+ * @date 2025-03-28
+ *
+ * Some outputs depend on more than one input (combined brake, max of two
+ * triggers, clutch interlock). Each such output carries a short bytecode
+ * program that is run by a small stack VM. Input events only update the
+ * signal table and mark the signal as changed; once per Mapping_Engine_Process
+ * pass, only the expressions that read a changed signal are re-evaluated.
+ *
+ * Programs are checked once in Mapping_Expr_Add (operands, signal slots and
+ * stack depth), so the evaluation loop itself runs without bounds checks.
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "mapping_expr.h"
+#include "main.h"
+#include <stdint.h>
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/* Private typedef -----------------------------------------------------------*/
+typedef struct {
+  uint32_t key;        /* deviceIndex << 16 | eventType << 8 | inputId */
+  int16_t value;
+} Mapping_Signal_t;
+
+/* Private define ------------------------------------------------------------*/
+#define MAPPING_EXPR_INVALID      0xFF
+
+/* Private macro -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+Mapping_Signal_t exprSignals[MAPPING_EXPR_MAX_SIGNALS];
+uint8_t exprSignalCount = 0;
+uint32_t exprChangedMask = 0;
+
+Mapping_Expr_t exprTable[MAPPING_EXPR_MAX_EXPRS];
+
+/* Operand byte count and stack effect (pops, pushes) for each opcode */
+static const uint8_t exprOperandBytes[EXPR_OP_COUNT] = {
+  [EXPR_OP_PUSH_SIGNAL] = 1,
+  [EXPR_OP_PUSH_CONST8] = 1,
+  [EXPR_OP_PUSH_CONST16] = 2,
+  [EXPR_OP_SHR] = 1,
+};
+
+static const uint8_t exprPops[EXPR_OP_COUNT] = {
+  [EXPR_OP_ADD] = 2, [EXPR_OP_SUB] = 2, [EXPR_OP_MUL] = 2, [EXPR_OP_DIV] = 2,
+  [EXPR_OP_SHR] = 1, [EXPR_OP_NEG] = 1, [EXPR_OP_ABS] = 1,
+  [EXPR_OP_MIN] = 2, [EXPR_OP_MAX] = 2,
+  [EXPR_OP_AND] = 2, [EXPR_OP_OR] = 2, [EXPR_OP_NOT] = 1,
+  [EXPR_OP_GT] = 2, [EXPR_OP_LT] = 2, [EXPR_OP_EQ] = 2,
+  [EXPR_OP_SELECT] = 3,
+};
+
+/* Private function prototypes -----------------------------------------------*/
+static uint8_t Mapping_Expr_Validate(Mapping_Expr_t* expr);
+static int16_t Mapping_Expr_Saturate(int32_t value);
+static int32_t Mapping_Expr_Clamp(int64_t value);
+
+/* External variables --------------------------------------------------------*/
+
+/**
+  * @brief  Expression table initialization function
+  * @param  None
+  * @retval None
+  */
+void Mapping_Expr_Init(void)
+{
+  for (uint8_t i = 0; i < MAPPING_EXPR_MAX_EXPRS; i++) {
+    exprTable[i].enabled = 0;
+  }
+  
+  exprSignalCount = 0;
+  exprChangedMask = 0;
+}
+
+/**
+  * @brief  Re-evaluate every expression that reads a signal changed since the last pass
+  * @param  None
+  * @retval None
+  */
+void Mapping_Expr_Process(void)
+{
+  uint32_t changed = exprChangedMask;
+  
+  if (changed == 0) {
+    return;
+  }
+  
+  exprChangedMask = 0;
+  
+  for (uint8_t i = 0; i < MAPPING_EXPR_MAX_EXPRS; i++) {
+    Mapping_Expr_t* expr = &exprTable[i];
+    
+    if (!expr->enabled || (expr->inputMask & changed) == 0) {
+      continue;
+    }
+    
+    int16_t value = Mapping_Expr_Evaluate(expr);
+    
+    /* Derived signals are only sent when their value actually changes */
+    if (!expr->hasValue || value != expr->lastValue) {
+      if (Mapping_Engine_SendOutput(expr->outputType, &expr->output, value)) {
+        expr->lastValue = value;
+        expr->hasValue = 1;
+      }
+    }
+  }
+}
+
+/**
+  * @brief  Register an input signal that expressions can read
+  * @param  deviceIndex: Index of the source device
+  * @param  eventType: Event type carrying the signal value
+  * @param  inputId: ID of the input (button, key, axis)
+  * @retval uint8_t: Signal slot, 0xFF if the table is full
+  */
+uint8_t Mapping_Expr_RegisterSignal(uint8_t deviceIndex, Input_Event_Type_t eventType, uint8_t inputId)
+{
+  uint32_t key = MAPPING_KEY(deviceIndex, eventType, inputId);
+  
+  /* Reuse an existing slot for the same input */
+  for (uint8_t i = 0; i < exprSignalCount; i++) {
+    if (exprSignals[i].key == key) {
+      return i;
+    }
+  }
+  
+  if (exprSignalCount >= MAPPING_EXPR_MAX_SIGNALS) {
+    return MAPPING_EXPR_INVALID;
+  }
+  
+  exprSignals[exprSignalCount].key = key;
+  exprSignals[exprSignalCount].value = 0;
+  
+  return exprSignalCount++;
+}
+
+/**
+  * @brief  Get the current value of an input signal
+  * @param  signalIndex: Signal slot
+  * @retval int16_t: Current value, 0 if the slot is not registered
+  */
+int16_t Mapping_Expr_GetSignal(uint8_t signalIndex)
+{
+  if (signalIndex >= exprSignalCount) {
+    return 0;
+  }
+  
+  return exprSignals[signalIndex].value;
+}
+
+/**
+  * @brief  Update the signal table from an input event
+  * @param  inputEvent: Pointer to input event structure
+  * @retval None
+  */
+void Mapping_Expr_UpdateSignal(Input_Event_t* inputEvent)
+{
+  if (inputEvent == NULL) {
+    return;
+  }
+  
+  /* Key and button releases update the same signal as the press */
+  Input_Event_Type_t eventType = inputEvent->eventType;
+  if (eventType == INPUT_EVENT_KEY_RELEASE) {
+    eventType = INPUT_EVENT_KEY_PRESS;
+  } else if (eventType == INPUT_EVENT_BUTTON_RELEASE) {
+    eventType = INPUT_EVENT_BUTTON_PRESS;
+  }
+  
+  uint32_t key = MAPPING_KEY(inputEvent->deviceIndex, eventType, inputEvent->inputId);
+  
+  for (uint8_t i = 0; i < exprSignalCount; i++) {
+    if (exprSignals[i].key == key) {
+      if (exprSignals[i].value != inputEvent->value) {
+        exprSignals[i].value = inputEvent->value;
+        exprChangedMask |= (1UL << i);
+      }
+      return;
+    }
+  }
+}
+
+/**
+  * @brief  Add a derived signal expression
+  * @param  expr: Pointer to expression structure
+  * @retval uint8_t: Index of the new expression, 0xFF if failed
+  */
+uint8_t Mapping_Expr_Add(Mapping_Expr_t* expr)
+{
+  if (expr == NULL || !Mapping_Expr_Validate(expr)) {
+    return MAPPING_EXPR_INVALID;
+  }
+  
+  /* Find an empty slot */
+  for (uint8_t i = 0; i < MAPPING_EXPR_MAX_EXPRS; i++) {
+    if (!exprTable[i].enabled) {
+      memcpy(&exprTable[i], expr, sizeof(Mapping_Expr_t));
+      exprTable[i].hasValue = 0;
+      exprTable[i].enabled = 1;
+      
+      /* Evaluate once on the next pass so the output starts out valid */
+      exprChangedMask |= exprTable[i].inputMask;
+      
+      return i;
+    }
+  }
+  
+  return MAPPING_EXPR_INVALID;
+}
+
+/**
+  * @brief  Remove a derived signal expression
+  * @param  exprIndex: Index of the expression to remove
+  * @retval uint8_t: 1 if successful, 0 if failed
+  */
+uint8_t Mapping_Expr_Remove(uint8_t exprIndex)
+{
+  if (exprIndex >= MAPPING_EXPR_MAX_EXPRS || !exprTable[exprIndex].enabled) {
+    return 0;
+  }
+  
+  exprTable[exprIndex].enabled = 0;
+  
+  return 1;
+}
+
+/**
+  * @brief  Get a derived signal expression
+  * @param  exprIndex: Index of the expression
+  * @retval Mapping_Expr_t*: Pointer to the expression, NULL if not found
+  */
+Mapping_Expr_t* Mapping_Expr_Get(uint8_t exprIndex)
+{
+  if (exprIndex >= MAPPING_EXPR_MAX_EXPRS || !exprTable[exprIndex].enabled) {
+    return NULL;
+  }
+  
+  return &exprTable[exprIndex];
+}
+
+/**
+  * @brief  Run an expression program against the current signal values
+  * @note   The program must have been accepted by Mapping_Expr_Validate.
+  * @param  expr: Pointer to expression structure
+  * @retval int16_t: Result, saturated to the int16_t range
+  */
+int16_t Mapping_Expr_Evaluate(const Mapping_Expr_t* expr)
+{
+  int32_t stack[MAPPING_EXPR_STACK_DEPTH];
+  int32_t* sp = stack;  /* Points at the next free entry */
+  const uint8_t* pc = expr->code;
+  int32_t a;
+  int32_t b;
+  
+  for (;;) {
+    switch ((Mapping_Expr_Op_t)*pc++) {
+      case EXPR_OP_END:
+        return Mapping_Expr_Saturate(sp[-1]);
+      
+      case EXPR_OP_PUSH_SIGNAL:
+        *sp++ = exprSignals[*pc++].value;
+        break;
+      
+      case EXPR_OP_PUSH_CONST8:
+        *sp++ = (int8_t)*pc++;
+        break;
+      
+      case EXPR_OP_PUSH_CONST16:
+        *sp++ = (int16_t)(pc[0] | (pc[1] << 8));
+        pc += 2;
+        break;
+      
+      /* Arithmetic is done in 64 bits and saturated to 32 bits after every
+         op, so chained products and INT32_MIN / -1 cannot overflow */
+      case EXPR_OP_ADD: b = *--sp; sp[-1] = Mapping_Expr_Clamp((int64_t)sp[-1] + b); break;
+      case EXPR_OP_SUB: b = *--sp; sp[-1] = Mapping_Expr_Clamp((int64_t)sp[-1] - b); break;
+      case EXPR_OP_MUL: b = *--sp; sp[-1] = Mapping_Expr_Clamp((int64_t)sp[-1] * b); break;
+      
+      case EXPR_OP_DIV:
+        b = *--sp;
+        sp[-1] = (b != 0) ? Mapping_Expr_Clamp((int64_t)sp[-1] / b) : 0;
+        break;
+      
+      case EXPR_OP_SHR: sp[-1] >>= (*pc++ & 0x1F); break;
+      case EXPR_OP_NEG: sp[-1] = Mapping_Expr_Clamp(-(int64_t)sp[-1]); break;
+      case EXPR_OP_ABS: sp[-1] = Mapping_Expr_Clamp((sp[-1] < 0) ? -(int64_t)sp[-1] : sp[-1]); break;
+      
+      case EXPR_OP_MIN: b = *--sp; if (b < sp[-1]) sp[-1] = b; break;
+      case EXPR_OP_MAX: b = *--sp; if (b > sp[-1]) sp[-1] = b; break;
+      
+      case EXPR_OP_AND: b = *--sp; sp[-1] = (sp[-1] != 0 && b != 0); break;
+      case EXPR_OP_OR:  b = *--sp; sp[-1] = (sp[-1] != 0 || b != 0); break;
+      case EXPR_OP_NOT: sp[-1] = (sp[-1] == 0); break;
+      
+      case EXPR_OP_GT: b = *--sp; sp[-1] = (sp[-1] > b); break;
+      case EXPR_OP_LT: b = *--sp; sp[-1] = (sp[-1] < b); break;
+      case EXPR_OP_EQ: b = *--sp; sp[-1] = (sp[-1] == b); break;
+      
+      case EXPR_OP_SELECT:
+        b = *--sp;
+        a = *--sp;
+        sp[-1] = (sp[-1] != 0) ? a : b;
+        break;
+      
+      default:
+        return 0;
+    }
+  }
+}
+
+/**
+  * @brief  Check an expression program and compute its input signal mask
+  * @note   Values on the stack are int32_t. Add, subtract, multiply, divide,
+  *         negate and absolute value saturate to the int32_t range after
+  *         each op, division by zero gives 0 and only the final result is
+  *         saturated to int16_t. A program that passes here cannot overflow.
+  * @param  expr: Pointer to expression structure
+  * @retval uint8_t: 1 if the program is valid, 0 otherwise
+  */
+static uint8_t Mapping_Expr_Validate(Mapping_Expr_t* expr)
+{
+  uint8_t pc = 0;
+  uint8_t depth = 0;
+  uint32_t mask = 0;
+  
+  if (expr->codeLength == 0 || expr->codeLength > MAPPING_EXPR_MAX_CODE) {
+    return 0;
+  }
+  
+  while (pc < expr->codeLength) {
+    uint8_t op = expr->code[pc++];
+    
+    if (op >= EXPR_OP_COUNT) {
+      return 0;
+    }
+    
+    if (op == EXPR_OP_END) {
+      /* Exactly one result must be left on the stack */
+      if (depth != 1) {
+        return 0;
+      }
+      
+      expr->inputMask = mask;
+      return 1;
+    }
+    
+    /* Operands must be inside the program */
+    if (pc + exprOperandBytes[op] > expr->codeLength) {
+      return 0;
+    }
+    
+    if (op == EXPR_OP_PUSH_SIGNAL) {
+      uint8_t slot = expr->code[pc];
+      
+      if (slot >= exprSignalCount) {
+        return 0;
+      }
+      
+      mask |= (1UL << slot);
+    }
+    
+    pc += exprOperandBytes[op];
+    
+    /* Track stack depth: pushes are ops without pops, everything else leaves one result */
+    if (exprPops[op] == 0) {
+      if (depth >= MAPPING_EXPR_STACK_DEPTH) {
+        return 0;
+      }
+      depth++;
+    } else {
+      if (depth < exprPops[op]) {
+        return 0;
+      }
+      depth = depth - exprPops[op] + 1;
+    }
+  }
+  
+  /* Missing EXPR_OP_END */
+  return 0;
+}
+
+/**
+  * @brief  Clamp a VM result to the int16_t output range
+  * @param  value: Value to clamp
+  * @retval int16_t: Clamped value
+  */
+static int16_t Mapping_Expr_Saturate(int32_t value)
+{
+  if (value > INT16_MAX) {
+    return INT16_MAX;
+  }
+  
+  if (value < INT16_MIN) {
+    return INT16_MIN;
+  }
+  
+  return (int16_t)value;
+}
+
+/**
+  * @brief  Clamp an intermediate result to the int32_t stack range
+  * @param  value: Value to clamp
+  * @retval int32_t: Clamped value
+  */
+static int32_t Mapping_Expr_Clamp(int64_t value)
+{
+  if (value > INT32_MAX) {
+    return INT32_MAX;
+  }
+  
+  if (value < INT32_MIN) {
+    return INT32_MIN;
+  }
+  
+  return (int32_t)value;
+}
@@ -8,6 +8,9 @@
 /* Includes ------------------------------------------------------------------*/
 #include "output_manager.h"
 #include "main.h"
+#include "config_store.h"
+#include "rx_cache.h"
+#include "data_logger.h"
 #include <stdint.h>
 #include <string.h>
 #include <stdio.h>
@@ -15,8 +18,9 @@
 
 /* Private typedef -----------------------------------------------------------*/
 /* Private define ------------------------------------------------------------*/
-#define OUTPUT_CONFIG_ADDR       0x08070000  /* Flash sector for configuration storage */
-#define OUTPUT_CONFIG_SIZE       (sizeof(Serial_Config_t) + sizeof(CAN_Config_t) + 8)
+#define CAN_RX_QUEUE_MASK         (MAX_CAN_RX_QUEUE_SIZE - 1)
+#define CAN_RX_IRQ_PRIORITY       4
+#define SERIAL_RX_IRQ_PRIORITY    6
 
 /* Private macro -------------------------------------------------------------*/
 /* Private variables ---------------------------------------------------------*/
@@ -38,11 +42,28 @@ uint8_t canTxHead = 0;
 uint8_t canTxTail = 0;
 uint8_t canTxCount = 0;
 
+CAN_Rx_Callback_t canRxCallbacks[MAX_CAN_RX_CALLBACKS];
+uint8_t canRxCallbackCount = 0;
+
+/* Filled by the receive interrupt, drained by the main loop */
+uint8_t canRxQueueData[MAX_CAN_RX_QUEUE_SIZE][8];
+uint32_t canRxQueueIds[MAX_CAN_RX_QUEUE_SIZE];
+uint8_t canRxQueueLengths[MAX_CAN_RX_QUEUE_SIZE];
+volatile uint8_t canRxQueueHead = 0;
+volatile uint8_t canRxQueueTail = 0;
+volatile uint32_t canRxDropCount = 0;
+
+/* Running totals, they wrap and are only ever compared as differences */
+uint32_t serialTxByteCount = 0;
+uint32_t canTxFrameCount = 0;
+volatile uint32_t canRxFrameCount = 0;
+
 /* Private function prototypes -----------------------------------------------*/
 static void Output_Manager_InitSerial(void);
 static void Output_Manager_InitCAN(void);
 static void Output_Manager_ProcessSerial(void);
 static void Output_Manager_ProcessCAN(void);
+static void Output_Manager_ReceiveCAN(void);
 static uint8_t Output_Manager_FormatSerialData(uint8_t* data, uint8_t length, uint8_t* formattedData);
 
 /* External variables --------------------------------------------------------*/
@@ -85,6 +106,9 @@ void Output_Manager_Process(void)
   
   /* Process CAN output */
   Output_Manager_ProcessCAN();
+  
+  /* Process CAN input */
+  Output_Manager_ReceiveCAN();
 }
 
 /**
@@ -150,6 +174,22 @@ uint8_t Output_Manager_SendCAN(uint32_t canId, uint8_t* data, uint8_t length)
   return 1;
 }
 
+/**
+  * @brief  Register a callback for received CAN frames
+  * @param  callback: Pointer to callback function
+  * @retval uint8_t: 1 if successful, 0 if failed
+  */
+uint8_t Output_Manager_RegisterCANRxCallback(CAN_Rx_Callback_t callback)
+{
+  if (callback == NULL || canRxCallbackCount >= MAX_CAN_RX_CALLBACKS) {
+    return 0;
+  }
+  
+  canRxCallbacks[canRxCallbackCount++] = callback;
+  
+  return 1;
+}
+
 /**
   * @brief  Configure serial interface
   * @param  config: Pointer to serial configuration structure
@@ -210,6 +250,26 @@ CAN_Config_t* Output_Manager_GetCANConfig(void)
   return &canConfig;
 }
 
+/**
+  * @brief  Get traffic counters and queue depths
+  * @param  stats: Pointer to structure receiving the statistics
+  * @retval None
+  */
+void Output_Manager_GetStats(Output_Manager_Stats_t* stats)
+{
+  if (stats == NULL) {
+    return;
+  }
+  
+  stats->serialTxBytes = serialTxByteCount;
+  stats->canTxFrames = canTxFrameCount;
+  stats->canRxFrames = canRxFrameCount;
+  stats->canRxDropped = canRxDropCount;
+  stats->serialTxQueued = serialTxCount;
+  stats->canTxQueued = canTxCount;
+  stats->canRxQueued = (uint8_t)(canRxQueueTail - canRxQueueHead) & CAN_RX_QUEUE_MASK;
+}
+
 /**
   * @brief  Save output configuration to flash
   * @param  None
@@ -217,10 +277,12 @@ CAN_Config_t* Output_Manager_GetCANConfig(void)
   */
 uint8_t Output_Manager_SaveConfig(void)
 {
-  /* In a real implementation, this would save the configuration to flash memory
-     using the STM32 HAL flash functions. For this example, we'll just return success. */
+  /* Unchanged records are skipped by the store */
+  if (!Config_Store_Write(CONFIG_KEY_OUTPUT_SERIAL, &serialConfig, sizeof(serialConfig))) {
+    return 0;
+  }
   
-  return 1;
+  return Config_Store_Write(CONFIG_KEY_OUTPUT_CAN, &canConfig, sizeof(canConfig));
 }
 
 /**
@@ -230,24 +292,11 @@ uint8_t Output_Manager_SaveConfig(void)
   */
 uint8_t Output_Manager_LoadConfig(void)
 {
-  /* In a real implementation, this would load the configuration from flash memory
-     using the STM32 HAL flash functions. For this example, we'll set default values. */
+  /* Start from defaults so a missing or stale record leaves them in place */
+  Output_Manager_ResetConfig();
   
-  /* Set default serial configuration */
-  serialConfig.enabled = 1;
-  serialConfig.baudRate = 115200;
-  serialConfig.dataBits = 8;
-  serialConfig.stopBits = 1;
-  serialConfig.parity = 0;
-  serialConfig.format = SERIAL_FORMAT_RAW;
-  
-  /* Set default CAN configuration */
-  canConfig.enabled = 1;
-  canConfig.bitRate = 500000;
-  canConfig.mode = 0;  /* Normal mode */
-  canConfig.sjw = 1;
-  canConfig.bs1 = 6;
-  canConfig.bs2 = 7;
+  Config_Store_Read(CONFIG_KEY_OUTPUT_SERIAL, &serialConfig, sizeof(serialConfig));
+  Config_Store_Read(CONFIG_KEY_OUTPUT_CAN, &canConfig, sizeof(canConfig));
   
   return 1;
 }
@@ -322,6 +371,11 @@ static void Output_Manager_InitSerial(void)
   if (HAL_UART_Init(&huart1) != HAL_OK) {
     Error_Handler();
   }
+  
+  /* Received bytes go straight to the value cache, transmit stays polled */
+  __HAL_UART_ENABLE_IT(&huart1, UART_IT_RXNE);
+  HAL_NVIC_SetPriority(USART1_IRQn, SERIAL_RX_IRQ_PRIORITY, 0);
+  HAL_NVIC_EnableIRQ(USART1_IRQn);
 }
 
 /**
@@ -355,10 +409,36 @@ static void Output_Manager_InitCAN(void)
     Error_Handler();
   }
   
+  /* Accept all frames into FIFO 0, receivers filter by ID in software */
+  CAN_FilterTypeDef filter;
+  filter.FilterBank = 0;
+  filter.FilterMode = CAN_FILTERMODE_IDMASK;
+  filter.FilterScale = CAN_FILTERSCALE_32BIT;
+  filter.FilterIdHigh = 0x0000;
+  filter.FilterIdLow = 0x0000;
+  filter.FilterMaskIdHigh = 0x0000;
+  filter.FilterMaskIdLow = 0x0000;
+  filter.FilterFIFOAssignment = CAN_FILTER_FIFO0;
+  filter.FilterActivation = ENABLE;
+  filter.SlaveStartFilterBank = 14;
+  
+  if (HAL_CAN_ConfigFilter(&hcan1, &filter) != HAL_OK) {
+    Error_Handler();
+  }
+  
   /* Start CAN */
   if (HAL_CAN_Start(&hcan1) != HAL_OK) {
     Error_Handler();
   }
+  
+  /* The FIFO holds three frames, it is emptied by interrupt so a long
+     display update in the main loop cannot overrun it */
+  if (HAL_CAN_ActivateNotification(&hcan1, CAN_IT_RX_FIFO0_MSG_PENDING) != HAL_OK) {
+    Error_Handler();
+  }
+  
+  HAL_NVIC_SetPriority(CAN1_RX0_IRQn, CAN_RX_IRQ_PRIORITY, 0);
+  HAL_NVIC_EnableIRQ(CAN1_RX0_IRQn);
 }
 
 /**
@@ -376,6 +456,7 @@ static void Output_Manager_ProcessSerial(void)
     /* Update buffer pointers */
     serialTxHead = (serialTxHead + 1) % MAX_SERIAL_BUFFER_SIZE;
     serialTxCount--;
+    serialTxByteCount++;
   }
 }
 
@@ -386,8 +467,8 @@ static void Output_Manager_ProcessSerial(void)
   */
 static void Output_Manager_ProcessCAN(void)
 {
-  /* Check if there's data to send and CAN is ready */
-  if (canTxCount > 0 && HAL_CAN_GetTxMailboxesFreeLevel(&hcan1) > 0) {
+  /* Fill every free mailbox, segmented transfers queue frames in bursts */
+  while (canTxCount > 0 && HAL_CAN_GetTxMailboxesFreeLevel(&hcan1) > 0) {
     /* Prepare CAN message */
     CAN_TxHeaderTypeDef txHeader;
     uint32_t txMailbox;
@@ -410,7 +491,96 @@ static void Output_Manager_ProcessCAN(void)
       /* Update buffer pointers */
       canTxHead = (canTxHead + 1) % MAX_CAN_BUFFER_SIZE;
       canTxCount--;
+      canTxFrameCount++;
+    }
+  }
+}
+
+/**
+  * @brief  Dispatch frames queued by the receive interrupt to registered callbacks
+  * @param  None
+  * @retval None
+  */
+static void Output_Manager_ReceiveCAN(void)
+{
+  while (canRxQueueHead != canRxQueueTail) {
+    uint8_t head = canRxQueueHead;
+    
+    for (uint8_t i = 0; i < canRxCallbackCount; i++) {
+      canRxCallbacks[i](canRxQueueIds[head], canRxQueueData[head], canRxQueueLengths[head]);
     }
+    
+    /* The slot is handed back only after the callbacks are done with it */
+    canRxQueueHead = (head + 1) & CAN_RX_QUEUE_MASK;
+  }
+}
+
+/**
+  * @brief  Drain CAN receive FIFO 0 into the value cache and the receive queue
+  * @note   Runs in the CAN1 RX0 interrupt. The cache update is one hash probe,
+  *         callbacks run later from the main loop.
+  * @param  hcan: CAN handle
+  * @retval None
+  */
+void HAL_CAN_RxFifo0MsgPendingCallback(CAN_HandleTypeDef* hcan)
+{
+  CAN_RxHeaderTypeDef rxHeader;
+  uint8_t rxData[8];
+  
+  while (HAL_CAN_GetRxFifoFillLevel(hcan, CAN_RX_FIFO0) > 0) {
+    if (HAL_CAN_GetRxMessage(hcan, CAN_RX_FIFO0, &rxHeader, rxData) != HAL_OK) {
+      break;
+    }
+    
+    uint32_t canId = (rxHeader.IDE == CAN_ID_STD) ? rxHeader.StdId : rxHeader.ExtId;
+    uint8_t length = rxHeader.DLC > 8 ? 8 : (uint8_t)rxHeader.DLC;
+    
+    Rx_Cache_UpdateCAN(canId, rxData, length);
+    Data_Logger_Record(DATA_LOGGER_SOURCE_CAN_RX, canId, rxData, length);
+    canRxFrameCount++;
+    
+    uint8_t tail = canRxQueueTail;
+    uint8_t next = (tail + 1) & CAN_RX_QUEUE_MASK;
+    
+    if (next == canRxQueueHead) {
+      canRxDropCount++;
+      continue;
+    }
+    
+    canRxQueueIds[tail] = canId;
+    canRxQueueLengths[tail] = length;
+    memcpy(canRxQueueData[tail], rxData, length);
+    
+    canRxQueueTail = next;
+  }
+}
+
+/**
+  * @brief  CAN1 FIFO 0 interrupt handler
+  * @param  None
+  * @retval None
+  */
+void CAN1_RX0_IRQHandler(void)
+{
+  HAL_CAN_IRQHandler(&hcan1);
+}
+
+/**
+  * @brief  USART1 interrupt handler, feeds received bytes to the value cache
+  * @param  None
+  * @retval None
+  */
+void USART1_IRQHandler(void)
+{
+  uint32_t status = huart1.Instance->SR;
+  uint32_t errors = status & (USART_SR_ORE | USART_SR_NE | USART_SR_FE | USART_SR_PE);
+  
+  if (status & (USART_SR_RXNE | errors)) {
+    /* Reading DR after SR clears RXNE and the error flags */
+    uint8_t byte = (uint8_t)huart1.Instance->DR;
+    
+    /* A damaged or lost byte spoils the line it belongs to */
+    Rx_Cache_ReceiveSerial(errors ? 0 : byte);
   }
 }
 
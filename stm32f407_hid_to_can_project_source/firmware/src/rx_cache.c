@@ -0,0 +1,337 @@
+/**
+ * @file rx_cache.c
+ * @brief Received value cache implementation for STM32F407 HID to Serial/CAN project
+ * @author Manus AI
+ * @date 2025-03-28
+ *
+ * Keeps the last frame of every subscribed CAN ID and the last value of every
+ * serial field, so the display can show live bus data without looking at the
+ * receive path. Writers run in the receive interrupts, readers in the main
+ * loop. Each entry carries a sequence counter that is odd while the writer
+ * is inside it; a reader copies the entry and repeats the copy if the counter
+ * moved, so the writer never waits.
+ *
+ * Serial input is text, one line per frame with decimal fields separated by
+ * commas, e.g. "3250,87,-12\n". Field n of the last complete line is field n
+ * of the cache; empty fields keep their previous value.
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "rx_cache.h"
+#include "main.h"
+#include <stdint.h>
+#include <string.h>
+
+/* Private typedef -----------------------------------------------------------*/
+typedef struct {
+  volatile uint32_t canId;      /* RX_CACHE_ID_EMPTY while the slot is free */
+  volatile uint32_t sequence;   /* Odd while the frame is being written */
+  uint32_t timestamp;
+  uint32_t count;
+  uint8_t length;
+  uint8_t data[8];
+} Rx_Cache_Entry_t;
+
+/* Private define ------------------------------------------------------------*/
+#define RX_CACHE_ID_EMPTY         0xFFFFFFFFUL
+#define RX_CACHE_CAN_ID_MAX       0x1FFFFFFFUL
+#define RX_CACHE_CAN_SLOT_MASK    (RX_CACHE_CAN_SLOTS - 1)
+
+/* Private macro -------------------------------------------------------------*/
+/* Fibonacci hashing, the top bits of the product pick the slot */
+#define RX_CACHE_HASH(canId)      ((uint32_t)((canId) * 2654435761UL) >> (32 - RX_CACHE_CAN_SLOT_BITS))
+
+/* Private variables ---------------------------------------------------------*/
+/* Open addressed with linear probing, slots are only ever added */
+static Rx_Cache_Entry_t canEntries[RX_CACHE_CAN_SLOTS];
+static uint8_t canIdCount = 0;
+
+/* Published serial fields */
+static int32_t serialFields[RX_CACHE_SERIAL_FIELDS];
+static uint32_t serialValidMask = 0;
+static volatile uint32_t serialSequence = 0;
+
+/* Line being parsed, only touched by the receive interrupt */
+static int32_t serialStage[RX_CACHE_SERIAL_FIELDS];
+static uint32_t serialStageMask = 0;
+static uint8_t serialFieldIndex = 0;
+static uint32_t serialFieldValue = 0;
+static uint8_t serialFieldDigits = 0;
+static uint8_t serialFieldNegative = 0;
+static uint8_t serialLineError = 0;
+
+/* Private function prototypes -----------------------------------------------*/
+static Rx_Cache_Entry_t* Rx_Cache_FindCAN(uint32_t canId);
+static void Rx_Cache_EndField(void);
+static void Rx_Cache_EndLine(void);
+
+/**
+  * @brief  Received value cache initialization function
+  * @note   Drops all subscriptions, call before the receive interrupts are enabled.
+  * @param  None
+  * @retval None
+  */
+void Rx_Cache_Init(void)
+{
+  memset(canEntries, 0, sizeof(canEntries));
+  
+  for (uint8_t i = 0; i < RX_CACHE_CAN_SLOTS; i++) {
+    canEntries[i].canId = RX_CACHE_ID_EMPTY;
+  }
+  
+  canIdCount = 0;
+  
+  memset(serialFields, 0, sizeof(serialFields));
+  serialValidMask = 0;
+  serialSequence = 0;
+  
+  serialStageMask = 0;
+  serialFieldIndex = 0;
+  serialFieldValue = 0;
+  serialFieldDigits = 0;
+  serialFieldNegative = 0;
+  serialLineError = 0;
+}
+
+/**
+  * @brief  Start caching the frames of a CAN ID
+  * @note   Main loop only. The slot is filled before its ID is published, so
+  *         the receive interrupt either skips it or sees an empty frame.
+  * @param  canId: Standard or extended CAN identifier
+  * @retval uint8_t: 1 if the ID is cached, 0 if the cache is full
+  */
+uint8_t Rx_Cache_Subscribe(uint32_t canId)
+{
+  if (canId > RX_CACHE_CAN_ID_MAX) {
+    return 0;
+  }
+  
+  if (Rx_Cache_FindCAN(canId) != NULL) {
+    return 1;
+  }
+  
+  if (canIdCount >= RX_CACHE_CAN_MAX_IDS) {
+    return 0;
+  }
+  
+  uint32_t slot = RX_CACHE_HASH(canId);
+  
+  while (canEntries[slot].canId != RX_CACHE_ID_EMPTY) {
+    slot = (slot + 1) & RX_CACHE_CAN_SLOT_MASK;
+  }
+  
+  Rx_Cache_Entry_t* entry = &canEntries[slot];
+  entry->sequence = 0;
+  entry->timestamp = 0;
+  entry->count = 0;
+  entry->length = 0;
+  memset(entry->data, 0, sizeof(entry->data));
+  
+  __DMB();
+  entry->canId = canId;
+  canIdCount++;
+  
+  return 1;
+}
+
+/**
+  * @brief  Store a received CAN frame if its ID is subscribed
+  * @note   Called from the CAN receive interrupt, one hash probe per frame.
+  * @param  canId: CAN identifier
+  * @param  data: Frame data
+  * @param  length: Data length
+  * @retval None
+  */
+void Rx_Cache_UpdateCAN(uint32_t canId, const uint8_t* data, uint8_t length)
+{
+  Rx_Cache_Entry_t* entry = Rx_Cache_FindCAN(canId);
+  
+  if (entry == NULL) {
+    return;
+  }
+  
+  if (length > sizeof(entry->data)) {
+    length = sizeof(entry->data);
+  }
+  
+  entry->sequence++;
+  __DMB();
+  
+  memcpy(entry->data, data, length);
+  entry->length = length;
+  entry->timestamp = HAL_GetTick();
+  entry->count++;
+  
+  __DMB();
+  entry->sequence++;
+}
+
+/**
+  * @brief  Copy the last frame of a CAN ID
+  * @note   Never blocks the writer, the copy is repeated if a frame arrived
+  *         while it was taken.
+  * @param  canId: CAN identifier
+  * @param  frame: Pointer to the frame copy
+  * @retval uint8_t: 1 if a frame has been received for the ID, 0 otherwise
+  */
+uint8_t Rx_Cache_ReadCAN(uint32_t canId, Rx_Cache_Frame_t* frame)
+{
+  Rx_Cache_Entry_t* entry = Rx_Cache_FindCAN(canId);
+  uint32_t sequence;
+  
+  if (entry == NULL) {
+    return 0;
+  }
+  
+  do {
+    sequence = entry->sequence;
+    __DMB();
+    
+    memcpy(frame->data, entry->data, sizeof(frame->data));
+    frame->length = entry->length;
+    frame->timestamp = entry->timestamp;
+    frame->count = entry->count;
+    
+    __DMB();
+  } while ((sequence & 1) || entry->sequence != sequence);
+  
+  return frame->count > 0;
+}
+
+/**
+  * @brief  Feed one received serial byte into the line parser
+  * @note   Called from the serial receive interrupt, constant time per byte.
+  *         A line with anything but digits, signs, spaces and separators is
+  *         dropped as a whole.
+  * @param  byte: Received byte
+  * @retval None
+  */
+void Rx_Cache_ReceiveSerial(uint8_t byte)
+{
+  if (byte >= '0' && byte <= '9') {
+    /* Saturate rather than wrap on runaway numbers */
+    if (serialFieldValue < 0x7FFFFFFFUL / 10) {
+      serialFieldValue = serialFieldValue * 10 + (byte - '0');
+    } else {
+      serialFieldValue = 0x7FFFFFFFUL;
+    }
+    
+    serialFieldDigits++;
+  } else if (byte == '-' && serialFieldDigits == 0) {
+    serialFieldNegative = 1;
+  } else if (byte == RX_CACHE_SERIAL_SEPARATOR) {
+    Rx_Cache_EndField();
+  } else if (byte == '\n') {
+    Rx_Cache_EndLine();
+  } else if (byte != ' ' && byte != '\t' && byte != '\r') {
+    serialLineError = 1;
+  }
+}
+
+/**
+  * @brief  Get a field of the last serial line
+  * @param  fieldIndex: Field position in the line, from 0
+  * @param  value: Pointer to the field value
+  * @retval uint8_t: 1 if the field has been received, 0 otherwise
+  */
+uint8_t Rx_Cache_ReadSerial(uint8_t fieldIndex, int32_t* value)
+{
+  uint32_t sequence;
+  uint8_t valid;
+  
+  if (fieldIndex >= RX_CACHE_SERIAL_FIELDS) {
+    return 0;
+  }
+  
+  do {
+    sequence = serialSequence;
+    __DMB();
+    
+    valid = (serialValidMask >> fieldIndex) & 1;
+    *value = serialFields[fieldIndex];
+    
+    __DMB();
+  } while ((sequence & 1) || serialSequence != sequence);
+  
+  return valid;
+}
+
+/**
+  * @brief  Find the slot of a subscribed CAN ID
+  * @param  canId: CAN identifier
+  * @retval Rx_Cache_Entry_t*: Slot, NULL if the ID is not subscribed
+  */
+static Rx_Cache_Entry_t* Rx_Cache_FindCAN(uint32_t canId)
+{
+  uint32_t slot = RX_CACHE_HASH(canId);
+  
+  /* At most half the slots are used, so a miss ends on a free slot quickly */
+  for (uint8_t probe = 0; probe < RX_CACHE_CAN_SLOTS; probe++) {
+    uint32_t slotId = canEntries[slot].canId;
+    
+    if (slotId == canId) {
+      return &canEntries[slot];
+    }
+    
+    if (slotId == RX_CACHE_ID_EMPTY) {
+      return NULL;
+    }
+    
+    slot = (slot + 1) & RX_CACHE_CAN_SLOT_MASK;
+  }
+  
+  return NULL;
+}
+
+/**
+  * @brief  Stage the field that ends at a separator or line end
+  * @param  None
+  * @retval None
+  */
+static void Rx_Cache_EndField(void)
+{
+  if (serialFieldDigits > 0 && serialFieldIndex < RX_CACHE_SERIAL_FIELDS) {
+    int32_t value = (int32_t)serialFieldValue;
+    
+    serialStage[serialFieldIndex] = serialFieldNegative ? -value : value;
+    serialStageMask |= 1UL << serialFieldIndex;
+  }
+  
+  if (serialFieldIndex < 0xFF) {
+    serialFieldIndex++;
+  }
+  
+  serialFieldValue = 0;
+  serialFieldDigits = 0;
+  serialFieldNegative = 0;
+}
+
+/**
+  * @brief  Publish the fields of a complete line and start the next one
+  * @param  None
+  * @retval None
+  */
+static void Rx_Cache_EndLine(void)
+{
+  Rx_Cache_EndField();
+  
+  if (!serialLineError && serialStageMask != 0) {
+    serialSequence++;
+    __DMB();
+    
+    for (uint8_t i = 0; i < RX_CACHE_SERIAL_FIELDS; i++) {
+      if (serialStageMask & (1UL << i)) {
+        serialFields[i] = serialStage[i];
+      }
+    }
+    
+    serialValidMask |= serialStageMask;
+    
+    __DMB();
+    serialSequence++;
+  }
+  
+  serialStageMask = 0;
+  serialFieldIndex = 0;
+  serialLineError = 0;
+}
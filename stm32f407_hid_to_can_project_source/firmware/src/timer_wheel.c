@@ -0,0 +1,250 @@
+/**
+ * @file timer_wheel.c
+ * @brief Hierarchical timer wheel implementation for STM32F407 HID to Serial/CAN project
+ * @author Manus AI
+ * @date 2025-03-28
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "timer_wheel.h"
+#include "main.h"
+#include <stdint.h>
+#include <string.h>
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private define ------------------------------------------------------------*/
+#define TIMER_WHEEL_SLOT_MASK     (TIMER_WHEEL_SLOTS - 1)
+
+/* Private macro -------------------------------------------------------------*/
+#define TIMER_WHEEL_LEVEL_SPAN(level)  (1UL << (TIMER_WHEEL_SLOT_BITS * ((level) + 1)))
+#define TIMER_WHEEL_INDEX(expires, level) \
+  (((expires) >> (TIMER_WHEEL_SLOT_BITS * (level))) & TIMER_WHEEL_SLOT_MASK)
+
+/* Private variables ---------------------------------------------------------*/
+/* Level 0 holds timers due within 64 ticks, each further level covers 64 times
+   the span of the one below. Timers move down a level when their slot comes up. */
+static Timer_Wheel_Timer_t* wheelSlots[TIMER_WHEEL_LEVELS][TIMER_WHEEL_SLOTS];
+static uint32_t wheelTick = 0;
+static uint32_t wheelActiveCount = 0;
+
+/* Private function prototypes -----------------------------------------------*/
+static void Timer_Wheel_Insert(Timer_Wheel_Timer_t* timer);
+static void Timer_Wheel_Unlink(Timer_Wheel_Timer_t* timer);
+static void Timer_Wheel_Cascade(uint8_t level);
+static void Timer_Wheel_Tick(void);
+
+/**
+  * @brief  Timer wheel initialization function
+  * @param  None
+  * @retval None
+  */
+void Timer_Wheel_Init(void)
+{
+  memset(wheelSlots, 0, sizeof(wheelSlots));
+  wheelTick = HAL_GetTick();
+  wheelActiveCount = 0;
+}
+
+/**
+  * @brief  Timer wheel process function, should be called periodically
+  * @note   Advances the wheel to the current system tick and runs the
+  *         callbacks of all expired timers. Each tick costs one slot visit
+  *         regardless of how many timers are armed.
+  * @param  None
+  * @retval None
+  */
+void Timer_Wheel_Process(void)
+{
+  uint32_t now = HAL_GetTick();
+  
+  /* Nothing armed, just catch up */
+  if (wheelActiveCount == 0) {
+    wheelTick = now;
+    return;
+  }
+  
+  while ((int32_t)(now - wheelTick) > 0 && wheelActiveCount > 0) {
+    Timer_Wheel_Tick();
+  }
+  
+  if (wheelActiveCount == 0) {
+    wheelTick = now;
+  }
+}
+
+/**
+  * @brief  Arm a timer, restarting it if it is already armed
+  * @param  timer: Pointer to timer
+  * @param  delayMs: Delay in milliseconds, clamped to 1..TIMER_WHEEL_MAX_DELAY
+  * @param  callback: Function called from Timer_Wheel_Process on expiry
+  * @param  context: Argument passed to the callback
+  * @retval None
+  */
+void Timer_Wheel_Start(Timer_Wheel_Timer_t* timer, uint32_t delayMs, Timer_Wheel_Callback_t callback, void* context)
+{
+  if (timer == NULL || callback == NULL) {
+    return;
+  }
+  
+  Timer_Wheel_Stop(timer);
+  
+  if (wheelActiveCount == 0) {
+    wheelTick = HAL_GetTick();
+  }
+  
+  if (delayMs == 0) {
+    delayMs = 1;
+  }
+  
+  /* Due time is measured from the system tick, the wheel may still be behind */
+  uint32_t expires = HAL_GetTick() + delayMs;
+  if (expires - wheelTick > TIMER_WHEEL_MAX_DELAY) {
+    expires = wheelTick + TIMER_WHEEL_MAX_DELAY;
+  }
+  
+  timer->expires = expires;
+  timer->callback = callback;
+  timer->context = context;
+  timer->active = 1;
+  
+  Timer_Wheel_Insert(timer);
+  wheelActiveCount++;
+}
+
+/**
+  * @brief  Disarm a timer
+  * @param  timer: Pointer to timer
+  * @retval None
+  */
+void Timer_Wheel_Stop(Timer_Wheel_Timer_t* timer)
+{
+  if (timer == NULL || !timer->active) {
+    return;
+  }
+  
+  Timer_Wheel_Unlink(timer);
+  timer->active = 0;
+  wheelActiveCount--;
+}
+
+/**
+  * @brief  Check whether a timer is armed
+  * @param  timer: Pointer to timer
+  * @retval uint8_t: 1 if armed, 0 otherwise
+  */
+uint8_t Timer_Wheel_IsActive(const Timer_Wheel_Timer_t* timer)
+{
+  return (timer != NULL && timer->active) ? 1 : 0;
+}
+
+/**
+  * @brief  Get number of armed timers
+  * @param  None
+  * @retval uint32_t: Number of armed timers
+  */
+uint32_t Timer_Wheel_GetActiveCount(void)
+{
+  return wheelActiveCount;
+}
+
+/**
+  * @brief  Link a timer into the slot matching its due time
+  * @param  timer: Pointer to timer
+  * @retval None
+  */
+static void Timer_Wheel_Insert(Timer_Wheel_Timer_t* timer)
+{
+  uint32_t delta = timer->expires - wheelTick;
+  uint8_t level = 0;
+  
+  while (level < TIMER_WHEEL_LEVELS - 1 && delta >= TIMER_WHEEL_LEVEL_SPAN(level)) {
+    level++;
+  }
+  
+  Timer_Wheel_Timer_t** slot = &wheelSlots[level][TIMER_WHEEL_INDEX(timer->expires, level)];
+  
+  timer->prev = NULL;
+  timer->next = *slot;
+  if (*slot != NULL) {
+    (*slot)->prev = timer;
+  }
+  *slot = timer;
+}
+
+/**
+  * @brief  Remove a timer from whatever slot it is linked into
+  * @param  timer: Pointer to timer
+  * @retval None
+  */
+static void Timer_Wheel_Unlink(Timer_Wheel_Timer_t* timer)
+{
+  if (timer->next != NULL) {
+    timer->next->prev = timer->prev;
+  }
+  
+  if (timer->prev != NULL) {
+    timer->prev->next = timer->next;
+  } else {
+    /* Head of its slot, find the slot from the due time */
+    for (uint8_t level = 0; level < TIMER_WHEEL_LEVELS; level++) {
+      Timer_Wheel_Timer_t** slot = &wheelSlots[level][TIMER_WHEEL_INDEX(timer->expires, level)];
+      if (*slot == timer) {
+        *slot = timer->next;
+        break;
+      }
+    }
+  }
+  
+  timer->next = NULL;
+  timer->prev = NULL;
+}
+
+/**
+  * @brief  Redistribute the current slot of a level into the levels below
+  * @param  level: Wheel level, 1 or higher
+  * @retval None
+  */
+static void Timer_Wheel_Cascade(uint8_t level)
+{
+  Timer_Wheel_Timer_t** slot = &wheelSlots[level][TIMER_WHEEL_INDEX(wheelTick, level)];
+  Timer_Wheel_Timer_t* timer = *slot;
+  
+  *slot = NULL;
+  
+  while (timer != NULL) {
+    Timer_Wheel_Timer_t* next = timer->next;
+    Timer_Wheel_Insert(timer);
+    timer = next;
+  }
+}
+
+/**
+  * @brief  Advance the wheel by one tick and run expired timers
+  * @param  None
+  * @retval None
+  */
+static void Timer_Wheel_Tick(void)
+{
+  wheelTick++;
+  
+  /* Pull the next block of timers down whenever a lower level wraps */
+  for (uint8_t level = 1; level < TIMER_WHEEL_LEVELS; level++) {
+    if (TIMER_WHEEL_INDEX(wheelTick, level - 1) != 0) {
+      break;
+    }
+    Timer_Wheel_Cascade(level);
+  }
+  
+  /* Callbacks may start or stop timers, so take one timer at a time */
+  Timer_Wheel_Timer_t** slot = &wheelSlots[0][TIMER_WHEEL_INDEX(wheelTick, 0)];
+  
+  while (*slot != NULL) {
+    Timer_Wheel_Timer_t* timer = *slot;
+    
+    Timer_Wheel_Unlink(timer);
+    timer->active = 0;
+    wheelActiveCount--;
+    
+    timer->callback(timer->context);
+  }
+}
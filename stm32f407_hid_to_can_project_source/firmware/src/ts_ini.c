@@ -0,0 +1,399 @@
+/**
+ * @file ts_ini.c
+ * @brief TunerStudio INI generator implementation for STM32F407 HID to Serial/CAN project
+ * @author Manus AI
+ * @date 2025-03-28
+ *
+ * Renders the INI described by ts_protocol.h as a stream. Only the current
+ * line is held in memory, a reader pulls any number of bytes at a time and
+ * the generator picks up where the previous read stopped. The firmware and
+ * tools/gen_ts_ini.c share this file, it uses no HAL functions.
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "ts_ini.h"
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+/* Private typedef -----------------------------------------------------------*/
+typedef enum {
+  TS_INI_SECTION_HEADER = 0,
+  TS_INI_SECTION_MEGATUNE,
+  TS_INI_SECTION_CONSTANTS,
+  TS_INI_SECTION_OUTPUT_CHANNELS,
+  TS_INI_SECTION_MENU,
+  TS_INI_SECTION_DIALOGS,
+  TS_INI_SECTION_END
+} TS_Ini_Section_t;
+
+/* Numbers are kept as written in ts_protocol.h, printf needs no float support */
+typedef struct {
+  const char* name;
+  const char* type;
+  uint16_t offset;
+  const char* label;
+  const char* units;
+  const char* scale;
+  const char* translate;
+  const char* min;
+  const char* max;
+  const char* digits;
+} TS_Ini_Field_t;
+
+typedef struct {
+  const char* id;
+  const char* title;
+  const TS_Ini_Field_t* fields;
+  uint8_t fieldCount;
+  uint16_t size;
+} TS_Ini_Page_t;
+
+typedef struct {
+  const char* name;
+  const char* type;
+  uint16_t offset;
+  const char* units;
+  const char* scale;
+  const char* translate;
+} TS_Ini_Channel_t;
+
+/* Private define ------------------------------------------------------------*/
+#define TS_INI_PAGE_COUNT         (sizeof(tsIniPages) / sizeof(tsIniPages[0]))
+#define TS_INI_CHANNEL_COUNT      (sizeof(tsIniChannels) / sizeof(tsIniChannels[0]))
+#define TS_INI_CONSTANTS_LINES    11    /* Constants lines before the first page */
+
+/* Private macro -------------------------------------------------------------*/
+#define TS_INI_FIELD(page, name, type, label, units, scale, translate, min, max, digits, value) \
+  {#name, #type, offsetof(TS_Page_##page##_t, name), label, units, #scale, #translate, #min, #max, #digits},
+#define TS_INI_PAGE_FIELDS(id, title, fields) \
+  static const TS_Ini_Field_t tsIniFields_##id[] = { fields(TS_INI_FIELD, id) };
+#define TS_INI_PAGE(id, title, fields) \
+  {#id, title, tsIniFields_##id, sizeof(tsIniFields_##id) / sizeof(tsIniFields_##id[0]), sizeof(TS_Page_##id##_t)},
+#define TS_INI_CHANNEL(name, type, units, scale, translate) \
+  {#name, #type, offsetof(TS_Channel_Block_t, name), units, #scale, #translate},
+
+/* Private variables ---------------------------------------------------------*/
+TS_PAGES(TS_INI_PAGE_FIELDS)
+
+static const TS_Ini_Page_t tsIniPages[] = {
+  TS_PAGES(TS_INI_PAGE)
+};
+
+static const TS_Ini_Channel_t tsIniChannels[] = {
+  TS_OUTPUT_CHANNELS(TS_INI_CHANNEL)
+};
+
+/* Private function prototypes -----------------------------------------------*/
+static uint8_t TS_Ini_NextLine(TS_Ini_Stream_t* stream);
+static uint8_t TS_Ini_RenderLine(TS_Ini_Stream_t* stream);
+static uint8_t TS_Ini_RenderConstants(TS_Ini_Stream_t* stream);
+static uint8_t TS_Ini_RenderDialogs(TS_Ini_Stream_t* stream);
+static const TS_Ini_Page_t* TS_Ini_FindPageLine(uint16_t index, uint8_t* pageIndex, uint8_t* line);
+static uint8_t TS_Ini_Print(TS_Ini_Stream_t* stream, const char* format, ...);
+static void TS_Ini_Append(TS_Ini_Stream_t* stream, const char* format, ...);
+
+/**
+  * @brief  Start streaming the INI from the beginning
+  * @param  stream: Stream state, owned by the caller
+  * @retval None
+  */
+void TS_Ini_Start(TS_Ini_Stream_t* stream)
+{
+  memset(stream, 0, sizeof(TS_Ini_Stream_t));
+  stream->section = TS_INI_SECTION_HEADER;
+}
+
+/**
+  * @brief  Read the next part of the INI
+  * @note   Lines are rendered as they are needed, so a small buffer works as
+  *         well as a large one.
+  * @param  stream: Stream state
+  * @param  buffer: Destination, not terminated
+  * @param  size: Buffer size
+  * @retval uint16_t: Bytes written, 0 once the whole INI has been read
+  */
+uint16_t TS_Ini_Read(TS_Ini_Stream_t* stream, char* buffer, uint16_t size)
+{
+  uint16_t written = 0;
+  
+  while (written < size) {
+    if (stream->linePosition >= stream->lineLength && !TS_Ini_NextLine(stream)) {
+      break;
+    }
+    
+    uint16_t count = stream->lineLength - stream->linePosition;
+    
+    if (count > size - written) {
+      count = size - written;
+    }
+    
+    memcpy(&buffer[written], &stream->line[stream->linePosition], count);
+    stream->linePosition += count;
+    written += count;
+  }
+  
+  return written;
+}
+
+/**
+  * @brief  Render the next line, a blank line closes each section
+  * @param  stream: Stream state
+  * @retval uint8_t: 1 if a line was rendered, 0 at the end of the INI
+  */
+static uint8_t TS_Ini_NextLine(TS_Ini_Stream_t* stream)
+{
+  while (stream->section < TS_INI_SECTION_END) {
+    if (TS_Ini_RenderLine(stream)) {
+      stream->item++;
+      return 1;
+    }
+    
+    stream->section++;
+    stream->item = 0;
+    
+    return TS_Ini_Print(stream, "");
+  }
+  
+  return 0;
+}
+
+/**
+  * @brief  Render line stream->item of the current section
+  * @param  stream: Stream state
+  * @retval uint8_t: 1 if a line was rendered, 0 if the section is complete
+  */
+static uint8_t TS_Ini_RenderLine(TS_Ini_Stream_t* stream)
+{
+  uint16_t item = stream->item;
+  
+  switch (stream->section) {
+    case TS_INI_SECTION_HEADER:
+      switch (item) {
+        case 0: return TS_Ini_Print(stream, "; TunerStudio INI File for STM32F407 HID to Serial/CAN");
+        case 1: return TS_Ini_Print(stream, "; Generated from inc/ts_protocol.h, edit that file instead");
+        case 2: return TS_Ini_Print(stream, "; Also served over CAN with ISO 15765-2, requests on 0x%03X, responses on 0x%03X",
+                                    TS_CAN_REQUEST_ID, TS_CAN_RESPONSE_ID);
+        default: return 0;
+      }
+    
+    case TS_INI_SECTION_MEGATUNE:
+      switch (item) {
+        case 0: return TS_Ini_Print(stream, "[MegaTune]");
+        case 1: return TS_Ini_Print(stream, "signature = \"%s\"", TS_SIGNATURE);
+        case 2: return TS_Ini_Print(stream, "queryCommand = \"%c\"", TS_CMD_QUERY);
+        case 3: return TS_Ini_Print(stream, "versionInfo = \"%c\"", TS_CMD_HELLO);
+        case 4: return TS_Ini_Print(stream, "version = \"%s\"", TS_INI_VERSION);
+        default: return 0;
+      }
+    
+    case TS_INI_SECTION_CONSTANTS:
+      return TS_Ini_RenderConstants(stream);
+    
+    case TS_INI_SECTION_OUTPUT_CHANNELS:
+      if (item == 0) {
+        return TS_Ini_Print(stream, "[OutputChannels]");
+      }
+    
+      if (item == 1) {
+        return TS_Ini_Print(stream, "ochGetCommand = \"%c%%2o%%2c\"", TS_CMD_OUTPUT_CHANNELS);
+      }
+    
+      if (item == 2) {
+        return TS_Ini_Print(stream, "ochBlockSize = %u", (unsigned)sizeof(TS_Channel_Block_t));
+      }
+    
+      if (item - 3 < (int)TS_INI_CHANNEL_COUNT) {
+        const TS_Ini_Channel_t* channel = &tsIniChannels[item - 3];
+      
+        return TS_Ini_Print(stream, "%s = scalar, %s, %u, \"%s\", %s, %s",
+                            channel->name, channel->type, channel->offset,
+                            channel->units, channel->scale, channel->translate);
+      }
+      return 0;
+    
+    case TS_INI_SECTION_MENU:
+      if (item == 0) {
+        return TS_Ini_Print(stream, "[Menu]");
+      }
+    
+      if (item == 1) {
+        return TS_Ini_Print(stream, "menu = \"&Settings\"");
+      }
+    
+      if (item - 2 < (int)TS_INI_PAGE_COUNT) {
+        return TS_Ini_Print(stream, "subMenu = %s, \"%s\"", tsIniPages[item - 2].id, tsIniPages[item - 2].title);
+      }
+      return 0;
+    
+    case TS_INI_SECTION_DIALOGS:
+      return TS_Ini_RenderDialogs(stream);
+    
+    default:
+      return 0;
+  }
+}
+
+/**
+  * @brief  Render a line of the Constants section
+  * @param  stream: Stream state
+  * @retval uint8_t: 1 if a line was rendered, 0 after the last page
+  */
+static uint8_t TS_Ini_RenderConstants(TS_Ini_Stream_t* stream)
+{
+  switch (stream->item) {
+    case 0: return TS_Ini_Print(stream, "[Constants]");
+    case 1: return TS_Ini_Print(stream, "messageEnvelopeFormat = msEnvelope_1.0");
+    case 2: return TS_Ini_Print(stream, "endianness = little");
+    case 3: return TS_Ini_Print(stream, "nPages = %u", (unsigned)TS_INI_PAGE_COUNT);
+    
+    case 4:
+      /* One entry per page in each of the page lists */
+      TS_Ini_Print(stream, "pageSize =");
+    
+      for (uint8_t i = 0; i < TS_INI_PAGE_COUNT; i++) {
+        TS_Ini_Append(stream, "%s %u", i > 0 ? "," : "", tsIniPages[i].size);
+      }
+      return 1;
+    
+    case 5:
+      /* The page number is sent as 16-bit LE in place of %2i */
+      TS_Ini_Print(stream, "pageIdentifier =");
+    
+      for (uint8_t i = 0; i < TS_INI_PAGE_COUNT; i++) {
+        TS_Ini_Append(stream, "%s \"\\x%02X\\x00\"", i > 0 ? "," : "", i);
+      }
+      return 1;
+    
+    case 6: return TS_Ini_Print(stream, "blockingFactor = %d", TS_BLOCKING_FACTOR);
+    case 7: return TS_Ini_Print(stream, "pageReadCommand = \"%c%%2i%%2o%%2c\"", TS_CMD_READ_PAGE);
+    case 8: return TS_Ini_Print(stream, "pageChunkWrite = \"%c%%2i%%2o%%2c%%v\"", TS_CMD_WRITE_CHUNK);
+    case 9: return TS_Ini_Print(stream, "burnCommand = \"%c%%2i\"", TS_CMD_BURN_PAGE);
+    case 10: return TS_Ini_Print(stream, "crc32CheckCommand = \"%c%%2i%%2o%%2c\"", TS_CMD_PAGE_CRC);
+    default: break;
+  }
+  
+  /* Then each page with its fields */
+  uint8_t pageIndex;
+  uint8_t line;
+  const TS_Ini_Page_t* page = TS_Ini_FindPageLine(stream->item - TS_INI_CONSTANTS_LINES, &pageIndex, &line);
+  
+  if (page == NULL) {
+    return 0;
+  }
+  
+  if (line == 0) {
+    return TS_Ini_Print(stream, "\npage = %u", pageIndex + 1);
+  }
+  
+  const TS_Ini_Field_t* field = &page->fields[line - 1];
+  
+  return TS_Ini_Print(stream, "%s = scalar, %s, %u, \"%s\", %s, %s, %s, %s, %s",
+                      field->name, field->type, field->offset, field->units,
+                      field->scale, field->translate, field->min, field->max, field->digits);
+}
+
+/**
+  * @brief  Render a line of the dialogs, one dialog per page
+  * @param  stream: Stream state
+  * @retval uint8_t: 1 if a line was rendered, 0 after the last page
+  */
+static uint8_t TS_Ini_RenderDialogs(TS_Ini_Stream_t* stream)
+{
+  uint8_t pageIndex;
+  uint8_t line;
+  
+  if (stream->item == 0) {
+    return TS_Ini_Print(stream, "[UserDefined]");
+  }
+  
+  const TS_Ini_Page_t* page = TS_Ini_FindPageLine(stream->item - 1, &pageIndex, &line);
+  
+  if (page == NULL) {
+    return 0;
+  }
+  
+  if (line == 0) {
+    return TS_Ini_Print(stream, "dialog = %s, \"%s\"", page->id, page->title);
+  }
+  
+  return TS_Ini_Print(stream, "field = \"%s\", %s", page->fields[line - 1].label, page->fields[line - 1].name);
+}
+
+/**
+  * @brief  Locate a line of a per page listing
+  * @note   Each page takes one line for itself, then one per field.
+  * @param  index: Line number in the listing
+  * @param  pageIndex: Set to the page number
+  * @param  line: Set to 0 for the page line, else the field number plus one
+  * @retval const TS_Ini_Page_t*: Page, NULL past the last page
+  */
+static const TS_Ini_Page_t* TS_Ini_FindPageLine(uint16_t index, uint8_t* pageIndex, uint8_t* line)
+{
+  for (uint8_t i = 0; i < TS_INI_PAGE_COUNT; i++) {
+    if (index <= tsIniPages[i].fieldCount) {
+      *pageIndex = i;
+      *line = (uint8_t)index;
+      return &tsIniPages[i];
+    }
+    
+    index -= tsIniPages[i].fieldCount + 1;
+  }
+  
+  return NULL;
+}
+
+/**
+  * @brief  Replace the current line
+  * @param  stream: Stream state
+  * @param  format: printf format of the line, without the line end
+  * @retval uint8_t: 1
+  */
+static uint8_t TS_Ini_Print(TS_Ini_Stream_t* stream, const char* format, ...)
+{
+  va_list args;
+  
+  va_start(args, format);
+  int length = vsnprintf(stream->line, TS_INI_LINE_SIZE - 1, format, args);
+  va_end(args);
+  
+  if (length < 0) {
+    length = 0;
+  } else if (length > TS_INI_LINE_SIZE - 2) {
+    length = TS_INI_LINE_SIZE - 2;
+  }
+  
+  stream->line[length] = '\n';
+  stream->line[length + 1] = '\0';
+  stream->lineLength = length + 1;
+  stream->linePosition = 0;
+  
+  return 1;
+}
+
+/**
+  * @brief  Extend the current line
+  * @param  stream: Stream state
+  * @param  format: printf format of the text to add
+  * @retval None
+  */
+static void TS_Ini_Append(TS_Ini_Stream_t* stream, const char* format, ...)
+{
+  va_list args;
+  uint16_t end = stream->lineLength - 1;   /* Overwrite the line end */
+  
+  va_start(args, format);
+  int length = vsnprintf(&stream->line[end], TS_INI_LINE_SIZE - 1 - end, format, args);
+  va_end(args);
+  
+  if (length < 0) {
+    length = 0;
+  } else if (end + length > TS_INI_LINE_SIZE - 2) {
+    length = TS_INI_LINE_SIZE - 2 - end;
+  }
+  
+  end += length;
+  stream->line[end] = '\n';
+  stream->line[end + 1] = '\0';
+  stream->lineLength = end + 1;
+}
@@ -8,41 +8,242 @@
 /* Includes ------------------------------------------------------------------*/
 #include "tunerstudio.h"
 #include "main.h"
+#include "config_store.h"
+#include "crc32.h"
+#include "mapping_engine.h"
+#include "output_manager.h"
+#include "timer_wheel.h"
+#include "boot_monitor.h"
+#include "isotp.h"
+#include "data_logger.h"
+#include <stddef.h>
 #include <stdint.h>
 #include <string.h>
 #include <stdio.h>
 #include <stdlib.h>
 
 /* Private typedef -----------------------------------------------------------*/
+/* Live values behind the output channels, filled once per 'O' request */
+#define TS_VALUE_CHANNEL(name, type, ...)   TS_TYPE_C(type) name;
+
+typedef struct {
+  TS_OUTPUT_CHANNELS(TS_VALUE_CHANNEL)
+} TS_Channel_Values_t;
+
+/* Copy plan entry, where a channel value lands in the block */
+typedef struct {
+  uint8_t offset;           /* In TS_Channel_Block_t */
+  uint8_t size;
+  uint8_t source;           /* In TS_Channel_Values_t */
+} TS_Channel_Copy_t;
+
+/* Field plan entry, where a page field lives */
+typedef struct {
+  uint8_t page;
+  uint16_t offset;          /* In TS_Page_t */
+  uint8_t size;
+} TS_Page_Field_t;
+
+/* Moves a page between its fields and the live configuration they stand for */
+typedef struct {
+  void (*capture)(void);    /* Live configuration into the page */
+  void (*apply)(void);      /* Page into the live configuration */
+} TS_Page_Binding_t;
+
+/* One piece of a serial response, sent by DMA from where it lives */
+typedef struct {
+  const uint8_t* data;
+  uint16_t length;
+} TS_Tx_Descriptor_t;
+
+/* Counters at the start of the rate window */
+typedef struct {
+  uint32_t tick;
+  uint32_t canTxFrames;
+  uint32_t canRxFrames;
+  uint32_t serialTxBytes;
+  uint32_t mappingEvents;
+  uint32_t tsSerialBytes;
+  uint32_t tsCanBytes;
+} TS_Rate_Window_t;
+
 /* Private define ------------------------------------------------------------*/
-#define TS_CONFIG_ADDR       0x080A0000  /* Flash sector for configuration storage */
-#define TS_CONFIG_SIZE       (sizeof(TS_Config_t) + 8)
+#define TS_RX_DMA_STREAM          DMA1_Stream5
+#define TS_RX_DMA_CHANNEL         DMA_CHANNEL_4
+#define TS_RX_DMA_IRQn            DMA1_Stream5_IRQn
+#define TS_RX_RING_MASK           (TS_RX_RING_SIZE - 1)
+#define TS_RX_IRQ_PRIORITY        6
+#define TS_TX_DMA_STREAM          DMA1_Stream6
+#define TS_TX_DMA_CHANNEL         DMA_CHANNEL_4
+#define TS_TX_DMA_IRQn            DMA1_Stream6_IRQn
+#define TS_TX_QUEUE_SIZE          4     /* Header, data and trailer of one frame */
+#define TS_TX_TIMEOUT_MS          100   /* Allowed on top of the line time of a response */
+#define TS_FRAME_TIMEOUT_MS       100   /* A frame that stops arriving is dropped */
+#define TS_RATE_WINDOW_MS         1000  /* Rates and the loop peak cover at least this long */
+#define TS_BURN_CHUNK_SIZE        32    /* Page bytes per dirty bit and per flash record */
+#define TS_BURN_MAX_CHUNKS        32    /* Bits in a dirty bitmap */
+#define TS_BURN_RETRY_MS          1000  /* Wait after a failed chunk write */
 
 /* Private macro -------------------------------------------------------------*/
+#define TS_RX_PEEK(offset)        (tsRxRing[(tsRxTail + (offset)) & TS_RX_RING_MASK])
+#define TS_GET_U16(data)          ((uint16_t)((data)[0] | ((data)[1] << 8)))
+#define TS_GET_U32(data)          ((uint32_t)TS_GET_U16(data) | ((uint32_t)TS_GET_U16((data) + 2) << 16))
+#define TS_SATURATE_U16(value)    ((uint16_t)((value) > 0xFFFF ? 0xFFFF : (value)))
+#define TS_COPY_CHANNEL(name, type, ...) \
+  {offsetof(TS_Channel_Block_t, name), TS_TYPE_SIZE(type), offsetof(TS_Channel_Values_t, name)},
+#define TS_PAGE_SIZE(id, title, fields) \
+  sizeof(TS_Page_##id##_t),
+#define TS_PLAN_FIELD(page, name, type, ...) \
+  {TS_PAGE_##page, offsetof(TS_Page_t, page.name), TS_TYPE_SIZE(type)},
+#define TS_PLAN_PAGE(id, title, fields) \
+  fields(TS_PLAN_FIELD, id)
+#define TS_CHUNK_COUNT(size)      (((size) + TS_BURN_CHUNK_SIZE - 1) / TS_BURN_CHUNK_SIZE)
+#define TS_CHUNK_MASK(size)       ((uint32_t)(0xFFFFFFFFULL >> (TS_BURN_MAX_CHUNKS - TS_CHUNK_COUNT(size))))
+#define TS_FIELD_GET(page, name) \
+  TS_GetValue(tsPages[TS_PAGE_##page].page.name, sizeof(tsPages[0].page.name))
+#define TS_FIELD_PUT(page, name, value) \
+  TS_PutValue(tsPages[TS_PAGE_##page].page.name, sizeof(tsPages[0].page.name), (uint32_t)(value))
+#define TS_DEFAULT_FIELD(page, name, type, label, units, scale, translate, min, max, digits, value) \
+  TS_FIELD_PUT(page, name, value);
+/* Limits are in INI units, a raw value below min wraps above the span */
+#define TS_RAW_LIMIT(limit, scale, translate) \
+  ((uint32_t)(((limit) - (translate)) / (scale)))
+#define TS_CHECK_FIELD(page, name, type, label, units, scale, translate, min, max, ...) \
+  if (TS_FIELD_GET(page, name) - TS_RAW_LIMIT(min, scale, translate) > \
+      TS_RAW_LIMIT(max, scale, translate) - TS_RAW_LIMIT(min, scale, translate)) { \
+    return 0; \
+  }
+#define TS_CHECK_PAGE(id, title, fields) \
+  case TS_PAGE_##id: \
+    fields(TS_CHECK_FIELD, id) \
+    break;
+#define TS_DEFAULT_PAGE(id, title, fields) \
+  fields(TS_DEFAULT_FIELD, id)
+
 /* Private variables ---------------------------------------------------------*/
 TS_Config_t tsConfig;
 TS_State_t tsState = TS_STATE_IDLE;
 UART_HandleTypeDef huart2;  /* UART for TunerStudio communication */
+DMA_HandleTypeDef hdma_usart2_rx;
+
+/* Written by DMA in circular mode, the head follows idle-line and half/full
+   transfer events, the parser in the main loop advances the tail */
+uint8_t tsRxRing[TS_RX_RING_SIZE];
+volatile uint16_t tsRxHead = 0;
+uint16_t tsRxTail = 0;
+volatile uint8_t tsRxRestart = 0;
+uint8_t tsRxWaiting = 0;
+uint32_t tsRxWaitTick = 0;
 
-uint8_t tsRxBuffer[TS_BUFFER_SIZE];
+uint8_t tsRxBuffer[TS_MAX_PAYLOAD];  /* Payload of the frame being handled */
 uint8_t tsTxBuffer[TS_BUFFER_SIZE];
-uint8_t tsRxIndex = 0;
-uint8_t tsCommand = 0;
 
-uint8_t tsPages[TS_MAX_PAGES][256];  /* Configuration pages */
-uint8_t tsChannels[TS_MAX_CHANNELS][4];  /* Runtime channels */
+/* Serial responses are queued as descriptors and sent by DMA straight from
+   the pages, tsTxBuffer or constant strings. No request is handled while a
+   response is being sent, so the memory it points at stays unchanged. */
+DMA_HandleTypeDef hdma_usart2_tx;
+TS_Tx_Descriptor_t tsTxQueue[TS_TX_QUEUE_SIZE];
+uint8_t tsTxCount = 0;            /* Descriptors of the current response */
+volatile uint8_t tsTxNext = 0;    /* Next descriptor for the DMA */
+volatile uint8_t tsTxBusy = 0;
+uint32_t tsTxTick = 0;
+uint32_t tsTxTimeout = 0;
+uint8_t tsTxHeader[3];            /* Size and status of the frame being sent */
+uint8_t tsTxTrailer[4];           /* Its CRC */
+
+/* CAN transport, a request and then its response fill the link buffer */
+IsoTp_Link_t tsCanLink;
+uint8_t tsCanBuffer[TS_MAX_PAYLOAD + TS_FRAME_OVERHEAD];
+uint16_t tsCanTxLength = 0;
+uint8_t tsCanResponse = 0;  /* Responses are collected for the CAN link while set */
+
+/* Last request over either transport, for TS_IsIdle */
+uint32_t tsRequestTick = 0;
+
+/* Request and response bytes per transport, for the rate channels */
+uint32_t tsSerialBytes = 0;
+uint32_t tsCanBytes = 0;
+
+TS_Page_t tsPages[TS_PAGE_COUNT];  /* Configuration pages, layouts from ts_protocol.h */
+
+static const uint16_t tsPageSizes[TS_PAGE_COUNT] = {
+  TS_PAGES(TS_PAGE_SIZE)
+};
+
+/* Page field plan, one entry per field in page order */
+static const TS_Page_Field_t tsFieldPlan[] = {
+  TS_PAGES(TS_PLAN_PAGE)
+};
+
+#define TS_FIELD_COUNT            (sizeof(tsFieldPlan) / sizeof(tsFieldPlan[0]))
+
+/* Live configuration as last captured or applied. A page field that differs
+   from it was written by TunerStudio, the others follow the live values. */
+TS_Page_t tsPageLive[TS_PAGE_COUNT];
+
+/* Output channel copy plan, one entry per channel in block order */
+static const TS_Channel_Copy_t tsChannelPlan[] = {
+  TS_OUTPUT_CHANNELS(TS_COPY_CHANNEL)
+};
+
+#define TS_CHANNEL_COUNT          (sizeof(tsChannelPlan) / sizeof(tsChannelPlan[0]))
+
+/* Written by 'C' and not yet burned, one bit per chunk */
+uint32_t tsPageDirty[TS_PAGE_COUNT];
+
+/* Burned and applied, still to be written to flash by TS_Process */
+uint32_t tsBurnPending[TS_PAGE_COUNT];
+uint8_t tsBurnHold = 0;
+uint32_t tsBurnHoldTick = 0;
+
+/* Pages are burned one chunk record at a time, the block is assembled in tsTxBuffer */
+_Static_assert(sizeof(TS_Page_t) <= TS_BURN_MAX_CHUNKS * TS_BURN_CHUNK_SIZE, "TunerStudio page has more chunks than a dirty bitmap");
+_Static_assert(TS_PAGE_COUNT <= 7, "TunerStudio chunk keys run past 0x03FF");
+_Static_assert(sizeof(TS_Channel_Block_t) <= TS_BUFFER_SIZE, "Output channel block larger than the TX buffer");
+
+TS_Channel_Values_t tsChannelValues;
+TS_Rate_Window_t tsRateWindow;
 
 /* Private function prototypes -----------------------------------------------*/
 static void TS_InitUART(void);
+static void TS_StartReceive(void);
+static void TS_SkipReceived(uint16_t length);
+static uint8_t TS_ParseRequest(void);
+static void TS_HandlePlain(uint8_t command);
+static void TS_HandleFrame(const uint8_t* payload, uint16_t size);
+static void TS_CANRxCallback(uint32_t canId, uint8_t* data, uint8_t length);
+static void TS_ProcessCAN(void);
+static void TS_HandleCANRequest(uint16_t length);
 static void TS_ProcessCommand(void);
-static void TS_SendResponse(uint8_t* data, uint16_t length);
-static void TS_HandleGetSignature(void);
-static void TS_HandleGetVersion(void);
-static void TS_HandleGetPage(uint8_t page);
-static void TS_HandleSetPage(uint8_t page, uint8_t* data);
-static void TS_HandleBurnPage(uint8_t page);
-static void TS_HandleGetChannels(void);
-static void TS_UpdateChannels(void);
+static void TS_SendResponse(const uint8_t* data, uint16_t length);
+static void TS_StartTransmit(void);
+static void TS_TransmitNext(void);
+static void TS_SendFrame(uint8_t status, const uint8_t* data, uint16_t length);
+static uint8_t TS_GetPageRange(const uint8_t* payload, uint16_t size, uint8_t** data, uint16_t* count);
+static void TS_HandleReadPage(const uint8_t* payload, uint16_t size);
+static void TS_HandleWriteChunk(const uint8_t* payload, uint16_t size);
+static void TS_HandleBurnPage(const uint8_t* payload, uint16_t size);
+static void TS_HandlePageCRC(const uint8_t* payload, uint16_t size);
+static void TS_HandleOutputChannels(const uint8_t* payload, uint16_t size);
+static void TS_HandleLoggerControl(const uint8_t* payload, uint16_t size);
+static void TS_HandleLoggerRead(void);
+static void TS_SampleChannels(void);
+static void TS_SampleRates(const Output_Manager_Stats_t* outputStats, uint32_t mappingEvents);
+static uint16_t TS_GetRate(uint32_t count, uint32_t windowCount, uint32_t elapsed);
+static void TS_MarkDirty(uint8_t page, uint16_t offset, const uint8_t* data, uint16_t count);
+static void TS_RefreshPage(uint8_t page);
+static void TS_ApplyPage(uint8_t page);
+static void TS_ProcessBurn(void);
+static uint8_t TS_CheckPage(uint8_t page);
+static void TS_CaptureSettings(void);
+static void TS_ApplySettings(void);
+static uint32_t TS_GetValue(const uint8_t* data, uint8_t size);
+static void TS_PutValue(uint8_t* data, uint8_t size, uint32_t value);
+
+/* Page bindings, after the prototypes of the functions they name */
+static const TS_Page_Binding_t tsPageBindings[TS_PAGE_COUNT] = {
+  [TS_PAGE_settings] = {TS_CaptureSettings, TS_ApplySettings}
+};
 
 /* External variables --------------------------------------------------------*/
 
@@ -53,15 +254,19 @@ static void TS_UpdateChannels(void);
   */
 void TS_Init(void)
 {
-  /* Load configuration from flash */
+  /* Initialize channel values, pages get their defaults when loading */
+  memset(&tsChannelValues, 0, sizeof(tsChannelValues));
+  memset(&tsRateWindow, 0, sizeof(tsRateWindow));
+  
+  /* Load configuration and burned pages from flash */
   TS_LoadConfig();
   
   /* Initialize UART */
   TS_InitUART();
   
-  /* Initialize pages and channels */
-  memset(tsPages, 0, sizeof(tsPages));
-  memset(tsChannels, 0, sizeof(tsChannels));
+  /* Requests also come over CAN, reassembled by the ISO-TP link */
+  IsoTp_Init(&tsCanLink, TS_CAN_REQUEST_ID, TS_CAN_RESPONSE_ID, tsCanBuffer, sizeof(tsCanBuffer));
+  Output_Manager_RegisterCANRxCallback(TS_CANRxCallback);
   
   /* Set initial state */
   tsState = TS_STATE_IDLE;
@@ -79,6 +284,9 @@ void TS_Init(void)
   */
 void TS_Process(void)
 {
+  /* Burned chunks go to flash whatever the link is doing */
+  TS_ProcessBurn();
+  
   /* Process based on state */
   switch (tsState) {
     case TS_STATE_IDLE:
@@ -86,96 +294,26 @@ void TS_Process(void)
       break;
     
     case TS_STATE_CONNECTED:
-      /* Check for incoming data */
-      if (__HAL_UART_GET_FLAG(&huart2, UART_FLAG_RXNE)) {
-        uint8_t data;
-        if (HAL_UART_Receive(&huart2, &data, 1, 10) == HAL_OK) {
-          /* Store received byte */
-          tsRxBuffer[tsRxIndex++] = data;
-          
-          /* Check if we have a complete command */
-          if (tsRxIndex == 1) {
-            /* First byte is the command */
-            tsCommand = data;
-          } else if (tsRxIndex > 1) {
-            /* Process command based on protocol */
-            if (tsConfig.protocol == TS_PROTOCOL_MS) {
-              /* MegaSquirt protocol */
-              switch (tsCommand) {
-                case TS_CMD_ECHO:
-                  /* Echo command - just send back the byte */
-                  TS_SendResponse(&tsRxBuffer[1], 1);
-                  tsRxIndex = 0;
-                  break;
-                
-                case TS_CMD_GET_SIGNATURE:
-                  /* Get signature command - no additional data needed */
-                  if (tsRxIndex >= 2) {
-                    TS_HandleGetSignature();
-                    tsRxIndex = 0;
-                  }
-                  break;
-                
-                case TS_CMD_GET_VERSION:
-                  /* Get version command - no additional data needed */
-                  if (tsRxIndex >= 2) {
-                    TS_HandleGetVersion();
-                    tsRxIndex = 0;
-                  }
-                  break;
-                
-                case TS_CMD_GET_PAGE:
-                  /* Get page command - need page number */
-                  if (tsRxIndex >= 3) {
-                    TS_HandleGetPage(tsRxBuffer[1]);
-                    tsRxIndex = 0;
-                  }
-                  break;
-                
-                case TS_CMD_SET_PAGE:
-                  /* Set page command - need page number and data */
-                  if (tsRxIndex >= 3 + tsConfig.pageSize) {
-                    TS_HandleSetPage(tsRxBuffer[1], &tsRxBuffer[2]);
-                    tsRxIndex = 0;
-                  }
-                  break;
-                
-                case TS_CMD_BURN_PAGE:
-                  /* Burn page command - need page number */
-                  if (tsRxIndex >= 3) {
-                    TS_HandleBurnPage(tsRxBuffer[1]);
-                    tsRxIndex = 0;
-                  }
-                  break;
-                
-                case TS_CMD_GET_CHANNELS:
-                  /* Get channels command - no additional data needed */
-                  if (tsRxIndex >= 2) {
-                    TS_HandleGetChannels();
-                    tsRxIndex = 0;
-                  }
-                  break;
-                
-                default:
-                  /* Unknown command - reset buffer */
-                  tsRxIndex = 0;
-                  break;
-              }
-            } else {
-              /* Custom protocol - implement as needed */
-              tsRxIndex = 0;
-            }
-          }
-          
-          /* Check for buffer overflow */
-          if (tsRxIndex >= TS_BUFFER_SIZE) {
-            tsRxIndex = 0;
-          }
-        }
+      /* Reception stopped on a line error, whatever was pending is lost */
+      if (tsRxRestart) {
+        TS_StartReceive();
       }
-      
-      /* Update channels periodically */
-      TS_UpdateChannels();
+    
+      /* The line stopped taking the response, drop the rest of it */
+      if (tsTxBusy && HAL_GetTick() - tsTxTick > tsTxTimeout) {
+        HAL_UART_AbortTransmit(&huart2);
+        tsTxCount = 0;
+        tsTxBusy = 0;
+      }
+    
+      /* Handle complete frames until one has a response on its way */
+      while (!tsTxBusy && TS_ParseRequest()) {
+        tsRequestTick = HAL_GetTick();
+        TS_StartTransmit();
+      }
+    
+      IsoTp_Process(&tsCanLink);
+      TS_ProcessCAN();
       break;
     
     case TS_STATE_PROCESSING:
@@ -203,6 +341,21 @@ TS_State_t TS_GetState(void)
   return tsState;
 }
 
+/**
+  * @brief  Check whether both TunerStudio links are idle
+  * @note   TunerStudio follows a burn with a CRC request and polls channels
+  *         while connected, so a link only counts as idle once it has been
+  *         quiet for a while.
+  * @param  quietMs: Time without requests that counts as idle
+  * @retval uint8_t: 1 if no request is pending, no response is being sent
+  *         and no request arrived for quietMs, 0 otherwise
+  */
+uint8_t TS_IsIdle(uint32_t quietMs)
+{
+  return !tsTxBusy && tsRxHead == tsRxTail && IsoTp_IsIdle(&tsCanLink) &&
+         HAL_GetTick() - tsRequestTick >= quietMs;
+}
+
 /**
   * @brief  Configure TunerStudio
   * @param  config: Pointer to configuration structure
@@ -261,6 +414,7 @@ uint8_t TS_Start(void)
   
   /* Initialize UART */
   TS_InitUART();
+  TS_StartReceive();
   
   /* Set state to connected */
   tsState = TS_STATE_CONNECTED;
@@ -278,6 +432,8 @@ uint8_t TS_Stop(void)
   /* Disable TunerStudio */
   tsConfig.enabled = 0;
   
+  HAL_UART_AbortReceive(&huart2);
+  
   /* Set state to idle */
   tsState = TS_STATE_IDLE;
   
@@ -286,35 +442,86 @@ uint8_t TS_Stop(void)
 
 /**
   * @brief  Save TunerStudio configuration to flash
+  * @note   Burns every page that passes its range check. The pages take
+  *         effect now, their changed chunks are written by TS_Process.
   * @param  None
   * @retval uint8_t: 1 if successful, 0 if failed
   */
 uint8_t TS_SaveConfig(void)
 {
-  /* In a real implementation, this would save the configuration to flash memory
-     using the STM32 HAL flash functions. For this example, we'll just return success. */
+  uint8_t result = 1;
   
-  return 1;
+  for (uint8_t page = 0; page < TS_PAGE_COUNT; page++) {
+    TS_RefreshPage(page);
+    
+    if (!TS_CheckPage(page)) {
+      result = 0;
+      continue;
+    }
+    
+    TS_ApplyPage(page);
+  }
+  
+  return Config_Store_Write(CONFIG_KEY_TS, &tsConfig, sizeof(tsConfig)) && result;
 }
 
 /**
   * @brief  Load TunerStudio configuration from flash
+  * @note   Pages start from the live configuration, burned chunks are laid
+  *         over it and applied. Call after the modules the pages are bound
+  *         to have loaded their own configuration.
   * @param  None
   * @retval uint8_t: 1 if successful, 0 if failed
   */
 uint8_t TS_LoadConfig(void)
 {
-  /* In a real implementation, this would load the configuration from flash memory
-     using the STM32 HAL flash functions. For this example, we'll set default values. */
-  
-  /* Set default configuration */
+  /* Start from defaults so a missing or stale record leaves them in place */
   TS_ResetConfig();
   
+  Config_Store_Read(CONFIG_KEY_TS, &tsConfig, sizeof(tsConfig));
+  
+  for (uint8_t page = 0; page < TS_PAGE_COUNT; page++) {
+    uint8_t* data = (uint8_t*)&tsPages[page];
+    uint16_t layout = 0;
+    uint8_t loaded = 0;
+    
+    tsPageBindings[page].capture();
+    tsPageLive[page] = tsPages[page];
+    
+    /* Chunks burned for another layout would land on the wrong fields */
+    if (!Config_Store_Read(CONFIG_KEY_TS_PAGE(page), &layout, sizeof(layout)) || layout != tsPageSizes[page]) {
+      continue;
+    }
+    
+    for (uint8_t chunk = 0; chunk < TS_CHUNK_COUNT(tsPageSizes[page]); chunk++) {
+      uint16_t offset = chunk * TS_BURN_CHUNK_SIZE;
+      uint16_t length = tsPageSizes[page] - offset < TS_BURN_CHUNK_SIZE ? tsPageSizes[page] - offset : TS_BURN_CHUNK_SIZE;
+      
+      if (Config_Store_Read(CONFIG_KEY_TS_CHUNK(page, chunk), &data[offset], length)) {
+        loaded = 1;
+      }
+    }
+    
+    if (loaded && !TS_CheckPage(page)) {
+      tsPageBindings[page].capture();
+      continue;
+    }
+    
+    if (loaded) {
+      tsPageBindings[page].apply();
+      tsPageLive[page] = tsPages[page];
+    }
+    
+    tsPageDirty[page] = 0;
+  }
+  
   return 1;
 }
 
 /**
   * @brief  Reset TunerStudio configuration to defaults
+  * @note   Page fields take the defaults listed in ts_protocol.h. Every chunk
+  *         is marked dirty, so the next burn writes the whole page.
   * @param  None
   * @retval None
   */
@@ -324,84 +531,119 @@ void TS_ResetConfig(void)
   tsConfig.enabled = 1;
   tsConfig.baudRate = 115200;
   tsConfig.protocol = TS_PROTOCOL_MS;
-  strcpy(tsConfig.signature, "STM32HID");
-  tsConfig.pageSize = 128;
-  tsConfig.pageCount = 1;
+  
+  memset(tsPages, 0, sizeof(tsPages));
+  TS_PAGES(TS_DEFAULT_PAGE)
+  
+  for (uint8_t page = 0; page < TS_PAGE_COUNT; page++) {
+    tsPageDirty[page] = TS_CHUNK_MASK(tsPageSizes[page]);
+    tsBurnPending[page] = 0;
+  }
+  
+  tsBurnHold = 0;
 }
 
 /**
-  * @brief  Generate TunerStudio INI file
-  * @param  buffer: Buffer to store INI file
-  * @param  bufferSize: Size of buffer
-  * @retval uint8_t: 1 if successful, 0 if failed
+  * @brief  Read a range of the output channel block
+  * @note   Samples the live sources, like an 'O' request.
+  * @param  offset: First byte of the block
+  * @param  data: Receives the bytes, little endian like the block
+  * @param  count: Number of bytes
+  * @retval uint8_t: 1 if successful, 0 if the range is outside the block
   */
-uint8_t TS_GenerateINI(char* buffer, uint16_t bufferSize)
+uint8_t TS_ReadChannels(uint16_t offset, uint8_t* data, uint16_t count)
 {
-  if (buffer == NULL || bufferSize < 512) {
+  uint16_t end = offset + count;
+  
+  if ((uint32_t)offset + count > sizeof(TS_Channel_Block_t)) {
+    return 0;
+  }
+  
+  /* The block only exists for the duration of a request */
+  TS_SampleChannels();
+  
+  /* Copy the part of each channel that falls inside the requested range */
+  for (uint8_t i = 0; i < TS_CHANNEL_COUNT; i++) {
+    const TS_Channel_Copy_t* copy = &tsChannelPlan[i];
+    uint16_t first = copy->offset > offset ? copy->offset : offset;
+    uint16_t last = copy->offset + copy->size < end ? copy->offset + copy->size : end;
+    
+    if (first < last) {
+      memcpy(&data[first - offset], (const uint8_t*)&tsChannelValues + copy->source + (first - copy->offset), last - first);
+    }
+  }
+  
+  return 1;
+}
+
+/**
+  * @brief  Read a range of a configuration page
+  * @param  page: Page index
+  * @param  offset: First page byte
+  * @param  data: Receives the bytes, little endian like the page
+  * @param  count: Number of bytes
+  * @retval uint8_t: 1 if successful, 0 if the range is outside the page
+  */
+uint8_t TS_ReadPage(uint8_t page, uint16_t offset, uint8_t* data, uint16_t count)
+{
+  if (page >= TS_PAGE_COUNT || (uint32_t)offset + count > tsPageSizes[page]) {
     return 0;
   }
   
-  /* Generate INI file */
-  int offset = 0;
-  
-  /* Header */
-  offset += snprintf(buffer + offset, bufferSize - offset,
-    "; TunerStudio INI File for STM32F407 HID to Serial/CAN\n"
-    "; Generated on 2025-03-28\n\n");
-  
-  /* MegaTune section */
-  offset += snprintf(buffer + offset, bufferSize - offset,
-    "[MegaTune]\n"
-    "signature = \"%s\"\n"
-    "version = \"1.0.0\"\n\n",
-    tsConfig.signature);
-  
-  /* Constants section */
-  offset += snprintf(buffer + offset, bufferSize - offset,
-    "[Constants]\n"
-    "pageSize = %d\n"
-    "pageCount = %d\n\n",
-    tsConfig.pageSize, tsConfig.pageCount);
-  
-  /* OutputChannels section */
-  offset += snprintf(buffer + offset, bufferSize - offset,
-    "[OutputChannels]\n"
-    "; Define output channels here\n"
-    "ochBlockSize = %d\n"
-    "hid_device_count = \"HID Device Count\", 0, 0, \"\", 1, 0\n"
-    "active_mappings = \"Active Mappings\", 0, 1, \"\", 1, 0\n"
-    "serial_status = \"Serial Status\", 0, 2, \"\", 1, 0\n"
-    "can_status = \"CAN Status\", 0, 3, \"\", 1, 0\n\n",
-    TS_MAX_CHANNELS * 4);
-  
-  /* Page section */
-  offset += snprintf(buffer + offset, bufferSize - offset,
-    "[Page]\n"
-    "page = 1\n"
-    "title = \"Configuration\"\n"
-    "size = %d\n\n",
-    tsConfig.pageSize);
-  
-  /* Settings section */
-  offset += snprintf(buffer + offset, bufferSize - offset,
-    "[SettingGroups]\n"
-    "mainSettings = \"Main Settings\"\n\n"
-    "[Settings]\n"
-    "serialBaudRate = \"Serial Baud Rate\", mainSettings, \"%d\", \"bps\", 0, 0, 0, 1, 0\n"
-    "canBaudRate = \"CAN Baud Rate\", mainSettings, \"%d\", \"bps\", 0, 1, 0, 1, 0\n\n",
-    115200, 500000);
-  
-  /* Menu section */
-  offset += snprintf(buffer + offset, bufferSize - offset,
-    "[Menu]\n"
-    "topMenu = \"STM32F407 HID to Serial/CAN\"\n"
-    "menuDialog = mainSettings, \"Main Settings\"\n\n"
-    "[UserDefined]\n"
-    "userMenuItem1 = \"STM32F407 HID to Serial/CAN\", \"STM32F407 HID to Serial/CAN\"\n");
+  TS_RefreshPage(page);
+  memcpy(data, (const uint8_t*)&tsPages[page] + offset, count);
   
   return 1;
 }
 
+/**
+  * @brief  Write a range of a configuration page and burn it
+  * @note   Does what a 'C' write followed by a 'B' burn does, for other
+  *         transports such as the diagnostic server. Changes TunerStudio has
+  *         written but not burned yet are burned with it. A write that would
+  *         leave a field outside its limits is undone.
+  * @param  page: Page index
+  * @param  offset: First page byte
+  * @param  data: New bytes, little endian like the page
+  * @param  count: Number of bytes, up to 32
+  * @retval uint8_t: TS_RESPONSE_BURN_OK if applied, TS_RESPONSE_OUT_OF_RANGE if
+  *         the range or a value is out of range, TS_RESPONSE_BURN_FAILED if a
+  *         TunerStudio response is being sent from the page, try again later
+  */
+uint8_t TS_WritePage(uint8_t page, uint16_t offset, const uint8_t* data, uint16_t count)
+{
+  uint8_t previous[TS_BURN_CHUNK_SIZE];
+  uint8_t* target;
+  uint32_t dirty;
+  
+  if (page >= TS_PAGE_COUNT || (uint32_t)offset + count > tsPageSizes[page] || count > sizeof(previous)) {
+    return TS_RESPONSE_OUT_OF_RANGE;
+  }
+  
+  /* A serial response may be sent from the page in place */
+  if (tsTxBusy) {
+    return TS_RESPONSE_BURN_FAILED;
+  }
+  
+  TS_RefreshPage(page);
+  
+  target = (uint8_t*)&tsPages[page] + offset;
+  dirty = tsPageDirty[page];
+  memcpy(previous, target, count);
+  TS_MarkDirty(page, offset, data, count);
+  memcpy(target, data, count);
+  
+  if (!TS_CheckPage(page)) {
+    memcpy(target, previous, count);
+    tsPageDirty[page] = dirty;
+    return TS_RESPONSE_OUT_OF_RANGE;
+  }
+  
+  TS_ApplyPage(page);
+  
+  return TS_RESPONSE_BURN_OK;
+}
+
 /**
   * @brief  Initialize UART for TunerStudio communication
   * @param  None
@@ -409,6 +651,13 @@ uint8_t TS_GenerateINI(char* buffer, uint16_t bufferSize)
   */
 static void TS_InitUART(void)
 {
+  /* A running reception or response must not survive the re-initialization */
+  if (huart2.Instance != NULL) {
+    HAL_UART_Abort(&huart2);
+    tsTxCount = 0;
+    tsTxBusy = 0;
+  }
+  
   /* Configure UART peripheral */
   huart2.Instance = USART2;
   huart2.Init.BaudRate = tsConfig.baudRate;
@@ -423,6 +672,396 @@ static void TS_InitUART(void)
   if (HAL_UART_Init(&huart2) != HAL_OK) {
     Error_Handler();
   }
+  
+  /* Received bytes are written into the ring by DMA, byte by byte */
+  __HAL_RCC_DMA1_CLK_ENABLE();
+  
+  hdma_usart2_rx.Instance = TS_RX_DMA_STREAM;
+  hdma_usart2_rx.Init.Channel = TS_RX_DMA_CHANNEL;
+  hdma_usart2_rx.Init.Direction = DMA_PERIPH_TO_MEMORY;
+  hdma_usart2_rx.Init.PeriphInc = DMA_PINC_DISABLE;
+  hdma_usart2_rx.Init.MemInc = DMA_MINC_ENABLE;
+  hdma_usart2_rx.Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+  hdma_usart2_rx.Init.MemDataAlignment = DMA_MDATAALIGN_BYTE;
+  hdma_usart2_rx.Init.Mode = DMA_CIRCULAR;
+  hdma_usart2_rx.Init.Priority = DMA_PRIORITY_LOW;
+  hdma_usart2_rx.Init.FIFOMode = DMA_FIFOMODE_DISABLE;
+  
+  if (HAL_DMA_Init(&hdma_usart2_rx) != HAL_OK) {
+    Error_Handler();
+  }
+  
+  __HAL_LINKDMA(&huart2, hdmarx, hdma_usart2_rx);
+  
+  /* Responses are sent by DMA, one descriptor per transfer */
+  hdma_usart2_tx.Instance = TS_TX_DMA_STREAM;
+  hdma_usart2_tx.Init.Channel = TS_TX_DMA_CHANNEL;
+  hdma_usart2_tx.Init.Direction = DMA_MEMORY_TO_PERIPH;
+  hdma_usart2_tx.Init.PeriphInc = DMA_PINC_DISABLE;
+  hdma_usart2_tx.Init.MemInc = DMA_MINC_ENABLE;
+  hdma_usart2_tx.Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+  hdma_usart2_tx.Init.MemDataAlignment = DMA_MDATAALIGN_BYTE;
+  hdma_usart2_tx.Init.Mode = DMA_NORMAL;
+  hdma_usart2_tx.Init.Priority = DMA_PRIORITY_LOW;
+  hdma_usart2_tx.Init.FIFOMode = DMA_FIFOMODE_DISABLE;
+  
+  if (HAL_DMA_Init(&hdma_usart2_tx) != HAL_OK) {
+    Error_Handler();
+  }
+  
+  __HAL_LINKDMA(&huart2, hdmatx, hdma_usart2_tx);
+  
+  HAL_NVIC_SetPriority(TS_RX_DMA_IRQn, TS_RX_IRQ_PRIORITY, 0);
+  HAL_NVIC_EnableIRQ(TS_RX_DMA_IRQn);
+  HAL_NVIC_SetPriority(TS_TX_DMA_IRQn, TS_RX_IRQ_PRIORITY, 0);
+  HAL_NVIC_EnableIRQ(TS_TX_DMA_IRQn);
+  HAL_NVIC_SetPriority(USART2_IRQn, TS_RX_IRQ_PRIORITY, 0);
+  HAL_NVIC_EnableIRQ(USART2_IRQn);
+}
+
+/**
+  * @brief  Start circular DMA reception into an empty ring
+  * @param  None
+  * @retval None
+  */
+static void TS_StartReceive(void)
+{
+  tsRxRestart = 0;
+  tsRxHead = 0;
+  tsRxTail = 0;
+  tsRxWaiting = 0;
+  
+  /* Events come at idle line and at half and full ring, so a request is
+     seen one character time after its last byte */
+  if (HAL_UARTEx_ReceiveToIdle_DMA(&huart2, tsRxRing, TS_RX_RING_SIZE) != HAL_OK) {
+    tsRxRestart = 1;
+  }
+}
+
+/**
+  * @brief  Drop bytes from the tail of the receive ring
+  * @param  length: Number of bytes
+  * @retval None
+  */
+static void TS_SkipReceived(uint16_t length)
+{
+  tsRxTail = (tsRxTail + length) & TS_RX_RING_MASK;
+  tsSerialBytes += length;
+}
+
+/**
+  * @brief  Handle the request at the tail of the receive ring if it is complete
+  * @note   Requests are frames of a big-endian 16-bit payload size, the
+  *         payload and the big-endian CRC-32 of the payload. The protocol
+  *         probe commands also come unframed; a frame cannot start with one
+  *         of them since its first byte is the high byte of the size.
+  * @param  None
+  * @retval uint8_t: 1 if bytes were consumed, 0 if the ring holds no complete request
+  */
+static uint8_t TS_ParseRequest(void)
+{
+  uint16_t available = (tsRxHead - tsRxTail) & TS_RX_RING_MASK;
+  
+  if (available == 0) {
+    tsRxWaiting = 0;
+    return 0;
+  }
+  
+  /* Custom protocol - implement as needed */
+  if (tsConfig.protocol != TS_PROTOCOL_MS) {
+    TS_SkipReceived(available);
+    return 0;
+  }
+  
+  uint8_t first = TS_RX_PEEK(0);
+  
+  if (first == TS_CMD_PROTOCOL || first == TS_CMD_QUERY || first == TS_CMD_HELLO) {
+    TS_SkipReceived(1);
+    TS_HandlePlain(first);
+    return 1;
+  }
+  
+  uint16_t size = 0;
+  
+  if (available >= 2) {
+    size = (TS_RX_PEEK(0) << 8) | TS_RX_PEEK(1);
+    
+    /* Out of step with the sender, drop everything and let it retry */
+    if (size == 0 || size > TS_MAX_PAYLOAD) {
+      TS_SkipReceived(available);
+      TS_SendFrame(size == 0 ? TS_RESPONSE_UNDERRUN : TS_RESPONSE_OVERRUN, NULL, 0);
+      return 1;
+    }
+  }
+  
+  if (available < 2 || available < size + TS_FRAME_OVERHEAD) {
+    if (!tsRxWaiting) {
+      tsRxWaiting = 1;
+      tsRxWaitTick = HAL_GetTick();
+    } else if (HAL_GetTick() - tsRxWaitTick > TS_FRAME_TIMEOUT_MS) {
+      tsRxWaiting = 0;
+      TS_SkipReceived(available);
+    }
+    
+    return 0;
+  }
+  
+  tsRxWaiting = 0;
+  
+  /* Linearize, the frame may wrap around the end of the ring */
+  for (uint16_t i = 0; i < size; i++) {
+    tsRxBuffer[i] = TS_RX_PEEK(2 + i);
+  }
+  
+  uint32_t crc = ((uint32_t)TS_RX_PEEK(2 + size) << 24) | ((uint32_t)TS_RX_PEEK(3 + size) << 16) |
+                 ((uint32_t)TS_RX_PEEK(4 + size) << 8) | TS_RX_PEEK(5 + size);
+  
+  TS_SkipReceived(size + TS_FRAME_OVERHEAD);
+  
+  if (CRC32_Calculate(tsRxBuffer, size) != crc) {
+    TS_SendFrame(TS_RESPONSE_CRC_FAILURE, NULL, 0);
+    return 1;
+  }
+  
+  TS_HandleFrame(tsRxBuffer, size);
+  
+  return 1;
+}
+
+/**
+  * @brief  Answer an unframed protocol probe
+  * @param  command: Command byte
+  * @retval None
+  */
+static void TS_HandlePlain(uint8_t command)
+{
+  switch (command) {
+    case TS_CMD_PROTOCOL:
+      TS_SendResponse((const uint8_t*)TS_PROTOCOL_VERSION, strlen(TS_PROTOCOL_VERSION));
+      break;
+    
+    case TS_CMD_QUERY:
+      TS_SendResponse((const uint8_t*)TS_SIGNATURE, strlen(TS_SIGNATURE));
+      break;
+    
+    default:
+      TS_SendResponse((const uint8_t*)TS_VERSION_STRING, strlen(TS_VERSION_STRING));
+      break;
+  }
+}
+
+/**
+  * @brief  Handle a framed request with a valid CRC
+  * @param  payload: Request payload, the command byte first
+  * @param  size: Payload size
+  * @retval None
+  */
+static void TS_HandleFrame(const uint8_t* payload, uint16_t size)
+{
+  switch (payload[0]) {
+    case TS_CMD_QUERY:
+      TS_SendFrame(TS_RESPONSE_OK, (const uint8_t*)TS_SIGNATURE, strlen(TS_SIGNATURE));
+      break;
+    
+    case TS_CMD_HELLO:
+      TS_SendFrame(TS_RESPONSE_OK, (const uint8_t*)TS_VERSION_STRING, strlen(TS_VERSION_STRING));
+      break;
+    
+    case TS_CMD_PROTOCOL:
+      TS_SendFrame(TS_RESPONSE_OK, (const uint8_t*)TS_PROTOCOL_VERSION, strlen(TS_PROTOCOL_VERSION));
+      break;
+    
+    case TS_CMD_OUTPUT_CHANNELS:
+      TS_HandleOutputChannels(payload, size);
+      break;
+    
+    case TS_CMD_READ_PAGE:
+      TS_HandleReadPage(payload, size);
+      break;
+    
+    case TS_CMD_WRITE_CHUNK:
+      TS_HandleWriteChunk(payload, size);
+      break;
+    
+    case TS_CMD_BURN_PAGE:
+      TS_HandleBurnPage(payload, size);
+      break;
+    
+    case TS_CMD_PAGE_CRC:
+      TS_HandlePageCRC(payload, size);
+      break;
+    
+    case TS_CMD_LOGGER_CONTROL:
+      TS_HandleLoggerControl(payload, size);
+      break;
+    
+    case TS_CMD_LOGGER_READ:
+      TS_HandleLoggerRead();
+      break;
+    
+    default:
+      TS_SendFrame(TS_RESPONSE_UNRECOGNIZED, NULL, 0);
+      break;
+  }
+}
+
+/**
+  * @brief  CAN receive callback, passes request frames to the ISO-TP link
+  * @param  canId: CAN identifier
+  * @param  data: Frame data
+  * @param  length: Data length
+  * @retval None
+  */
+static void TS_CANRxCallback(uint32_t canId, uint8_t* data, uint8_t length)
+{
+  if (canId == TS_CAN_REQUEST_ID && tsState == TS_STATE_CONNECTED) {
+    IsoTp_Receive(&tsCanLink, data, length);
+  }
+}
+
+/**
+  * @brief  Handle a request that arrived over CAN and send the response back
+  * @note   Handlers answer through TS_SendResponse, which collects the bytes
+  *         in the link buffer while tsCanResponse is set.
+  * @param  None
+  * @retval None
+  */
+static void TS_ProcessCAN(void)
+{
+  /* Handlers write to the pages and tsTxBuffer a serial response may be
+     sent from, the request waits in the link until it has gone */
+  if (tsTxBusy) {
+    return;
+  }
+  
+  uint16_t length = IsoTp_Take(&tsCanLink);
+  
+  if (length == 0) {
+    return;
+  }
+  
+  tsCanBytes += length;
+  tsRequestTick = HAL_GetTick();
+  
+  tsCanResponse = 1;
+  tsCanTxLength = 0;
+  TS_HandleCANRequest(length);
+  tsCanResponse = 0;
+  
+  if (tsCanTxLength > 0 && IsoTp_Send(&tsCanLink, tsCanTxLength)) {
+    tsCanBytes += tsCanTxLength;
+  }
+}
+
+/**
+  * @brief  Check and handle a request message from the CAN link
+  * @note   A message holds one request, a protocol probe byte or a whole
+  *         frame, so there is nothing to resynchronize.
+  * @param  length: Message length
+  * @retval None
+  */
+static void TS_HandleCANRequest(uint16_t length)
+{
+  uint8_t first = tsCanBuffer[0];
+  
+  if (length == 1 && (first == TS_CMD_PROTOCOL || first == TS_CMD_QUERY || first == TS_CMD_HELLO)) {
+    TS_HandlePlain(first);
+    return;
+  }
+  
+  uint16_t size = length >= 2 ? (tsCanBuffer[0] << 8) | tsCanBuffer[1] : 0;
+  
+  if (size > TS_MAX_PAYLOAD) {
+    TS_SendFrame(TS_RESPONSE_OVERRUN, NULL, 0);
+    return;
+  }
+  
+  if (size == 0 || length != size + TS_FRAME_OVERHEAD) {
+    TS_SendFrame(TS_RESPONSE_UNDERRUN, NULL, 0);
+    return;
+  }
+  
+  /* The response is built in the link buffer, move the payload out of it */
+  memcpy(tsRxBuffer, &tsCanBuffer[2], size);
+  
+  uint32_t crc = ((uint32_t)tsCanBuffer[2 + size] << 24) | ((uint32_t)tsCanBuffer[3 + size] << 16) |
+                 ((uint32_t)tsCanBuffer[4 + size] << 8) | tsCanBuffer[5 + size];
+  
+  if (CRC32_Calculate(tsRxBuffer, size) != crc) {
+    TS_SendFrame(TS_RESPONSE_CRC_FAILURE, NULL, 0);
+    return;
+  }
+  
+  TS_HandleFrame(tsRxBuffer, size);
+}
+
+/**
+  * @brief  Reception event, records how far the DMA has written into the ring
+  * @param  huart: UART handle
+  * @param  size: DMA write position in the ring
+  * @retval None
+  */
+void HAL_UARTEx_RxEventCallback(UART_HandleTypeDef* huart, uint16_t size)
+{
+  if (huart != &huart2) {
+    return;
+  }
+  
+  tsRxHead = size & TS_RX_RING_MASK;
+}
+
+/**
+  * @brief  UART error, the HAL has stopped the reception
+  * @param  huart: UART handle
+  * @retval None
+  */
+void HAL_UART_ErrorCallback(UART_HandleTypeDef* huart)
+{
+  if (huart == &huart2) {
+    tsRxRestart = 1;
+  }
+}
+
+/**
+  * @brief  USART2 interrupt handler, idle line and errors
+  * @param  None
+  * @retval None
+  */
+void USART2_IRQHandler(void)
+{
+  HAL_UART_IRQHandler(&huart2);
+}
+
+/**
+  * @brief  DMA1 Stream5 interrupt handler, USART2 receive half and full ring
+  * @param  None
+  * @retval None
+  */
+void DMA1_Stream5_IRQHandler(void)
+{
+  HAL_DMA_IRQHandler(&hdma_usart2_rx);
+}
+
+/**
+  * @brief  DMA1 Stream6 interrupt handler, USART2 transmit
+  * @param  None
+  * @retval None
+  */
+void DMA1_Stream6_IRQHandler(void)
+{
+  HAL_DMA_IRQHandler(&hdma_usart2_tx);
+}
+
+/**
+  * @brief  Transmission complete, the next piece of the response follows
+  * @param  huart: UART handle
+  * @retval None
+  */
+void HAL_UART_TxCpltCallback(UART_HandleTypeDef* huart)
+{
+  if (huart == &huart2) {
+    TS_TransmitNext();
+  }
 }
 
 /**
@@ -441,148 +1080,669 @@ static void TS_ProcessCommand(void)
 
 /**
   * @brief  Send response to TunerStudio
+  * @note   Over serial the data is not copied, it is queued and sent by
+  *         TS_StartTransmit once the handler returns. It must stay in place
+  *         until then, so it cannot be on the stack.
   * @param  data: Pointer to data buffer
   * @param  length: Length of data
   * @retval None
   */
-static void TS_SendResponse(uint8_t* data, uint16_t length)
+static void TS_SendResponse(const uint8_t* data, uint16_t length)
 {
-  /* Send response via UART */
-  HAL_UART_Transmit(&huart2, data, length, 100);
+  /* Over CAN the response goes out as one message once it is complete */
+  if (tsCanResponse) {
+    if (tsCanTxLength + length <= sizeof(tsCanBuffer)) {
+      memcpy(&tsCanBuffer[tsCanTxLength], data, length);
+      tsCanTxLength += length;
+    }
+    
+    return;
+  }
+  
+  if (tsTxCount == TS_TX_QUEUE_SIZE) {
+    return;
+  }
+  
+  tsTxQueue[tsTxCount].data = data;
+  tsTxQueue[tsTxCount].length = length;
+  tsTxCount++;
+  tsSerialBytes += length;
 }
 
 /**
-  * @brief  Handle Get Signature command
+  * @brief  Start sending the queued response
+  * @note   Returns at once, the DMA completion moves on to each following
+  *         descriptor. The timeout allows for the line time of the response.
   * @param  None
   * @retval None
   */
-static void TS_HandleGetSignature(void)
+static void TS_StartTransmit(void)
 {
-  /* Prepare response */
-  uint8_t response[32];
-  uint8_t length = 0;
+  uint32_t length = 0;
+  
+  if (tsTxCount == 0) {
+    return;
+  }
   
-  /* Copy signature */
-  strcpy((char*)response, tsConfig.signature);
-  length = strlen((char*)response);
+  for (uint8_t i = 0; i < tsTxCount; i++) {
+    length += tsTxQueue[i].length;
+  }
+  
+  tsTxTick = HAL_GetTick();
+  tsTxTimeout = TS_TX_TIMEOUT_MS + (tsConfig.baudRate > 0 ? length * 10000 / tsConfig.baudRate : 0);
+  tsTxNext = 0;
+  tsTxBusy = 1;
   
-  /* Send response */
-  TS_SendResponse(response, length);
+  TS_TransmitNext();
 }
 
 /**
-  * @brief  Handle Get Version command
+  * @brief  Hand the next descriptor to the DMA, or finish the response
+  * @note   Runs from the main loop for the first descriptor and from the
+  *         transmission complete interrupt for the others.
   * @param  None
   * @retval None
   */
-static void TS_HandleGetVersion(void)
+static void TS_TransmitNext(void)
 {
-  /* Prepare response */
-  uint8_t response[4];
+  if (tsTxNext >= tsTxCount) {
+    tsTxCount = 0;
+    tsTxBusy = 0;
+    return;
+  }
   
-  /* Set version (1.0.0) */
-  response[0] = 1;  /* Major */
-  response[1] = 0;  /* Minor */
-  response[2] = 0;  /* Patch */
+  const TS_Tx_Descriptor_t* descriptor = &tsTxQueue[tsTxNext++];
   
-  /* Send response */
-  TS_SendResponse(response, 3);
+  if (HAL_UART_Transmit_DMA(&huart2, (uint8_t*)descriptor->data, descriptor->length) != HAL_OK) {
+    tsTxCount = 0;
+    tsTxBusy = 0;
+  }
 }
 
 /**
-  * @brief  Handle Get Page command
-  * @param  page: Page number
+  * @brief  Send a response frame
+  * @param  status: Response code, the first payload byte
+  * @param  data: Response data after the code
+  * @param  length: Length of data
   * @retval None
   */
-static void TS_HandleGetPage(uint8_t page)
+static void TS_SendFrame(uint8_t status, const uint8_t* data, uint16_t length)
+{
+  uint16_t size = length + 1;
+  uint32_t crc = CRC32_Update(CRC32_INITIAL, &status, 1);
+  
+  crc = CRC32_Update(crc, data, length);
+  
+  /* Header and trailer are sent from static buffers, the data from where it is */
+  tsTxHeader[0] = (uint8_t)(size >> 8);
+  tsTxHeader[1] = (uint8_t)size;
+  tsTxHeader[2] = status;
+  
+  tsTxTrailer[0] = (uint8_t)(crc >> 24);
+  tsTxTrailer[1] = (uint8_t)(crc >> 16);
+  tsTxTrailer[2] = (uint8_t)(crc >> 8);
+  tsTxTrailer[3] = (uint8_t)crc;
+  
+  TS_SendResponse(tsTxHeader, sizeof(tsTxHeader));
+  
+  if (length > 0) {
+    TS_SendResponse(data, length);
+  }
+  
+  TS_SendResponse(tsTxTrailer, sizeof(tsTxTrailer));
+}
+
+/**
+  * @brief  Check the page, offset and count fields of a page request
+  * @param  payload: Request payload, command, then page, offset and count (16-bit LE)
+  * @param  size: Payload size
+  * @param  data: Set to the first page byte of the range
+  * @param  count: Set to the number of bytes in the range
+  * @retval uint8_t: TS_RESPONSE_OK or the error code to answer with
+  */
+static uint8_t TS_GetPageRange(const uint8_t* payload, uint16_t size, uint8_t** data, uint16_t* count)
 {
-  /* Check if page is valid */
-  if (page >= tsConfig.pageCount) {
-    /* Invalid page - send empty response */
-    TS_SendResponse(NULL, 0);
+  if (size < 7) {
+    return TS_RESPONSE_UNDERRUN;
+  }
+  
+  uint16_t page = TS_GET_U16(&payload[1]);
+  uint16_t offset = TS_GET_U16(&payload[3]);
+  
+  *count = TS_GET_U16(&payload[5]);
+  
+  if (page >= TS_PAGE_COUNT || (uint32_t)offset + *count > tsPageSizes[page]) {
+    return TS_RESPONSE_OUT_OF_RANGE;
+  }
+  
+  /* Reads and writes see the live configuration */
+  TS_RefreshPage(page);
+  *data = (uint8_t*)&tsPages[page] + offset;
+  
+  return TS_RESPONSE_OK;
+}
+
+/**
+  * @brief  Handle a page read, any range of a page
+  * @param  payload: Request payload
+  * @param  size: Payload size
+  * @retval None
+  */
+static void TS_HandleReadPage(const uint8_t* payload, uint16_t size)
+{
+  uint8_t* data;
+  uint16_t count;
+  uint8_t status = TS_GetPageRange(payload, size, &data, &count);
+  
+  if (status != TS_RESPONSE_OK) {
+    TS_SendFrame(status, NULL, 0);
     return;
   }
   
-  /* Send page data */
-  TS_SendResponse(tsPages[page], tsConfig.pageSize);
+  TS_SendFrame(TS_RESPONSE_OK, data, count);
+}
+
+/**
+  * @brief  Handle a chunk write, the data follows the range fields
+  * @param  payload: Request payload
+  * @param  size: Payload size
+  * @retval None
+  */
+static void TS_HandleWriteChunk(const uint8_t* payload, uint16_t size)
+{
+  uint8_t* data;
+  uint16_t count;
+  uint8_t status = TS_GetPageRange(payload, size, &data, &count);
+  
+  if (status == TS_RESPONSE_OK && size < 7 + count) {
+    status = TS_RESPONSE_UNDERRUN;
+  }
+  
+  if (status == TS_RESPONSE_OK) {
+    uint8_t page = TS_GET_U16(&payload[1]);
+    
+    TS_MarkDirty(page, TS_GET_U16(&payload[3]), &payload[7], count);
+    memcpy(data, &payload[7], count);
+  }
+  
+  TS_SendFrame(status, NULL, 0);
 }
 
 /**
-  * @brief  Handle Set Page command
-  * @param  page: Page number
-  * @param  data: Page data
+  * @brief  Handle a burn request
+  * @param  payload: Request payload, command and page (16-bit LE)
+  * @param  size: Payload size
   * @retval None
   */
-static void TS_HandleSetPage(uint8_t page, uint8_t* data)
+static void TS_HandleBurnPage(const uint8_t* payload, uint16_t size)
 {
-  /* Check if page is valid */
-  if (page >= tsConfig.pageCount || data == NULL) {
-    /* Invalid page - send empty response */
-    TS_SendResponse(NULL, 0);
+  if (size < 3) {
+    TS_SendFrame(TS_RESPONSE_UNDERRUN, NULL, 0);
+    return;
+  }
+  
+  uint16_t page = TS_GET_U16(&payload[1]);
+  
+  if (page >= TS_PAGE_COUNT) {
+    TS_SendFrame(TS_RESPONSE_OUT_OF_RANGE, NULL, 0);
+    return;
+  }
+  
+  TS_RefreshPage(page);
+  
+  if (!TS_CheckPage(page)) {
+    TS_SendFrame(TS_RESPONSE_BURN_FAILED, NULL, 0);
     return;
   }
   
-  /* Copy data to page */
-  memcpy(tsPages[page], data, tsConfig.pageSize);
+  /* Takes effect now; the changed chunks are written by TS_Process, so the
+     answer never waits for flash */
+  TS_ApplyPage(page);
   
-  /* Send success response */
-  uint8_t response = 1;
-  TS_SendResponse(&response, 1);
+  TS_SendFrame(TS_RESPONSE_BURN_OK, NULL, 0);
 }
 
 /**
-  * @brief  Handle Burn Page command
-  * @param  page: Page number
+  * @brief  Handle a CRC request, lets TunerStudio skip reading unchanged pages
+  * @param  payload: Request payload
+  * @param  size: Payload size
   * @retval None
   */
-static void TS_HandleBurnPage(uint8_t page)
+static void TS_HandlePageCRC(const uint8_t* payload, uint16_t size)
 {
-  /* Check if page is valid */
-  if (page >= tsConfig.pageCount) {
-    /* Invalid page - send empty response */
-    TS_SendResponse(NULL, 0);
+  uint8_t* data;
+  uint16_t count;
+  uint8_t status = TS_GetPageRange(payload, size, &data, &count);
+  
+  if (status != TS_RESPONSE_OK) {
+    TS_SendFrame(status, NULL, 0);
+    return;
+  }
+  
+  uint32_t crc = CRC32_Calculate(data, count);
+  
+  /* Sent after this returns, so not from the stack */
+  tsTxBuffer[0] = (uint8_t)(crc >> 24);
+  tsTxBuffer[1] = (uint8_t)(crc >> 16);
+  tsTxBuffer[2] = (uint8_t)(crc >> 8);
+  tsTxBuffer[3] = (uint8_t)crc;
+  
+  TS_SendFrame(TS_RESPONSE_OK, tsTxBuffer, 4);
+}
+
+/**
+  * @brief  Handle an output channel read
+  * @param  payload: Request payload, command, then offset and count (16-bit LE)
+  * @param  size: Payload size
+  * @retval None
+  */
+static void TS_HandleOutputChannels(const uint8_t* payload, uint16_t size)
+{
+  if (size < 5) {
+    TS_SendFrame(TS_RESPONSE_UNDERRUN, NULL, 0);
     return;
   }
   
-  /* In a real implementation, this would save the page to flash memory */
+  uint16_t count = TS_GET_U16(&payload[3]);
   
-  /* Send success response */
-  uint8_t response = 1;
-  TS_SendResponse(&response, 1);
+  if (!TS_ReadChannels(TS_GET_U16(&payload[1]), tsTxBuffer, count)) {
+    TS_SendFrame(TS_RESPONSE_OUT_OF_RANGE, NULL, 0);
+    return;
+  }
+  
+  TS_SendFrame(TS_RESPONSE_OK, tsTxBuffer, count);
 }
 
 /**
-  * @brief  Handle Get Channels command
+  * @brief  Start or stop the data logger
+  * @param  payload: Request payload, command, mode, source mask, then the first
+  *         and last CAN ID (32-bit LE) when starting
+  * @param  size: Payload size
+  * @retval None
+  */
+static void TS_HandleLoggerControl(const uint8_t* payload, uint16_t size)
+{
+  Data_Logger_Config_t config;
+  
+  if (size < 2 || (payload[1] != 0 && size < 11)) {
+    TS_SendFrame(TS_RESPONSE_UNDERRUN, NULL, 0);
+    return;
+  }
+  
+  if (payload[1] == 0) {
+    Data_Logger_Stop();
+    TS_SendFrame(TS_RESPONSE_OK, NULL, 0);
+    return;
+  }
+  
+  config.sourceMask = payload[2];
+  config.canIdFirst = TS_GET_U32(&payload[3]);
+  config.canIdLast = TS_GET_U32(&payload[7]);
+  
+  Data_Logger_Start(&config);
+  TS_SendFrame(TS_RESPONSE_OK, NULL, 0);
+}
+
+/**
+  * @brief  Send the next block of logged records
+  * @note   Records are released as they are sent; the block header tells
+  *         the tool how many are still waiting and how many were lost.
   * @param  None
   * @retval None
   */
-static void TS_HandleGetChannels(void)
+static void TS_HandleLoggerRead(void)
 {
-  /* Update channels before sending */
-  TS_UpdateChannels();
+  uint16_t length = Data_Logger_ReadBlock(tsTxBuffer, TS_MAX_PAYLOAD - 1);
   
-  /* Send channels data */
-  TS_SendResponse((uint8_t*)tsChannels, TS_MAX_CHANNELS * 4);
+  TS_SendFrame(TS_RESPONSE_OK, tsTxBuffer, length);
 }
 
 /**
-  * @brief  Update channels with current values
+  * @brief  Read every live source behind the output channels
+  * @note   Called per 'O' request only, nothing is sampled while TunerStudio
+  *         is not polling.
   * @param  None
   * @retval None
   */
-static void TS_UpdateChannels(void)
+static void TS_SampleChannels(void)
 {
-  /* In a real implementation, this would update the channels with current values */
+  Output_Manager_Stats_t outputStats;
+  Mapping_Engine_Stats_t mappingStats;
+  Data_Logger_Stats_t loggerStats;
+  TS_Channel_Values_t* values = &tsChannelValues;
+  
+  Output_Manager_GetStats(&outputStats);
+  Mapping_Engine_GetStats(&mappingStats);
+  Data_Logger_GetStats(&loggerStats);
   
-  /* Example: Update HID device count */
-  tsChannels[0][0] = 2;  /* 2 HID devices */
+  values->hidDevices = Input_Manager_GetDeviceCount();
+  values->mappings = Mapping_Engine_GetMappingCount();
+  values->activeProfile = Mapping_Engine_GetActiveProfile();
+  values->inputQueue = Input_Manager_GetEventCount();
+  values->canTxQueue = outputStats.canTxQueued;
+  values->canRxQueue = outputStats.canRxQueued;
+  values->serialTxQueue = outputStats.serialTxQueued;
+  values->timers = TS_SATURATE_U16(Timer_Wheel_GetActiveCount());
+  values->loggerPending = loggerStats.pending;
   
-  /* Example: Update active mappings */
-  tsChannels[1][0] = 5;  /* 5 active mappings */
+  values->lookupP50 = TS_SATURATE_U16(Mapping_Engine_GetLatencyPercentile(50));
+  values->lookupP99 = TS_SATURATE_U16(Mapping_Engine_GetLatencyPercentile(99));
+  values->lookupMax = TS_SATURATE_U16(mappingStats.maxCycles);
+  values->loopTime = TS_SATURATE_U16(Boot_Monitor_GetLoopTime());
   
-  /* Example: Update serial status */
-  tsChannels[2][0] = 1;  /* 1 = active */
+  values->mappingEvents = mappingStats.events;
+  values->canRxDropped = outputStats.canRxDropped;
+  values->loggerOverruns = loggerStats.overruns;
+  values->uptime = HAL_GetTick();
   
-  /* Example: Update CAN status */
-  tsChannels[3][0] = 1;  /* 1 = active */
+  TS_SampleRates(&outputStats, mappingStats.events);
+}
+
+/**
+  * @brief  Update the rate channels once the rate window has elapsed
+  * @note   At 50 Hz polling most requests fall inside the window and keep the
+  *         previous rates, which keeps them steady.
+  * @param  outputStats: Current output counters
+  * @param  mappingEvents: Current dispatched event count
+  * @retval None
+  */
+static void TS_SampleRates(const Output_Manager_Stats_t* outputStats, uint32_t mappingEvents)
+{
+  TS_Rate_Window_t* window = &tsRateWindow;
+  uint32_t now = HAL_GetTick();
+  uint32_t elapsed = now - window->tick;
+  
+  if (elapsed < TS_RATE_WINDOW_MS) {
+    return;
+  }
+  
+  /* After a pause in polling the rates average over the whole pause */
+  tsChannelValues.canTxRate = TS_GetRate(outputStats->canTxFrames, window->canTxFrames, elapsed);
+  tsChannelValues.canRxRate = TS_GetRate(outputStats->canRxFrames, window->canRxFrames, elapsed);
+  tsChannelValues.serialTxRate = TS_GetRate(outputStats->serialTxBytes, window->serialTxBytes, elapsed);
+  tsChannelValues.mappingRate = TS_GetRate(mappingEvents, window->mappingEvents, elapsed);
+  tsChannelValues.tsSerialRate = TS_GetRate(tsSerialBytes, window->tsSerialBytes, elapsed);
+  tsChannelValues.tsCanRate = TS_GetRate(tsCanBytes, window->tsCanBytes, elapsed);
+  tsChannelValues.loopPeak = TS_SATURATE_U16(Boot_Monitor_TakeLoopPeak());
+  
+  window->tick = now;
+  window->canTxFrames = outputStats->canTxFrames;
+  window->canRxFrames = outputStats->canRxFrames;
+  window->serialTxBytes = outputStats->serialTxBytes;
+  window->mappingEvents = mappingEvents;
+  window->tsSerialBytes = tsSerialBytes;
+  window->tsCanBytes = tsCanBytes;
+}
+
+/**
+  * @brief  Convert a counter difference into a per second rate
+  * @param  count: Counter now
+  * @param  windowCount: Counter at the start of the window
+  * @param  elapsed: Window length in ms
+  * @retval uint16_t: Events per second, saturated
+  */
+static uint16_t TS_GetRate(uint32_t count, uint32_t windowCount, uint32_t elapsed)
+{
+  uint64_t rate = (uint64_t)(count - windowCount) * 1000 / elapsed;
+  
+  return TS_SATURATE_U16(rate);
+}
+
+/**
+  * @brief  Mark the chunks a write changes as dirty
+  * @note   Called before the data is copied into the page, so rewriting a
+  *         chunk with the bytes it holds costs no flash at the next burn.
+  * @param  page: Page index
+  * @param  offset: First page byte written
+  * @param  data: New bytes
+  * @param  count: Number of bytes
+  * @retval None
+  */
+static void TS_MarkDirty(uint8_t page, uint16_t offset, const uint8_t* data, uint16_t count)
+{
+  const uint8_t* current = (const uint8_t*)&tsPages[page];
+  uint16_t end = offset + count;
+  
+  while (offset < end) {
+    uint16_t chunk = offset / TS_BURN_CHUNK_SIZE;
+    uint16_t chunkEnd = (chunk + 1) * TS_BURN_CHUNK_SIZE;
+    uint16_t length = (chunkEnd < end ? chunkEnd : end) - offset;
+    
+    if (memcmp(&current[offset], data, length) != 0) {
+      tsPageDirty[page] |= 1UL << chunk;
+    }
+    
+    data += length;
+    offset += length;
+  }
+}
+
+/**
+  * @brief  Bring a page up to date with the live configuration
+  * @note   The profile and interfaces also change without TunerStudio, from
+  *         a mapped key or a CAN command. Fields TunerStudio has written take
+  *         precedence, the others are captured again, so a later burn does
+  *         not put back what the page held when it was last captured.
+  *         Skipped while a serial response is sent from the page.
+  * @param  page: Page index
+  * @retval None
+  */
+static void TS_RefreshPage(uint8_t page)
+{
+  TS_Page_t edited;
+  
+  if (tsTxBusy) {
+    return;
+  }
+  
+  edited = tsPages[page];
+  tsPageBindings[page].capture();
+  
+  for (uint8_t i = 0; i < TS_FIELD_COUNT; i++) {
+    const TS_Page_Field_t* field = &tsFieldPlan[i];
+    const uint8_t* value = (const uint8_t*)&edited + field->offset;
+    uint8_t* live = (uint8_t*)&tsPageLive[page] + field->offset;
+    uint8_t* current = (uint8_t*)&tsPages[page] + field->offset;
+    uint8_t written;
+    
+    if (field->page != page) {
+      continue;
+    }
+    
+    written = memcmp(value, live, field->size) != 0;
+    memcpy(live, current, field->size);
+    
+    if (written) {
+      memcpy(current, value, field->size);
+    }
+  }
+}
+
+/**
+  * @brief  Apply a checked page and queue its changed chunks for flash
+  * @param  page: Page index
+  * @retval None
+  */
+static void TS_ApplyPage(uint8_t page)
+{
+  tsPageBindings[page].apply();
+  tsPageLive[page] = tsPages[page];
+  tsBurnPending[page] |= tsPageDirty[page];
+  tsPageDirty[page] = 0;
+}
+
+/**
+  * @brief  Write one burned chunk to flash
+  * @note   One record per call keeps each main loop pass short. The page
+  *         size is written after the last chunk of a page, marking its
+  *         chunks as belonging to this layout. A chunk that would fill the
+  *         active sector is held while the store still has to erase its
+  *         spare: the compaction would then erase 128 KB on the spot. The
+  *         realtime poll keeps the links busy while TunerStudio is
+  *         connected, so such a chunk can stay in RAM for up to
+  *         CONFIG_STORE_ERASE_MAX_MS, until the store erases anyway. Chunks
+  *         that fit are written at once.
+  * @param  None
+  * @retval None
+  */
+static void TS_ProcessBurn(void)
+{
+  Config_Store_Stats_t storeStats;
+  uint8_t page = 0;
+  uint8_t chunk = 0;
+  
+  while (page < TS_PAGE_COUNT && tsBurnPending[page] == 0) {
+    page++;
+  }
+  
+  if (page == TS_PAGE_COUNT) {
+    return;
+  }
+  
+  if (tsBurnHold && HAL_GetTick() - tsBurnHoldTick < TS_BURN_RETRY_MS) {
+    return;
+  }
+  
+  while (!(tsBurnPending[page] & (1UL << chunk))) {
+    chunk++;
+  }
+  
+  uint16_t offset = chunk * TS_BURN_CHUNK_SIZE;
+  uint16_t length = tsPageSizes[page] - offset < TS_BURN_CHUNK_SIZE ? tsPageSizes[page] - offset : TS_BURN_CHUNK_SIZE;
+  uint32_t needed = CONFIG_STORE_RECORD_SIZE(length);
+  
+  /* The last chunk of a page is followed by the page size */
+  if (tsBurnPending[page] == 1UL << chunk) {
+    needed += CONFIG_STORE_RECORD_SIZE(sizeof(tsPageSizes[page]));
+  }
+  
+  Config_Store_GetStats(&storeStats);
+  
+  if (storeStats.erasePending && needed > storeStats.freeBytes) {
+    return;
+  }
+  
+  uint8_t result = Config_Store_Write(CONFIG_KEY_TS_CHUNK(page, chunk), (const uint8_t*)&tsPages[page] + offset, length);
+  
+  if (result) {
+    tsBurnPending[page] &= ~(1UL << chunk);
+    
+    if (tsBurnPending[page] == 0) {
+      result = Config_Store_Write(CONFIG_KEY_TS_PAGE(page), &tsPageSizes[page], sizeof(tsPageSizes[page]));
+      
+      /* Rewriting the unchanged chunk costs nothing, it only brings the page size back */
+      if (!result) {
+        tsBurnPending[page] |= 1UL << chunk;
+      }
+    }
+  }
+  
+  tsBurnHold = !result;
+  tsBurnHoldTick = HAL_GetTick();
+}
+
+/**
+  * @brief  Check every field of a page against its limits in ts_protocol.h
+  * @param  page: Page index
+  * @retval uint8_t: 1 if all fields are in range, 0 otherwise
+  */
+static uint8_t TS_CheckPage(uint8_t page)
+{
+  switch (page) {
+    TS_PAGES(TS_CHECK_PAGE)
+    
+    default:
+      return 0;
+  }
+  
+  return 1;
+}
+
+/**
+  * @brief  Fill the settings page from the live output and mapping configuration
+  * @param  None
+  * @retval None
+  */
+static void TS_CaptureSettings(void)
+{
+  const Serial_Config_t* serialConfig = Output_Manager_GetSerialConfig();
+  const CAN_Config_t* canConfig = Output_Manager_GetCANConfig();
+  
+  TS_FIELD_PUT(settings, serialEnabled, serialConfig->enabled);
+  TS_FIELD_PUT(settings, serialBaudRate, serialConfig->baudRate);
+  TS_FIELD_PUT(settings, serialFormat, serialConfig->format);
+  TS_FIELD_PUT(settings, serialStopBits, serialConfig->stopBits);
+  TS_FIELD_PUT(settings, serialParity, serialConfig->parity);
+  TS_FIELD_PUT(settings, canEnabled, canConfig->enabled);
+  TS_FIELD_PUT(settings, canBitRate, canConfig->bitRate);
+  TS_FIELD_PUT(settings, canLoopback, canConfig->mode);
+  TS_FIELD_PUT(settings, mappingProfile, Mapping_Engine_GetActiveProfile());
+}
+
+/**
+  * @brief  Apply the settings page to the output and mapping configuration
+  * @note   An interface is only re-initialized if its settings changed.
+  * @param  None
+  * @retval None
+  */
+static void TS_ApplySettings(void)
+{
+  Serial_Config_t serialConfig;
+  CAN_Config_t canConfig;
+  uint8_t profile = TS_FIELD_GET(settings, mappingProfile);
+  
+  memcpy(&serialConfig, Output_Manager_GetSerialConfig(), sizeof(serialConfig));
+  memcpy(&canConfig, Output_Manager_GetCANConfig(), sizeof(canConfig));
+  
+  serialConfig.enabled = TS_FIELD_GET(settings, serialEnabled);
+  serialConfig.baudRate = TS_FIELD_GET(settings, serialBaudRate);
+  serialConfig.format = (Serial_Format_t)TS_FIELD_GET(settings, serialFormat);
+  serialConfig.stopBits = TS_FIELD_GET(settings, serialStopBits);
+  serialConfig.parity = TS_FIELD_GET(settings, serialParity);
+  canConfig.enabled = TS_FIELD_GET(settings, canEnabled);
+  canConfig.bitRate = TS_FIELD_GET(settings, canBitRate);
+  canConfig.mode = TS_FIELD_GET(settings, canLoopback);
+  
+  if (memcmp(&serialConfig, Output_Manager_GetSerialConfig(), sizeof(serialConfig)) != 0) {
+    Output_Manager_ConfigureSerial(&serialConfig);
+  }
+  
+  if (memcmp(&canConfig, Output_Manager_GetCANConfig(), sizeof(canConfig)) != 0) {
+    Output_Manager_ConfigureCAN(&canConfig);
+  }
+  
+  if (profile != Mapping_Engine_GetActiveProfile()) {
+    Mapping_Engine_SelectProfile(profile);
+  }
+}
+
+/**
+  * @brief  Read a page field, little endian
+  * @param  data: First byte of the field
+  * @param  size: Field size in bytes
+  * @retval uint32_t: Field value
+  */
+static uint32_t TS_GetValue(const uint8_t* data, uint8_t size)
+{
+  uint32_t value = 0;
+  
+  for (uint8_t i = 0; i < size; i++) {
+    value |= (uint32_t)data[i] << (8 * i);
+  }
+  
+  return value;
+}
+
+/**
+  * @brief  Store a page field, little endian
+  * @param  data: First byte of the field
+  * @param  size: Field size in bytes
+  * @param  value: Field value
+  * @retval None
+  */
+static void TS_PutValue(uint8_t* data, uint8_t size, uint32_t value)
+{
+  for (uint8_t i = 0; i < size; i++) {
+    data[i] = (uint8_t)(value >> (8 * i));
+  }
 }
@@ -0,0 +1,525 @@
+/**
+ * @file uds_server.c
+ * @brief UDS diagnostic server implementation for STM32F407 HID to Serial/CAN project
+ * @author Manus AI
+ * @date 2025-03-28
+ *
+ * Answers ISO 14229 requests from scan tools and testers on the CAN bus,
+ * carried by an ISO-TP link of its own. Live values and configuration are
+ * read and written by data identifier:
+ *
+ * - 0x22 ReadDataByIdentifier, one or more identifiers per request
+ * - 0x2E WriteDataByIdentifier, configuration fields in the extended session
+ * - 0x10 DiagnosticSessionControl, default and extended session
+ * - 0x3E TesterPresent, keeps the extended session open
+ *
+ * Identifiers for the configuration fields and output channels are generated
+ * from the lists in ts_protocol.h, so they read the same values TunerStudio
+ * sees and writes go through the same range checks and burn.
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "uds_server.h"
+#include "tunerstudio.h"
+#include "output_manager.h"
+#include "isotp.h"
+#include <stddef.h>
+#include <string.h>
+
+/* Private typedef -----------------------------------------------------------*/
+typedef enum {
+  UDS_SOURCE_FIELD = 0,     /* Configuration page field */
+  UDS_SOURCE_CHANNEL,       /* Output channel */
+  UDS_SOURCE_SESSION,       /* Active session */
+  UDS_SOURCE_TEXT           /* Constant text */
+} Uds_Source_t;
+
+/* One data identifier and where its value lives */
+typedef struct {
+  uint16_t did;
+  uint8_t source;           /* Uds_Source_t */
+  uint8_t page;             /* Page of a configuration field */
+  uint16_t offset;          /* In the page or the channel block */
+  uint8_t size;
+  const char* text;         /* Value of a text identifier */
+} Uds_Did_t;
+
+/* Identifier numbers follow list order in ts_protocol.h */
+#define UDS_FIELD_INDEX(page, name, ...)        UDS_FIELD_##page##_##name,
+#define UDS_PAGE_FIELD_INDEX(id, title, fields) fields(UDS_FIELD_INDEX, id)
+#define UDS_CHANNEL_INDEX(name, ...)            UDS_CHANNEL_##name,
+
+typedef enum {
+  TS_PAGES(UDS_PAGE_FIELD_INDEX)
+  UDS_FIELD_COUNT
+} Uds_Field_Index_t;
+
+typedef enum {
+  TS_OUTPUT_CHANNELS(UDS_CHANNEL_INDEX)
+  UDS_CHANNEL_COUNT
+} Uds_Channel_Index_t;
+
+/* Private define ------------------------------------------------------------*/
+#define UDS_ISOTP_BLOCK_SIZE      0     /* Requests are drained every pass, no flow control */
+#define UDS_ISOTP_STMIN           0     /* Consecutive frames back to back */
+
+/* Service identifiers */
+#define UDS_SID_SESSION_CONTROL   0x10
+#define UDS_SID_READ_DATA         0x22
+#define UDS_SID_WRITE_DATA        0x2E
+#define UDS_SID_TESTER_PRESENT    0x3E
+#define UDS_SID_NEGATIVE          0x7F
+#define UDS_POSITIVE_OFFSET       0x40
+#define UDS_SUPPRESS_POSITIVE     0x80  /* Sub-function bit, no positive response */
+
+/* Negative response codes */
+#define UDS_NRC_SERVICE_NOT_SUPPORTED     0x11
+#define UDS_NRC_SUBFUNCTION_NOT_SUPPORTED 0x12
+#define UDS_NRC_INCORRECT_LENGTH          0x13
+#define UDS_NRC_RESPONSE_TOO_LONG         0x14
+#define UDS_NRC_CONDITIONS_NOT_CORRECT    0x22
+#define UDS_NRC_REQUEST_OUT_OF_RANGE      0x31
+#define UDS_NRC_NOT_IN_ACTIVE_SESSION     0x7F
+
+/* Private macro -------------------------------------------------------------*/
+#define UDS_FIELD_ENTRY(page, name, type, ...) \
+  {UDS_DID_FIELD_BASE + UDS_FIELD_##page##_##name, UDS_SOURCE_FIELD, TS_PAGE_##page, \
+   offsetof(TS_Page_##page##_t, name), TS_TYPE_SIZE(type), NULL},
+#define UDS_PAGE_ENTRIES(id, title, fields) \
+  fields(UDS_FIELD_ENTRY, id)
+#define UDS_CHANNEL_ENTRY(name, type, ...) \
+  {UDS_DID_CHANNEL_BASE + UDS_CHANNEL_##name, UDS_SOURCE_CHANNEL, 0, \
+   offsetof(TS_Channel_Block_t, name), TS_TYPE_SIZE(type), NULL},
+#define UDS_TEXT_ENTRY(did, text) \
+  {did, UDS_SOURCE_TEXT, 0, 0, sizeof(text) - 1, text},
+
+/* Private variables ---------------------------------------------------------*/
+/* Sorted by identifier for the binary search in Uds_Server_FindDid. The
+   generated ranges are ascending by construction, the asserts below keep
+   them from running into each other. */
+static const Uds_Did_t udsDids[] = {
+  TS_PAGES(UDS_PAGE_ENTRIES)
+  TS_OUTPUT_CHANNELS(UDS_CHANNEL_ENTRY)
+  {UDS_DID_ACTIVE_SESSION, UDS_SOURCE_SESSION, 0, 0, 1, NULL},
+  UDS_TEXT_ENTRY(UDS_DID_SOFTWARE_VERSION, TS_VERSION_STRING)
+  UDS_TEXT_ENTRY(UDS_DID_SYSTEM_NAME, TS_SIGNATURE)
+};
+
+#define UDS_DID_COUNT             (sizeof(udsDids) / sizeof(udsDids[0]))
+
+_Static_assert(UDS_DID_FIELD_BASE + UDS_FIELD_COUNT <= UDS_DID_CHANNEL_BASE, "UDS field identifiers run into the channels");
+_Static_assert(UDS_DID_CHANNEL_BASE + UDS_CHANNEL_COUNT <= UDS_DID_ACTIVE_SESSION, "UDS channel identifiers run into the fixed ones");
+_Static_assert(UDS_DID_ACTIVE_SESSION < UDS_DID_SOFTWARE_VERSION && UDS_DID_SOFTWARE_VERSION < UDS_DID_SYSTEM_NAME, "UDS fixed identifiers out of order");
+
+/* The link buffer holds the request, then the response built over it */
+IsoTp_Link_t udsLink;
+uint8_t udsBuffer[UDS_BUFFER_SIZE];
+uint8_t udsRequest[UDS_MAX_REQUEST];
+uint8_t udsFunctional = 0;  /* Request arrived on the functional identifier */
+
+uint8_t udsSession = UDS_SESSION_DEFAULT;
+uint32_t udsSessionTick = 0;
+uint32_t udsRequestTick = 0;     /* Last request, for Uds_Server_IsIdle */
+
+TS_Channel_Block_t udsChannels;  /* Sampled once per read request */
+Uds_Server_Stats_t udsStats;
+
+/* Private function prototypes -----------------------------------------------*/
+static void Uds_Server_CANRxCallback(uint32_t canId, uint8_t* data, uint8_t length);
+static uint16_t Uds_Server_HandleRequest(uint16_t length);
+static uint16_t Uds_Server_SessionControl(const uint8_t* request, uint16_t length);
+static uint16_t Uds_Server_TesterPresent(const uint8_t* request, uint16_t length);
+static uint16_t Uds_Server_ReadData(const uint8_t* request, uint16_t length);
+static uint16_t Uds_Server_WriteData(const uint8_t* request, uint16_t length);
+static uint16_t Uds_Server_Negative(uint8_t service, uint8_t code);
+static const Uds_Did_t* Uds_Server_FindDid(uint16_t did);
+static void Uds_Server_ReadDid(const Uds_Did_t* entry, uint8_t* data);
+static void Uds_Server_SwapBytes(uint8_t* dest, const uint8_t* src, uint8_t size);
+
+/**
+  * @brief  UDS server initialization function
+  * @note   Call after TS_Init, the identifiers read its pages.
+  * @param  None
+  * @retval None
+  */
+void Uds_Server_Init(void)
+{
+  memset(&udsStats, 0, sizeof(udsStats));
+  udsSession = UDS_SESSION_DEFAULT;
+  udsFunctional = 0;
+  
+  IsoTp_Init(&udsLink, UDS_CAN_REQUEST_ID, UDS_CAN_RESPONSE_ID, udsBuffer, sizeof(udsBuffer));
+  IsoTp_SetFlowControl(&udsLink, UDS_ISOTP_BLOCK_SIZE, UDS_ISOTP_STMIN);
+  Output_Manager_RegisterCANRxCallback(Uds_Server_CANRxCallback);
+}
+
+/**
+  * @brief  UDS server process function, should be called every main loop pass
+  * @param  None
+  * @retval None
+  */
+void Uds_Server_Process(void)
+{
+  /* The tester went away, writes are locked again */
+  if (udsSession != UDS_SESSION_DEFAULT && HAL_GetTick() - udsSessionTick > UDS_S3_MS) {
+    udsSession = UDS_SESSION_DEFAULT;
+  }
+  
+  IsoTp_Process(&udsLink);
+  
+  uint16_t length = IsoTp_Take(&udsLink);
+  
+  if (length == 0) {
+    return;
+  }
+  
+  length = Uds_Server_HandleRequest(length);
+  
+  if (length > 0) {
+    IsoTp_Send(&udsLink, length);
+  }
+}
+
+/**
+  * @brief  Get the active diagnostic session
+  * @param  None
+  * @retval uint8_t: UDS_SESSION_DEFAULT or UDS_SESSION_EXTENDED
+  */
+uint8_t Uds_Server_GetSession(void)
+{
+  return udsSession;
+}
+
+/**
+  * @brief  Check whether the server is idle
+  * @param  quietMs: Time without requests that counts as idle
+  * @retval uint8_t: 1 if nothing is being sent or received and no request
+  *         arrived for quietMs, 0 otherwise
+  */
+uint8_t Uds_Server_IsIdle(uint32_t quietMs)
+{
+  return IsoTp_IsIdle(&udsLink) && HAL_GetTick() - udsRequestTick >= quietMs;
+}
+
+/**
+  * @brief  Get UDS server statistics
+  * @param  stats: Pointer to structure receiving the statistics
+  * @retval None
+  */
+void Uds_Server_GetStats(Uds_Server_Stats_t* stats)
+{
+  *stats = udsStats;
+  stats->linkErrors = udsLink.errors;
+}
+
+/**
+  * @brief  CAN receive callback, passes request frames to the ISO-TP link
+  * @note   Functional requests are single frames by definition and are only
+  *         taken while the link is free.
+  * @param  canId: CAN identifier
+  * @param  data: Frame data
+  * @param  length: Data length
+  * @retval None
+  */
+static void Uds_Server_CANRxCallback(uint32_t canId, uint8_t* data, uint8_t length)
+{
+  if (canId == UDS_CAN_REQUEST_ID) {
+    udsFunctional = 0;
+    IsoTp_Receive(&udsLink, data, length);
+  } else if (canId == UDS_CAN_FUNCTIONAL_ID && length > 0 && (data[0] & 0xF0) == 0x00 && IsoTp_IsIdle(&udsLink)) {
+    udsFunctional = 1;
+    IsoTp_Receive(&udsLink, data, length);
+  }
+}
+
+/**
+  * @brief  Handle a request in the link buffer
+  * @note   The request is copied out first, the response is built in the
+  *         link buffer.
+  * @param  length: Request length
+  * @retval uint16_t: Response length, 0 for no response
+  */
+static uint16_t Uds_Server_HandleRequest(uint16_t length)
+{
+  udsStats.requests++;
+  udsSessionTick = HAL_GetTick();
+  udsRequestTick = udsSessionTick;
+  
+  if (length > UDS_MAX_REQUEST) {
+    return Uds_Server_Negative(udsBuffer[0], UDS_NRC_INCORRECT_LENGTH);
+  }
+  
+  memcpy(udsRequest, udsBuffer, length);
+  
+  switch (udsRequest[0]) {
+    case UDS_SID_SESSION_CONTROL:
+      return Uds_Server_SessionControl(udsRequest, length);
+    
+    case UDS_SID_READ_DATA:
+      return Uds_Server_ReadData(udsRequest, length);
+    
+    case UDS_SID_WRITE_DATA:
+      return Uds_Server_WriteData(udsRequest, length);
+    
+    case UDS_SID_TESTER_PRESENT:
+      return Uds_Server_TesterPresent(udsRequest, length);
+    
+    default:
+      return Uds_Server_Negative(udsRequest[0], UDS_NRC_SERVICE_NOT_SUPPORTED);
+  }
+}
+
+/**
+  * @brief  Handle DiagnosticSessionControl
+  * @param  request: Service, session
+  * @param  length: Request length
+  * @retval uint16_t: Response length, 0 for no response
+  */
+static uint16_t Uds_Server_SessionControl(const uint8_t* request, uint16_t length)
+{
+  if (length != 2) {
+    return Uds_Server_Negative(request[0], UDS_NRC_INCORRECT_LENGTH);
+  }
+  
+  uint8_t session = request[1] & ~UDS_SUPPRESS_POSITIVE;
+  
+  if (session != UDS_SESSION_DEFAULT && session != UDS_SESSION_EXTENDED) {
+    return Uds_Server_Negative(request[0], UDS_NRC_SUBFUNCTION_NOT_SUPPORTED);
+  }
+  
+  udsSession = session;
+  
+  if (request[1] & UDS_SUPPRESS_POSITIVE) {
+    return 0;
+  }
+  
+  /* Timing the tester should allow: P2 in ms, P2* in 10 ms units */
+  udsBuffer[0] = UDS_SID_SESSION_CONTROL + UDS_POSITIVE_OFFSET;
+  udsBuffer[1] = session;
+  udsBuffer[2] = (uint8_t)(UDS_P2_MS >> 8);
+  udsBuffer[3] = (uint8_t)UDS_P2_MS;
+  udsBuffer[4] = (uint8_t)((UDS_P2_EXTENDED_MS / 10) >> 8);
+  udsBuffer[5] = (uint8_t)(UDS_P2_EXTENDED_MS / 10);
+  
+  return 6;
+}
+
+/**
+  * @brief  Handle TesterPresent, the request itself restarts the session timer
+  * @param  request: Service, zero sub-function
+  * @param  length: Request length
+  * @retval uint16_t: Response length, 0 for no response
+  */
+static uint16_t Uds_Server_TesterPresent(const uint8_t* request, uint16_t length)
+{
+  if (length != 2) {
+    return Uds_Server_Negative(request[0], UDS_NRC_INCORRECT_LENGTH);
+  }
+  
+  if ((request[1] & ~UDS_SUPPRESS_POSITIVE) != 0) {
+    return Uds_Server_Negative(request[0], UDS_NRC_SUBFUNCTION_NOT_SUPPORTED);
+  }
+  
+  if (request[1] & UDS_SUPPRESS_POSITIVE) {
+    return 0;
+  }
+  
+  udsBuffer[0] = UDS_SID_TESTER_PRESENT + UDS_POSITIVE_OFFSET;
+  udsBuffer[1] = 0;
+  
+  return 2;
+}
+
+/**
+  * @brief  Handle ReadDataByIdentifier
+  * @note   Unknown identifiers are skipped, the request is only refused when
+  *         none is known. Channels are sampled once for the whole request.
+  * @param  request: Service, then identifiers (16-bit BE)
+  * @param  length: Request length
+  * @retval uint16_t: Response length
+  */
+static uint16_t Uds_Server_ReadData(const uint8_t* request, uint16_t length)
+{
+  uint16_t position = 1;
+  uint8_t sampled = 0;
+  
+  if (length < 3 || (length - 1) % 2 != 0) {
+    return Uds_Server_Negative(request[0], UDS_NRC_INCORRECT_LENGTH);
+  }
+  
+  for (uint16_t i = 1; i < length; i += 2) {
+    uint16_t did = (request[i] << 8) | request[i + 1];
+    const Uds_Did_t* entry = Uds_Server_FindDid(did);
+    
+    if (entry == NULL) {
+      continue;
+    }
+    
+    if (position + 2 + entry->size > UDS_BUFFER_SIZE) {
+      return Uds_Server_Negative(request[0], UDS_NRC_RESPONSE_TOO_LONG);
+    }
+    
+    if (entry->source == UDS_SOURCE_CHANNEL && !sampled) {
+      TS_ReadChannels(0, (uint8_t*)&udsChannels, sizeof(udsChannels));
+      sampled = 1;
+    }
+    
+    udsBuffer[position++] = (uint8_t)(did >> 8);
+    udsBuffer[position++] = (uint8_t)did;
+    Uds_Server_ReadDid(entry, &udsBuffer[position]);
+    position += entry->size;
+  }
+  
+  if (position == 1) {
+    return Uds_Server_Negative(request[0], UDS_NRC_REQUEST_OUT_OF_RANGE);
+  }
+  
+  udsBuffer[0] = UDS_SID_READ_DATA + UDS_POSITIVE_OFFSET;
+  
+  return position;
+}
+
+/**
+  * @brief  Handle WriteDataByIdentifier
+  * @note   The field is written and burned at once, it keeps its value
+  *         across resets without a separate store request.
+  * @param  request: Service, identifier (16-bit BE), value (BE)
+  * @param  length: Request length
+  * @retval uint16_t: Response length
+  */
+static uint16_t Uds_Server_WriteData(const uint8_t* request, uint16_t length)
+{
+  uint8_t value[4];
+  
+  if (udsSession != UDS_SESSION_EXTENDED) {
+    return Uds_Server_Negative(request[0], UDS_NRC_NOT_IN_ACTIVE_SESSION);
+  }
+  
+  if (length < 4) {
+    return Uds_Server_Negative(request[0], UDS_NRC_INCORRECT_LENGTH);
+  }
+  
+  const Uds_Did_t* entry = Uds_Server_FindDid((request[1] << 8) | request[2]);
+  
+  if (entry == NULL || entry->source != UDS_SOURCE_FIELD || entry->size > sizeof(value)) {
+    return Uds_Server_Negative(request[0], UDS_NRC_REQUEST_OUT_OF_RANGE);
+  }
+  
+  if (length != 3 + entry->size) {
+    return Uds_Server_Negative(request[0], UDS_NRC_INCORRECT_LENGTH);
+  }
+  
+  Uds_Server_SwapBytes(value, &request[3], entry->size);
+  
+  switch (TS_WritePage(entry->page, entry->offset, value, entry->size)) {
+    case TS_RESPONSE_BURN_OK:
+      break;
+    
+    case TS_RESPONSE_OUT_OF_RANGE:
+      return Uds_Server_Negative(request[0], UDS_NRC_REQUEST_OUT_OF_RANGE);
+    
+    default:
+      return Uds_Server_Negative(request[0], UDS_NRC_CONDITIONS_NOT_CORRECT);
+  }
+  
+  udsBuffer[0] = UDS_SID_WRITE_DATA + UDS_POSITIVE_OFFSET;
+  udsBuffer[1] = request[1];
+  udsBuffer[2] = request[2];
+  
+  return 3;
+}
+
+/**
+  * @brief  Build a negative response
+  * @note   Functional requests get no answer for services, sub-functions or
+  *         identifiers the server does not have, so a broadcast to every ECU
+  *         is only answered by those that can.
+  * @param  service: Service of the request
+  * @param  code: Negative response code
+  * @retval uint16_t: Response length, 0 for no response
+  */
+static uint16_t Uds_Server_Negative(uint8_t service, uint8_t code)
+{
+  if (udsFunctional && (code == UDS_NRC_SERVICE_NOT_SUPPORTED || code == UDS_NRC_SUBFUNCTION_NOT_SUPPORTED ||
+                        code == UDS_NRC_REQUEST_OUT_OF_RANGE || code == UDS_NRC_NOT_IN_ACTIVE_SESSION)) {
+    return 0;
+  }
+  
+  udsStats.negativeResponses++;
+  
+  udsBuffer[0] = UDS_SID_NEGATIVE;
+  udsBuffer[1] = service;
+  udsBuffer[2] = code;
+  
+  return 3;
+}
+
+/**
+  * @brief  Look up an identifier
+  * @param  did: Data identifier
+  * @retval const Uds_Did_t*: Table entry, NULL if the identifier is unknown
+  */
+static const Uds_Did_t* Uds_Server_FindDid(uint16_t did)
+{
+  uint16_t low = 0;
+  uint16_t high = UDS_DID_COUNT;
+  
+  while (low < high) {
+    uint16_t middle = (low + high) / 2;
+    
+    if (udsDids[middle].did < did) {
+      low = middle + 1;
+    } else if (udsDids[middle].did > did) {
+      high = middle;
+    } else {
+      return &udsDids[middle];
+    }
+  }
+  
+  return NULL;
+}
+
+/**
+  * @brief  Write the value of an identifier, big endian
+  * @param  entry: Table entry
+  * @param  data: Receives entry->size bytes
+  * @retval None
+  */
+static void Uds_Server_ReadDid(const Uds_Did_t* entry, uint8_t* data)
+{
+  uint8_t value[4];
+  
+  switch (entry->source) {
+    case UDS_SOURCE_FIELD:
+      TS_ReadPage(entry->page, entry->offset, value, entry->size);
+      Uds_Server_SwapBytes(data, value, entry->size);
+      break;
+    
+    case UDS_SOURCE_CHANNEL:
+      Uds_Server_SwapBytes(data, (const uint8_t*)&udsChannels + entry->offset, entry->size);
+      break;
+    
+    case UDS_SOURCE_SESSION:
+      data[0] = udsSession;
+      break;
+    
+    default:
+      memcpy(data, entry->text, entry->size);
+      break;
+  }
+}
+
+/**
+  * @brief  Copy a value and reverse its byte order
+  * @note   Pages and channels are little endian, UDS values big endian.
+  * @param  dest: Destination
+  * @param  src: Source
+  * @param  size: Value size in bytes
+  * @retval None
+  */
+static void Uds_Server_SwapBytes(uint8_t* dest, const uint8_t* src, uint8_t size)
+{
+  for (uint8_t i = 0; i < size; i++) {
+    dest[i] = src[size - 1 - i];
+  }
+}
@@ -8,6 +8,7 @@
 /* Includes ------------------------------------------------------------------*/
 #include "usb_host.h"
 #include "main.h"
+#include "boot_monitor.h"
 #include <stdint.h>
 #include <string.h>
 #include <stdio.h>
@@ -167,6 +168,7 @@ static void USBH_UserProcess(USBH_HandleTypeDef *phost, uint8_t id)
     
     case HOST_USER_CLASS_ACTIVE:
       hostState = USB_HOST_DEVICE_CLASS_ACTIVE;
+      Boot_Monitor_Mark(BOOT_PHASE_USB_DEVICE);
       
       /* New device connected */
       if (deviceCount < MAX_HID_DEVICES) {
@@ -8,6 +8,8 @@
 /* Includes ------------------------------------------------------------------*/
 #include "web_server.h"
 #include "main.h"
+#include "config_store.h"
+#include "boot_monitor.h"
 #include <stdint.h>
 #include <string.h>
 #include <stdio.h>
@@ -17,8 +19,6 @@
 
 /* Private typedef -----------------------------------------------------------*/
 /* Private define ------------------------------------------------------------*/
-#define WEB_CONFIG_ADDR       0x08090000  /* Flash sector for configuration storage */
-#define WEB_CONFIG_SIZE       (sizeof(Web_Server_Config_t) + 8)
 
 /* Private macro -------------------------------------------------------------*/
 /* Private variables ---------------------------------------------------------*/
@@ -42,14 +42,9 @@ void Web_Server_Init(void)
   /* Load configuration from flash */
   Web_Server_LoadConfig();
   
-  /* Initialize network */
-  Web_Server_InitNetwork();
-  
-  /* Initialize HTTP server */
-  Web_Server_InitHTTPD();
-  
-  /* Set initial state */
-  webServerState = WEB_SERVER_STATE_IDLE;
+  /* Network and HTTP server come up from Web_Server_Process so that
+     Ethernet bring-up does not hold up the rest of the boot */
+  webServerState = WEB_SERVER_STATE_STARTING;
 }
 
 /**
@@ -61,11 +56,21 @@ void Web_Server_Process(void)
 {
   /* Process based on state */
   switch (webServerState) {
+    case WEB_SERVER_STATE_STARTING:
+      /* Initialize network */
+      Web_Server_InitNetwork();
+      
+      /* Initialize HTTP server */
+      Web_Server_InitHTTPD();
+      break;
+    
     case WEB_SERVER_STATE_IDLE:
       /* Nothing to do */
       break;
     
     case WEB_SERVER_STATE_LISTENING:
+      Boot_Monitor_Mark(BOOT_PHASE_NETWORK_READY);
+      
       /* Check for incoming connections */
       /* This is handled by lwIP in the background */
       break;
@@ -197,10 +202,7 @@ uint8_t Web_Server_Stop(void)
   */
 uint8_t Web_Server_SaveConfig(void)
 {
-  /* In a real implementation, this would save the configuration to flash memory
-     using the STM32 HAL flash functions. For this example, we'll just return success. */
-  
-  return 1;
+  return Config_Store_Write(CONFIG_KEY_WEB_SERVER, &webServerConfig, sizeof(webServerConfig));
 }
 
 /**
@@ -210,12 +212,11 @@ uint8_t Web_Server_SaveConfig(void)
   */
 uint8_t Web_Server_LoadConfig(void)
 {
-  /* In a real implementation, this would load the configuration from flash memory
-     using the STM32 HAL flash functions. For this example, we'll set default values. */
-  
-  /* Set default configuration */
+  /* Start from defaults so a missing or stale record leaves them in place */
   Web_Server_ResetConfig();
   
+  Config_Store_Read(CONFIG_KEY_WEB_SERVER, &webServerConfig, sizeof(webServerConfig));
+  
   return 1;
 }
 
@@ -0,0 +1,143 @@
+#!/usr/bin/env python3
+"""
+Generate a flash font atlas for STM32F407 HID to Serial/CAN project.
+
+Rasterizes the printable ASCII range of a TrueType font with 2-bit
+anti-aliasing and writes a C file defining fontDefault (see inc/font.h).
+Each glyph is cropped to its ink box and stored run-length encoded, one
+byte per run: the coverage level (0-3) in the top two bits and the run
+length minus one in the low six. Runs continue across rows.
+
+Built with `make FONT_TTF=<font.ttf> [FONT_HEIGHT=16]`. Without FONT_TTF the
+checked-in src/font_atlas.c is used. Requires Pillow.
+"""
+
+import argparse
+import os
+import sys
+
+try:
+    from PIL import Image, ImageDraw, ImageFont
+except ImportError:
+    raise SystemExit("gen_font: Pillow is required (pip install pillow)")
+
+FIRST_CHAR = 0x20
+LAST_CHAR = 0x7E
+MAX_RUN = 64
+
+
+def fit_font(path, height):
+    """Largest size whose glyph ink fits in the line height, and its baseline."""
+    text = "".join(chr(code) for code in range(FIRST_CHAR, LAST_CHAR + 1))
+    size = height * 2
+    while size > 4:
+        font = ImageFont.truetype(path, size)
+        top = min(font.getbbox(char, anchor="ls")[1] for char in text)
+        bottom = max(font.getbbox(char, anchor="ls")[3] for char in text)
+        if bottom - top <= height:
+            return font, -top
+        size -= 1
+    raise SystemExit("gen_font: line height %d too small" % height)
+
+
+def rasterize(font, baseline, height, char):
+    """Return (levels, width, height, x offset, y offset, advance) of one glyph."""
+    advance = int(round(font.getlength(char)))
+    canvas = Image.new("L", (advance + height * 2, height), 0)
+    ImageDraw.Draw(canvas).text((height, baseline), char, fill=255, font=font, anchor="ls")
+    pixels = canvas.load()
+
+    levels = [[(pixels[x, y] * 3 + 127) // 255 for x in range(canvas.width)]
+              for y in range(canvas.height)]
+    rows = [y for y in range(canvas.height) if any(levels[y])]
+    cols = [x for x in range(canvas.width) if any(levels[y][x] for y in range(canvas.height))]
+    if not rows:
+        return [], 0, 0, 0, 0, advance
+
+    x0, x1 = cols[0], cols[-1] + 1
+    y0, y1 = rows[0], rows[-1] + 1
+    box = [level for y in range(y0, y1) for level in levels[y][x0:x1]]
+    return box, x1 - x0, y1 - y0, x0 - height, y0, advance
+
+
+def encode(levels):
+    data = []
+    index = 0
+    while index < len(levels):
+        level = levels[index]
+        run = 1
+        while index + run < len(levels) and levels[index + run] == level and run < MAX_RUN:
+            run += 1
+        data.append((level << 6) | (run - 1))
+        index += run
+    return data
+
+
+def generate(path, height, source):
+    font, baseline = fit_font(path, height)
+    glyphs = []
+    data = []
+
+    for code in range(FIRST_CHAR, LAST_CHAR + 1):
+        levels, width, rows, x_offset, y_offset, advance = rasterize(font, baseline, height, chr(code))
+        if not -128 <= x_offset <= 127 or advance > 255:
+            raise SystemExit("gen_font: glyph 0x%02X does not fit the glyph record" % code)
+        glyphs.append((code, len(data), width, rows, x_offset, y_offset, advance))
+        data.extend(encode(levels))
+
+    if len(data) > 0xFFFF:
+        raise SystemExit("gen_font: %d bytes of glyph data, more than 64 KB" % len(data))
+
+    lines = [
+        "/**",
+        " * @file font_atlas.c",
+        " * @brief Generated by tools/gen_font.py from %s at %d px, do not edit" % (source, height),
+        " */",
+        "",
+        "/* Includes ------------------------------------------------------------------*/",
+        '#include "font.h"',
+        "",
+        "/* Private variables ---------------------------------------------------------*/",
+        "static const uint8_t fontDefaultData[%d] = {" % len(data),
+    ]
+    for start in range(0, len(data), 16):
+        lines.append("  " + " ".join("0x%02X," % byte for byte in data[start:start + 16]))
+    lines.append("};")
+    lines.append("")
+    lines.append("static const Font_Glyph_t fontDefaultGlyphs[%d] = {" % len(glyphs))
+    for code, offset, width, rows, x_offset, y_offset, advance in glyphs:
+        text = chr(code).replace("\\", "\\\\").replace("'", "\\'")
+        lines.append("  { %5d, %2d, %2d, %3d, %2d, %2d },  /* '%s' */" % (
+            offset, width, rows, x_offset, y_offset, advance, text))
+    lines.append("};")
+    lines.extend([
+        "",
+        "/* Exported variables --------------------------------------------------------*/",
+        "const Font_t fontDefault = {",
+        "  .height = %d," % height,
+        "  .firstChar = 0x%02X," % FIRST_CHAR,
+        "  .glyphCount = %d," % len(glyphs),
+        "  .glyphs = fontDefaultGlyphs,",
+        "  .data = fontDefaultData,",
+        "};",
+    ])
+    return "\n".join(lines) + "\n"
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[1])
+    parser.add_argument("font", help="TrueType font file")
+    parser.add_argument("output", help="C file to write")
+    parser.add_argument("--height", type=int, default=16, help="line height in pixels")
+    args = parser.parse_args()
+
+    text = generate(args.font, args.height, os.path.basename(args.font))
+
+    with open(args.output, "w") as f:
+        f.write(text)
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,214 @@
+#!/usr/bin/env python3
+"""
+Generate flash-resident mapping profiles for STM32F407 HID to Serial/CAN project.
+
+Reads a JSON mapping configuration and writes a C file defining
+mappingTableProfiles[], already sorted into the dispatch order the engine
+keeps at runtime. Built with `make MAPPING_TABLE=<config.json>`.
+
+Configuration format:
+
+    {
+      "profiles": [
+        {
+          "name": "Default",
+          "mappings": [
+            {"device": 0, "event": "key_press", "input": "0x04", "min": 0, "max": 1,
+             "output": {"type": "serial", "format": 0, "length": 1}},
+            {"device": 1, "event": "axis_change", "input": 0, "min": -127, "max": 127,
+             "output": {"type": "can", "id": "0x100", "dlc": 8, "index": 0}},
+            {"device": 0, "event": "key_press", "input": "0x3A", "min": 1, "max": 1,
+             "output": {"type": "profile", "profile": 1}},
+            {"device": 0, "event": "key_press", "input": "0x3B", "min": 1, "max": 1,
+             "output": {"type": "macro", "macro": 0}}
+          ]
+        }
+      ]
+    }
+"""
+
+import argparse
+import json
+import os
+import re
+import sys
+
+
+def parse_int(value):
+    if isinstance(value, int):
+        return value
+    return int(str(value), 0)
+
+
+def read_header(include_dir, name):
+    with open(os.path.join(include_dir, name)) as f:
+        return f.read()
+
+
+def parse_define(text, name):
+    match = re.search(r"#define\s+%s\s+(\w+)" % name, text)
+    if not match:
+        raise SystemExit("gen_mapping_table: %s not found" % name)
+    return int(match.group(1), 0)
+
+
+def parse_enum(text, type_name):
+    """Return {name: value} for a typedef enum, following the C numbering rules."""
+    match = re.search(r"typedef\s+enum\s*\{([^}]*)\}\s*%s\s*;" % type_name, text)
+    if not match:
+        raise SystemExit("gen_mapping_table: enum %s not found" % type_name)
+    values = {}
+    next_value = 0
+    body = re.sub(r"/\*.*?\*/", "", match.group(1), flags=re.S)
+    for entry in body.split(","):
+        entry = entry.strip()
+        if not entry:
+            continue
+        if "=" in entry:
+            name, value = [part.strip() for part in entry.split("=", 1)]
+            next_value = int(value, 0)
+        else:
+            name = entry
+        values[name] = next_value
+        next_value += 1
+    return values
+
+
+class Generator:
+    def __init__(self, include_dir):
+        engine = read_header(include_dir, "mapping_engine.h")
+        inputs = read_header(include_dir, "input_manager.h")
+        self.max_mappings = parse_define(engine, "MAX_MAPPINGS")
+        self.max_profiles = parse_define(engine, "MAX_MAPPING_PROFILES")
+        self.name_size = parse_define(engine, "MAPPING_PROFILE_NAME_SIZE")
+        self.event_types = parse_enum(inputs, "Input_Event_Type_t")
+        self.output_types = parse_enum(engine, "Output_Type_t")
+
+    def fail(self, where, message):
+        raise SystemExit("gen_mapping_table: %s: %s" % (where, message))
+
+    def event_name(self, where, event):
+        name = "INPUT_EVENT_" + str(event).upper()
+        if name not in self.event_types or name == "INPUT_EVENT_NONE":
+            self.fail(where, "unknown event '%s'" % event)
+        return name
+
+    def output_fields(self, where, output):
+        kind = str(output.get("type", "")).lower()
+        name = "OUTPUT_TYPE_" + kind.upper()
+        if name not in self.output_types or name == "OUTPUT_TYPE_NONE":
+            self.fail(where, "unknown output type '%s'" % kind)
+        if kind == "serial":
+            fields = ".serial = { .dataFormat = %d, .dataLength = %d }" % (
+                parse_int(output.get("format", 0)), parse_int(output.get("length", 1)))
+        elif kind == "can":
+            can_id = parse_int(output["id"])
+            dlc = parse_int(output.get("dlc", 8))
+            index = parse_int(output.get("index", 0))
+            if can_id > 0x1FFFFFFF or dlc > 8 or index >= dlc:
+                self.fail(where, "invalid CAN output")
+            fields = ".can = { .canId = 0x%03X, .dlc = %d, .dataIndex = %d }" % (can_id, dlc, index)
+        elif kind == "profile":
+            profile = parse_int(output["profile"])
+            if profile >= self.max_profiles:
+                self.fail(where, "profile %d out of range" % profile)
+            fields = ".profile = { .profileIndex = %d }" % profile
+        elif kind == "macro":
+            fields = ".macro = { .macroIndex = %d }" % parse_int(output["macro"])
+        else:
+            self.fail(where, "output type '%s' not supported" % kind)
+        return name, fields
+
+    def profile(self, index, profile):
+        where = "profile %d" % index
+        name = str(profile.get("name", ""))
+        if len(name) >= self.name_size:
+            self.fail(where, "name longer than %d characters" % (self.name_size - 1))
+        mappings = profile.get("mappings", [])
+        if len(mappings) > self.max_mappings:
+            self.fail(where, "more than %d mappings" % self.max_mappings)
+
+        lines = ["  /* Profile %d */" % index, "  {", "    .name = %s," % json.dumps(name)]
+        entries = []
+        for slot, mapping in enumerate(mappings):
+            at = "%s mapping %d" % (where, slot)
+            device = parse_int(mapping["device"])
+            event = self.event_name(at, mapping["event"])
+            input_id = parse_int(mapping["input"])
+            low = parse_int(mapping.get("min", -32768))
+            high = parse_int(mapping.get("max", 32767))
+            # Keys are unsigned 8-bit fields, a negative one would sort apart from MAPPING_KEY
+            if not 0 <= device <= 0xFF:
+                self.fail(at, "device %d outside 0-255" % device)
+            if not 0 <= input_id <= 0xFF:
+                self.fail(at, "input %d outside 0-255" % input_id)
+            if not -32768 <= low <= high <= 32767:
+                self.fail(at, "min %d and max %d must satisfy -32768 <= min <= max <= 32767" % (low, high))
+            output_type, output_fields = self.output_fields(at, mapping["output"])
+            key = (device << 16) | (self.event_types[event] << 8) | input_id
+            entries.append({
+                "sort": (key, slot),
+                "key": "MAPPING_KEY(%d, %s, 0x%02X)" % (device, event, input_id),
+                "min": str(low),
+                "max": str(high),
+                "type": output_type,
+                "output": "{ %s }" % output_fields,
+            })
+
+        # Same order as Mapping_Engine_AddMapping: by key, equal keys in file order
+        entries.sort(key=lambda entry: entry["sort"])
+
+        lines.append("    .count = %d," % len(entries))
+        for field, column in (("keys", "key"), ("minValues", "min"), ("maxValues", "max"),
+                              ("outputTypes", "type"), ("outputs", "output")):
+            lines.append("    .%s = {" % field)
+            lines.extend("      %s," % entry[column] for entry in entries)
+            lines.append("    },")
+        lines.append("  },")
+        return lines
+
+    def generate(self, config, source):
+        profiles = config.get("profiles", [])
+        if not profiles:
+            self.fail(source, "no profiles")
+        if len(profiles) > self.max_profiles:
+            self.fail(source, "more than %d profiles" % self.max_profiles)
+
+        lines = [
+            "/**",
+            " * @file mapping_table.c",
+            " * @brief Generated by tools/gen_mapping_table.py from %s, do not edit" % os.path.basename(source),
+            " */",
+            "",
+            "/* Includes ------------------------------------------------------------------*/",
+            '#include "mapping_engine.h"',
+            "",
+            "/* Exported variables --------------------------------------------------------*/",
+            "const Mapping_Profile_t mappingTableProfiles[MAX_MAPPING_PROFILES] = {",
+        ]
+        for index, profile in enumerate(profiles):
+            lines.extend(self.profile(index, profile))
+        lines.append("};")
+        return "\n".join(lines) + "\n"
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[1])
+    parser.add_argument("config", help="JSON mapping configuration")
+    parser.add_argument("output", help="C file to write")
+    parser.add_argument("--include", default="inc", help="firmware include directory")
+    args = parser.parse_args()
+
+    with open(args.config) as f:
+        config = json.load(f)
+
+    text = Generator(args.include).generate(config, args.config)
+
+    with open(args.output, "w") as f:
+        f.write(text)
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,51 @@
+/**
+ * @file gen_ts_ini.c
+ * @brief TunerStudio INI generator tool for STM32F407 HID to Serial/CAN project
+ * @author Manus AI
+ * @date 2025-03-28
+ *
+ * Host build of src/ts_ini.c, writes the INI the firmware describes in
+ * inc/ts_protocol.h. Built and run by `make ini`, which is part of `make all`.
+ *
+ * Usage: gen_ts_ini <output.ini>
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "ts_ini.h"
+#include <stdio.h>
+
+/* Private define ------------------------------------------------------------*/
+#define GEN_TS_INI_CHUNK_SIZE     64    /* Same chunking a serial link would use */
+
+/**
+  * @brief  Tool entry point
+  * @param  argc: Argument count
+  * @param  argv: Arguments
+  * @retval int: 0 if successful, 1 if failed
+  */
+int main(int argc, char** argv)
+{
+  TS_Ini_Stream_t stream;
+  char chunk[GEN_TS_INI_CHUNK_SIZE];
+  uint16_t length;
+  
+  if (argc != 2) {
+    fprintf(stderr, "usage: %s <output.ini>\n", argv[0]);
+    return 1;
+  }
+  
+  FILE* file = fopen(argv[1], "wb");
+  
+  if (file == NULL) {
+    fprintf(stderr, "gen_ts_ini: cannot write %s\n", argv[1]);
+    return 1;
+  }
+  
+  TS_Ini_Start(&stream);
+  
+  while ((length = TS_Ini_Read(&stream, chunk, sizeof(chunk))) > 0) {
+    fwrite(chunk, 1, length, file);
+  }
+  
+  return fclose(file) == 0 ? 0 : 1;
+}